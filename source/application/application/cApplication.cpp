@@ -8,14 +8,20 @@
 #include <GLFW/glfw3.h>
 
 #include "cTesting.h"
+#include "engine/filesystem/cAsyncIO.h"
 #include "engine/filesystem/cFileSystem.h"
+#include "engine/log/Log.h"
 #include "engine/managers/assets/cCameraManager.h"
 #include "engine/managers/assets/cModelManager.h"
 #include "engine/managers/assets/cQuadManager.h"
+#include "engine/managers/cEntityManager.h"
 #include "engine/managers/cEventManager.h"
+#include "engine/managers/cHotReloadManager.h"
 #include "engine/managers/cInputManager.h"
+#include "engine/managers/cJobManager.h"
 #include "engine/managers/cRenderCallbackManager.h"
 #include "engine/misc/cTimer.h"
+#include "engine/misc/cTransformSystem.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/iRenderer.h"
 
@@ -27,26 +33,38 @@ cApplication::cApplication()
 
 	initializeEngine();
 
+	df::cJobManager::initialize();
 	df::cEventManager::initialize();
+	df::cAsyncIO::initialize();
+	df::cTransformSystem::initialize();
 	df::cRenderer::initialize( df::cRenderer::eInstanceType::eVulkan, m_name );
 	df::cRenderCallbackManager::initialize();
 	df::cQuadManager::initialize();
 	df::cModelManager::initialize();
 	df::cCameraManager::initialize();
 	df::cInputManager::initialize();
+	df::cHotReloadManager::initialize();
+	df::cEntityManager::initialize();
 }
 
 cApplication::~cApplication()
 {
 	ZoneScoped;
 
+	df::cEntityManager::deinitialize();
+	df::cHotReloadManager::deinitialize();
 	df::cInputManager::deinitialize();
 	df::cCameraManager::deinitialize();
 	df::cModelManager::deinitialize();
 	df::cQuadManager::deinitialize();
 	df::cRenderCallbackManager::deinitialize();
 	df::cRenderer::deinitialize();
+	df::cTransformSystem::deinitialize();
+	df::cAsyncIO::deinitialize();
 	df::cEventManager::deinitialize();
+	df::cJobManager::deinitialize();
+
+	df::log::deinitialize();
 }
 
 void cApplication::run()
@@ -65,8 +83,13 @@ void cApplication::run()
 		const double target_fps   = 1.f / delta_second;
 		application->m_fps        = application->m_fps + ( target_fps - application->m_fps ) * .1f * delta_second;
 
+		df::cHotReloadManager::update();
+		df::cAsyncIO::update();
 		df::cInputManager::update();
+		df::cEventManager::dispatchQueued();
 		df::cEventManager::invoke( df::event::update, static_cast< float >( delta_second ) );
+		df::cEntityManager::update( static_cast< float >( delta_second ) );
+		df::cTransformSystem::update();
 		render_instance->render();
 		FrameMark;
 	}
@@ -111,8 +134,18 @@ void cApplication::initializeEngine()
 	df::filesystem::setGameDirectory( executable_path.parent_path().parent_path().string() + "\\" );
 	m_name = executable_path.filename().replace_extension().string();
 
+#ifdef DF_LOG_BINARY
+	df::log::initialize( df::log::eBlock, 8192, df::log::eBinary );
+#else
 	df::filesystem::remove( "binaries/log.csv" );
 	df::filesystem::write( "binaries/log.csv", "Type;;Function;;Line;;Message\n", std::ios::out | std::ios::app );
+	df::log::initialize();
+#endif
+
+	if( std::filesystem::exists( df::filesystem::getGameDirectory() + "data.pak" ) )
+		df::filesystem::mountPack( "data.pak", "data" );
+
+	df::filesystem::buildIndex();
 
 	DF_LOG_RAW( "Starting DragonForge-Engine" );
 }
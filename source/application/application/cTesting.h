@@ -6,7 +6,9 @@
 #include "engine/managers/assets/cCameraManager.h"
 #include "engine/managers/assets/cModelManager.h"
 #include "engine/managers/assets/cQuadManager.h"
+#include "engine/managers/cEntityManager.h"
 #include "engine/managers/cInputManager.h"
+#include "engine/misc/cTransformSystem.h"
 #include "engine/rendering/assets/cameras/cFreeFlightCamera.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/iRenderer.h"
@@ -63,6 +65,7 @@ inline void cTesting::render3d()
 	camera->beginRender( df::cCamera::eColor | df::cCamera::eDepth );
 
 	df::cModelManager::render();
+	df::cEntityManager::render();
 
 	camera->endRender();
 }
@@ -84,4 +87,13 @@ inline void cTesting::input( const df::input::sInput& /*_input*/ )
 {
 	if( df::cInputManager::checkKey( GLFW_KEY_ESCAPE ) == df::input::ePress )
 		cApplication::quit();
+
+	if( df::cInputManager::checkKey( GLFW_KEY_F9 ) == df::input::ePress )
+		df::log::benchmark( 4, 100000 );
+
+	if( df::cInputManager::checkKey( GLFW_KEY_F10 ) == df::input::ePress )
+		df::cTransformSystem::benchmark();
+
+	if( df::cInputManager::checkKey( GLFW_KEY_F11 ) == df::input::ePress )
+		df::cEntityManager::benchmark();
 }
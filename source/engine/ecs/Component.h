@@ -0,0 +1,99 @@
+﻿#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include "engine/log/Log.h"
+
+namespace df::ecs
+{
+	typedef uint32_t tComponentId;
+
+	constexpr size_t s_max_components = 64;
+
+	typedef std::bitset< s_max_components > tSignature;
+
+	struct sComponentInfo
+	{
+		size_t size;
+		size_t alignment;
+		void ( *construct )( void* _destination );
+		void ( *move )( void* _destination, void* _source );
+		void ( *destroy )( void* _pointer );
+	};
+
+	namespace component
+	{
+		inline std::array< sComponentInfo, s_max_components > s_infos{};
+		inline std::atomic< tComponentId >                    s_count = 0;
+
+		template< typename T >
+		void construct( void* _destination )
+		{
+			new( _destination ) T();
+		}
+
+		template< typename T >
+		void move( void* _destination, void* _source )
+		{
+			T* source = static_cast< T* >( _source );
+			new( _destination ) T( std::move( *source ) );
+			source->~T();
+		}
+
+		template< typename T >
+		void destroy( void* _pointer )
+		{
+			static_cast< T* >( _pointer )->~T();
+		}
+
+		template< typename T >
+		tComponentId registerComponent()
+		{
+			const tComponentId id = s_count++;
+			if( id >= s_max_components )
+			{
+				DF_LOG_ERROR( "Too many component types, max is {}", s_max_components );
+				log::flush();
+				std::abort();
+			}
+
+			s_infos[ id ] = {
+				.size      = sizeof( T ),
+				.alignment = alignof( T ),
+				.construct = &construct< T >,
+				.move      = &move< T >,
+				.destroy   = &destroy< T >,
+			};
+
+			return id;
+		}
+
+		template< typename T >
+		tComponentId getId()
+		{
+			if constexpr( !std::is_same_v< T, std::remove_cvref_t< T > > )
+				return getId< std::remove_cvref_t< T > >();
+			else
+			{
+				static const tComponentId id = registerComponent< T >();
+				return id;
+			}
+		}
+
+		inline const sComponentInfo& getInfo( const tComponentId _id ) { return s_infos[ _id ]; }
+	}
+
+	template< typename... Tcomponents >
+	tSignature signature()
+	{
+		tSignature result;
+		( result.set( component::getId< Tcomponents >() ), ... );
+		return result;
+	}
+}
@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+
+#include "engine/misc/cColor.h"
+#include "engine/misc/cTransformSystem.h"
+#include "engine/rendering/assets/cLight.h"
+
+namespace df
+{
+	class cCamera;
+	class iModel;
+}
+
+namespace df::ecs
+{
+	// Not owned, the handle is created and destroyed by whoever owns the transform.
+	struct sTransform
+	{
+		cTransformSystem::tHandle handle = cTransformSystem::s_invalid;
+	};
+
+	struct sMesh
+	{
+		iModel* model = nullptr;
+	};
+
+	struct sLight
+	{
+		cLight::eType type       = cLight::ePoint;
+		float         intensity  = 1;
+		float         radius     = 0;
+		float         cone_angle = 0;
+		cColor        color      = color::white;
+	};
+
+	struct sCamera
+	{
+		cCamera* camera = nullptr;
+	};
+
+	struct sVoxelChunk
+	{
+		glm::ivec3 coordinate = glm::ivec3( 0 );
+		uint32_t   lod        = 0;
+		uint32_t   version    = 0;
+		bool       dirty      = true;
+	};
+}
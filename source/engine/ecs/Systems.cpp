@@ -0,0 +1,34 @@
+﻿#include "Systems.h"
+
+#include <tracy/Tracy.hpp>
+
+#include "cWorld.h"
+#include "Components.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
+
+namespace df::ecs
+{
+	void addDefaultSystems( cWorld& _world )
+	{
+		ZoneScoped;
+
+		_world.addSystem( {
+			.name        = "cameras",
+			.phase       = cWorld::eUpdate,
+			.reads       = signature< sCamera >(),
+			.main_thread = true,
+			.function    = []( cWorld& _world, const float _delta_time )
+			{
+				_world.each< sCamera >(
+					[ & ]( const sCamera& _camera )
+					{
+						if( !_camera.camera )
+							return;
+
+						_camera.camera->transform->update();
+						_camera.camera->update( _delta_time );
+					} );
+			},
+		} );
+	}
+}
@@ -0,0 +1,8 @@
+﻿#pragma once
+
+namespace df::ecs
+{
+	class cWorld;
+
+	void addDefaultSystems( cWorld& _world );
+}
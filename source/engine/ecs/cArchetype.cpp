@@ -0,0 +1,134 @@
+﻿#include "cArchetype.h"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+namespace df::ecs
+{
+	cArchetype::cArchetype( const tSignature& _signature )
+		: m_signature( _signature )
+		, m_capacity( 0 )
+	{
+		ZoneScoped;
+
+		add_edges.fill( nullptr );
+		remove_edges.fill( nullptr );
+		m_column_indices.fill( s_no_column );
+
+		for( tComponentId id = 0; id < s_max_components; ++id )
+		{
+			if( !_signature.test( id ) )
+				continue;
+
+			m_column_indices[ id ] = static_cast< uint8_t >( m_columns.size() );
+			m_columns.push_back( { id, &component::getInfo( id ), nullptr } );
+		}
+	}
+
+	cArchetype::~cArchetype()
+	{
+		ZoneScoped;
+
+		for( const sColumn& column: m_columns )
+		{
+			for( size_t row = 0; row < m_entities.size(); ++row )
+				column.info->destroy( getElement( column, row ) );
+
+			if( column.data )
+				::operator delete( column.data, std::align_val_t( column.info->alignment ) );
+		}
+	}
+
+	uint32_t cArchetype::addRow( const sEntity _entity )
+	{
+		if( m_entities.size() == m_capacity )
+			reserve( std::max< size_t >( m_capacity * 2, 64 ) );
+
+		for( const sColumn& column: m_columns )
+			column.info->construct( getElement( column, m_entities.size() ) );
+
+		m_entities.push_back( _entity );
+		return static_cast< uint32_t >( m_entities.size() - 1 );
+	}
+
+	void cArchetype::removeRow( const uint32_t _row )
+	{
+		const size_t last = m_entities.size() - 1;
+
+		for( const sColumn& column: m_columns )
+		{
+			column.info->destroy( getElement( column, _row ) );
+
+			if( _row != last )
+				column.info->move( getElement( column, _row ), getElement( column, last ) );
+		}
+
+		m_entities[ _row ] = m_entities[ last ];
+		m_entities.pop_back();
+	}
+
+	uint32_t cArchetype::moveRow( const uint32_t _row, cArchetype& _destination )
+	{
+		if( _destination.m_entities.size() == _destination.m_capacity )
+			_destination.reserve( std::max< size_t >( _destination.m_capacity * 2, 64 ) );
+
+		const size_t destination_row = _destination.m_entities.size();
+
+		for( const sColumn& column: _destination.m_columns )
+		{
+			void* destination = _destination.getElement( column, destination_row );
+
+			if( const uint8_t index = m_column_indices[ column.id ]; index != s_no_column )
+				column.info->move( destination, getElement( m_columns[ index ], _row ) );
+			else
+				column.info->construct( destination );
+		}
+
+		for( const sColumn& column: m_columns )
+		{
+			if( _destination.m_column_indices[ column.id ] == s_no_column )
+				column.info->destroy( getElement( column, _row ) );
+		}
+
+		_destination.m_entities.push_back( m_entities[ _row ] );
+
+		const size_t last = m_entities.size() - 1;
+		if( _row != last )
+		{
+			for( const sColumn& column: m_columns )
+				column.info->move( getElement( column, _row ), getElement( column, last ) );
+		}
+
+		m_entities[ _row ] = m_entities[ last ];
+		m_entities.pop_back();
+
+		return static_cast< uint32_t >( destination_row );
+	}
+
+	void* cArchetype::getColumn( const tComponentId _id ) const
+	{
+		const uint8_t index = m_column_indices[ _id ];
+		return index == s_no_column ? nullptr : m_columns[ index ].data;
+	}
+
+	void cArchetype::reserve( const size_t _capacity )
+	{
+		ZoneScoped;
+
+		for( sColumn& column: m_columns )
+		{
+			std::byte* data = static_cast< std::byte* >( ::operator new( column.info->size * _capacity, std::align_val_t( column.info->alignment ) ) );
+
+			for( size_t row = 0; row < m_entities.size(); ++row )
+				column.info->move( data + column.info->size * row, getElement( column, row ) );
+
+			if( column.data )
+				::operator delete( column.data, std::align_val_t( column.info->alignment ) );
+
+			column.data = data;
+		}
+
+		m_entities.reserve( _capacity );
+		m_capacity = _capacity;
+	}
+}
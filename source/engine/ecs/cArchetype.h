@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Component.h"
+#include "engine/misc/Misc.h"
+#include "sEntity.h"
+
+namespace df::ecs
+{
+	class cArchetype
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cArchetype );
+
+		explicit cArchetype( const tSignature& _signature );
+		~cArchetype();
+
+		uint32_t addRow( sEntity _entity );
+		void     removeRow( uint32_t _row );
+		uint32_t moveRow( uint32_t _row, cArchetype& _destination );
+
+		void* getColumn( tComponentId _id ) const;
+
+		template< typename T >
+		T* getColumn() const
+		{
+			return static_cast< T* >( getColumn( component::getId< T >() ) );
+		}
+
+		const tSignature& getSignature() const { return m_signature; }
+		const sEntity*    getEntities() const { return m_entities.data(); }
+		size_t            getCount() const { return m_entities.size(); }
+
+		std::array< cArchetype*, s_max_components > add_edges;
+		std::array< cArchetype*, s_max_components > remove_edges;
+
+	private:
+		struct sColumn
+		{
+			tComponentId          id;
+			const sComponentInfo* info;
+			std::byte*            data;
+		};
+
+		static constexpr uint8_t s_no_column = UINT8_MAX;
+
+		void  reserve( size_t _capacity );
+		void* getElement( const sColumn& _column, size_t _row ) const { return _column.data + _column.info->size * _row; }
+
+		tSignature                              m_signature;
+		std::array< uint8_t, s_max_components > m_column_indices;
+		std::vector< sColumn >                  m_columns;
+		std::vector< sEntity >                  m_entities;
+		size_t                                  m_capacity;
+	};
+}
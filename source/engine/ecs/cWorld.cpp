@@ -0,0 +1,244 @@
+﻿#include "cWorld.h"
+
+#include <mutex>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+
+namespace df::ecs
+{
+	cWorld::cWorld()
+		: m_stages_dirty{}
+	{
+		ZoneScoped;
+
+		getArchetype( tSignature() );
+	}
+
+	cWorld::~cWorld()
+	{
+		ZoneScoped;
+
+		for( const cArchetype* archetype: m_archetypes )
+			delete archetype;
+	}
+
+	sEntity cWorld::create()
+	{
+		ZoneScoped;
+
+		const sEntity entity    = allocate();
+		cArchetype*   archetype = m_archetypes.front();
+
+		m_records[ entity.index ].archetype = archetype;
+		m_records[ entity.index ].row       = archetype->addRow( entity );
+		return entity;
+	}
+
+	void cWorld::destroy( const sEntity _entity )
+	{
+		ZoneScoped;
+
+		if( !isAlive( _entity ) )
+			return;
+
+		sRecord& record = m_records[ _entity.index ];
+		removeRow( record.archetype, record.row );
+
+		record.archetype = nullptr;
+		++record.generation;
+		m_free.push_back( _entity.index );
+	}
+
+	bool cWorld::isAlive( const sEntity _entity ) const
+	{
+		return _entity.index < m_records.size() && m_records[ _entity.index ].generation == _entity.generation && m_records[ _entity.index ].archetype;
+	}
+
+	void cWorld::addSystem( sSystem _system )
+	{
+		ZoneScoped;
+
+		const ePhase phase = _system.phase;
+		m_systems[ phase ].push_back( std::move( _system ) );
+		m_stages_dirty[ phase ] = true;
+	}
+
+	void cWorld::run( const ePhase _phase, const float _delta_time )
+	{
+		ZoneScoped;
+
+		if( m_stages_dirty[ _phase ] )
+			buildStages( _phase );
+
+		std::vector< const sSystem* > parallel;
+		for( const std::vector< const sSystem* >& stage: m_stages[ _phase ] )
+		{
+			parallel.clear();
+			for( const sSystem* system: stage )
+			{
+				if( system->main_thread )
+					system->function( *this, _delta_time );
+				else
+					parallel.push_back( system );
+			}
+
+			if( parallel.empty() )
+				continue;
+
+			if( parallel.size() == 1 )
+			{
+				parallel.front()->function( *this, _delta_time );
+				continue;
+			}
+
+			cJobManager::parallelFor( parallel.size(),
+			                          1,
+			                          [ & ]( const size_t _begin, const size_t _end )
+			                          {
+										  for( size_t i = _begin; i < _end; ++i )
+											  parallel[ i ]->function( *this, _delta_time );
+									  } );
+		}
+	}
+
+	cArchetype* cWorld::getArchetype( const tSignature& _signature )
+	{
+		if( const auto it = m_archetype_map.find( _signature ); it != m_archetype_map.end() )
+			return it->second;
+
+		ZoneScoped;
+
+		cArchetype* archetype = new cArchetype( _signature );
+		m_archetype_map.emplace( _signature, archetype );
+		m_archetypes.push_back( archetype );
+
+		std::unique_lock lock( m_query_mutex );
+		for( auto& [ signature, archetypes ]: m_queries )
+		{
+			if( ( _signature & signature ) == signature )
+				archetypes.push_back( archetype );
+		}
+
+		return archetype;
+	}
+
+	cArchetype* cWorld::getAddEdge( cArchetype* _archetype, const tComponentId _id )
+	{
+		if( !_archetype->add_edges[ _id ] )
+		{
+			cArchetype* destination          = getArchetype( tSignature( _archetype->getSignature() ).set( _id ) );
+			_archetype->add_edges[ _id ]     = destination;
+			destination->remove_edges[ _id ] = _archetype;
+		}
+
+		return _archetype->add_edges[ _id ];
+	}
+
+	cArchetype* cWorld::getRemoveEdge( cArchetype* _archetype, const tComponentId _id )
+	{
+		if( !_archetype->remove_edges[ _id ] )
+		{
+			cArchetype* destination         = getArchetype( tSignature( _archetype->getSignature() ).reset( _id ) );
+			_archetype->remove_edges[ _id ] = destination;
+			destination->add_edges[ _id ]   = _archetype;
+		}
+
+		return _archetype->remove_edges[ _id ];
+	}
+
+	const std::vector< cArchetype* >& cWorld::query( const tSignature& _signature )
+	{
+		{
+			std::shared_lock lock( m_query_mutex );
+			if( const auto it = m_queries.find( _signature ); it != m_queries.end() )
+				return it->second;
+		}
+
+		ZoneScoped;
+
+		std::unique_lock lock( m_query_mutex );
+		if( const auto it = m_queries.find( _signature ); it != m_queries.end() )
+			return it->second;
+
+		std::vector< cArchetype* > archetypes;
+		for( cArchetype* archetype: m_archetypes )
+		{
+			if( ( archetype->getSignature() & _signature ) == _signature )
+				archetypes.push_back( archetype );
+		}
+
+		return m_queries.emplace( _signature, std::move( archetypes ) ).first->second;
+	}
+
+	sEntity cWorld::allocate()
+	{
+		if( m_free.empty() )
+		{
+			m_records.push_back( { nullptr, 0, 0 } );
+			return { static_cast< uint32_t >( m_records.size() - 1 ), 0 };
+		}
+
+		const uint32_t index = m_free.back();
+		m_free.pop_back();
+		return { index, m_records[ index ].generation };
+	}
+
+	void cWorld::move( const sEntity _entity, cArchetype* _destination )
+	{
+		sRecord&       record = m_records[ _entity.index ];
+		cArchetype*    source = record.archetype;
+		const uint32_t row    = record.row;
+
+		record.archetype = _destination;
+		record.row       = source->moveRow( row, *_destination );
+
+		if( row < source->getCount() )
+			m_records[ source->getEntities()[ row ].index ].row = row;
+	}
+
+	void cWorld::removeRow( cArchetype* _archetype, const uint32_t _row )
+	{
+		_archetype->removeRow( _row );
+
+		if( _row < _archetype->getCount() )
+			m_records[ _archetype->getEntities()[ _row ].index ].row = _row;
+	}
+
+	void cWorld::buildStages( const ePhase _phase )
+	{
+		ZoneScoped;
+
+		std::vector< std::vector< const sSystem* > >&      stages = m_stages[ _phase ];
+		std::vector< std::pair< tSignature, tSignature > > access;
+
+		stages.clear();
+		for( const sSystem& system: m_systems[ _phase ] )
+		{
+			size_t stage = 0;
+			for( size_t i = stages.size(); i > 0; --i )
+			{
+				const auto& [ reads, writes ] = access[ i - 1 ];
+				if( ( system.writes & ( reads | writes ) ).any() || ( system.reads & writes ).any() )
+				{
+					stage = i;
+					break;
+				}
+			}
+
+			if( stage == stages.size() )
+			{
+				stages.emplace_back();
+				access.emplace_back();
+			}
+
+			stages[ stage ].push_back( &system );
+			access[ stage ].first  |= system.reads;
+			access[ stage ].second |= system.writes;
+		}
+
+		m_stages_dirty[ _phase ] = false;
+
+		DF_LOG_MESSAGE( "Scheduled {} systems into {} stages", m_systems[ _phase ].size(), stages.size() );
+	}
+}
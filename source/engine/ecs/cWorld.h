@@ -0,0 +1,236 @@
+﻿#pragma once
+
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cArchetype.h"
+#include "Component.h"
+#include "engine/managers/cJobManager.h"
+#include "engine/misc/Misc.h"
+#include "sEntity.h"
+
+namespace df::ecs
+{
+	class cWorld
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cWorld );
+
+		enum ePhase
+		{
+			eUpdate,
+			eRender,
+
+			ePhaseCount,
+		};
+
+		struct sSystem
+		{
+			std::string                             name;
+			ePhase                                  phase       = eUpdate;
+			tSignature                              reads       = {};
+			tSignature                              writes      = {};
+			bool                                    main_thread = false;
+			std::function< void( cWorld&, float ) > function;
+		};
+
+		cWorld();
+		~cWorld();
+
+		sEntity create();
+		void    destroy( sEntity _entity );
+		bool    isAlive( sEntity _entity ) const;
+
+		template< typename... Tcomponents >
+		sEntity create( Tcomponents&&... _components );
+
+		template< typename T >
+		T* add( sEntity _entity, T _component = {} );
+
+		template< typename T >
+		void remove( sEntity _entity );
+
+		template< typename T >
+		T* get( sEntity _entity ) const;
+
+		template< typename T >
+		bool has( sEntity _entity ) const;
+
+		template< typename... Tcomponents, typename Tfunction >
+		void eachChunk( Tfunction&& _function );
+
+		template< typename... Tcomponents, typename Tfunction >
+		void each( Tfunction&& _function );
+
+		template< typename... Tcomponents, typename Tfunction >
+		void parallelEachChunk( Tfunction&& _function, size_t _chunk_size = 1024 );
+
+		template< typename... Tcomponents, typename Tfunction >
+		void parallelEach( Tfunction&& _function, size_t _chunk_size = 1024 );
+
+		void addSystem( sSystem _system );
+		void run( ePhase _phase, float _delta_time );
+
+		size_t getCount() const { return m_records.size() - m_free.size(); }
+		size_t getArchetypeCount() const { return m_archetypes.size(); }
+
+	private:
+		struct sRecord
+		{
+			cArchetype* archetype;
+			uint32_t    row;
+			uint32_t    generation;
+		};
+
+		cArchetype*                       getArchetype( const tSignature& _signature );
+		cArchetype*                       getAddEdge( cArchetype* _archetype, tComponentId _id );
+		cArchetype*                       getRemoveEdge( cArchetype* _archetype, tComponentId _id );
+		const std::vector< cArchetype* >& query( const tSignature& _signature );
+
+		sEntity allocate();
+		void    move( sEntity _entity, cArchetype* _destination );
+		void    removeRow( cArchetype* _archetype, uint32_t _row );
+		void    buildStages( ePhase _phase );
+
+		std::vector< sRecord >  m_records;
+		std::vector< uint32_t > m_free;
+
+		std::unordered_map< tSignature, cArchetype* > m_archetype_map;
+		std::vector< cArchetype* >                    m_archetypes;
+
+		std::shared_mutex                                            m_query_mutex;
+		std::unordered_map< tSignature, std::vector< cArchetype* > > m_queries;
+
+		std::array< std::vector< sSystem >, ePhaseCount >                       m_systems;
+		std::array< std::vector< std::vector< const sSystem* > >, ePhaseCount > m_stages;
+		std::array< bool, ePhaseCount >                                         m_stages_dirty;
+	};
+
+	template< typename... Tcomponents >
+	sEntity cWorld::create( Tcomponents&&... _components )
+	{
+		const sEntity  entity    = allocate();
+		cArchetype*    archetype = getArchetype( signature< Tcomponents... >() );
+		const uint32_t row       = archetype->addRow( entity );
+
+		( ( archetype->getColumn< std::remove_cvref_t< Tcomponents > >()[ row ] = std::forward< Tcomponents >( _components ) ), ... );
+
+		m_records[ entity.index ].archetype = archetype;
+		m_records[ entity.index ].row       = row;
+		return entity;
+	}
+
+	template< typename T >
+	T* cWorld::add( const sEntity _entity, T _component )
+	{
+		if( !isAlive( _entity ) )
+			return nullptr;
+
+		const tComponentId id     = component::getId< T >();
+		const sRecord&     record = m_records[ _entity.index ];
+
+		if( !record.archetype->getSignature().test( id ) )
+			move( _entity, getAddEdge( record.archetype, id ) );
+
+		T* component = &record.archetype->getColumn< T >()[ record.row ];
+		*component   = std::move( _component );
+		return component;
+	}
+
+	template< typename T >
+	void cWorld::remove( const sEntity _entity )
+	{
+		if( !isAlive( _entity ) )
+			return;
+
+		const tComponentId id     = component::getId< T >();
+		const sRecord&     record = m_records[ _entity.index ];
+
+		if( record.archetype->getSignature().test( id ) )
+			move( _entity, getRemoveEdge( record.archetype, id ) );
+	}
+
+	template< typename T >
+	T* cWorld::get( const sEntity _entity ) const
+	{
+		if( !isAlive( _entity ) )
+			return nullptr;
+
+		const sRecord& record = m_records[ _entity.index ];
+		T*             column = record.archetype->getColumn< T >();
+		return column ? &column[ record.row ] : nullptr;
+	}
+
+	template< typename T >
+	bool cWorld::has( const sEntity _entity ) const
+	{
+		return isAlive( _entity ) && m_records[ _entity.index ].archetype->getSignature().test( component::getId< T >() );
+	}
+
+	template< typename... Tcomponents, typename Tfunction >
+	void cWorld::eachChunk( Tfunction&& _function )
+	{
+		// Indexed, as callbacks may create archetypes that get appended to the query.
+		const std::vector< cArchetype* >& archetypes = query( signature< Tcomponents... >() );
+		const size_t                      count      = archetypes.size();
+
+		for( size_t i = 0; i < count; ++i )
+		{
+			cArchetype* archetype = archetypes[ i ];
+			if( archetype->getCount() )
+				_function( archetype->getCount(), archetype->getEntities(), archetype->getColumn< Tcomponents >()... );
+		}
+	}
+
+	template< typename... Tcomponents, typename Tfunction >
+	void cWorld::each( Tfunction&& _function )
+	{
+		eachChunk< Tcomponents... >(
+			[ & ]( const size_t _count, const sEntity* /*_entities*/, Tcomponents*... _components )
+			{
+				for( size_t i = 0; i < _count; ++i )
+					_function( _components[ i ]... );
+			} );
+	}
+
+	template< typename... Tcomponents, typename Tfunction >
+	void cWorld::parallelEachChunk( Tfunction&& _function, const size_t _chunk_size )
+	{
+		const std::vector< cArchetype* >& archetypes      = query( signature< Tcomponents... >() );
+		const size_t                      archetype_count = archetypes.size();
+
+		for( size_t i = 0; i < archetype_count; ++i )
+		{
+			cArchetype*  archetype = archetypes[ i ];
+			const size_t count     = archetype->getCount();
+			if( !count )
+				continue;
+
+			if( count <= _chunk_size )
+			{
+				_function( count, archetype->getEntities(), archetype->getColumn< Tcomponents >()... );
+				continue;
+			}
+
+			cJobManager::parallelFor( count,
+			                          _chunk_size,
+			                          [ & ]( const size_t _begin, const size_t _end )
+			                          { _function( _end - _begin, archetype->getEntities() + _begin, ( archetype->getColumn< Tcomponents >() + _begin )... ); } );
+		}
+	}
+
+	template< typename... Tcomponents, typename Tfunction >
+	void cWorld::parallelEach( Tfunction&& _function, const size_t _chunk_size )
+	{
+		parallelEachChunk< Tcomponents... >(
+			[ & ]( const size_t _count, const sEntity* /*_entities*/, Tcomponents*... _components )
+			{
+				for( size_t i = 0; i < _count; ++i )
+					_function( _components[ i ]... );
+			},
+			_chunk_size );
+	}
+}
@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include <cstdint>
+
+namespace df::ecs
+{
+	struct sEntity
+	{
+		static constexpr uint32_t s_invalid = UINT32_MAX;
+
+		bool isValid() const { return index != s_invalid; }
+
+		bool operator==( const sEntity& _other ) const = default;
+
+		uint32_t index      = s_invalid;
+		uint32_t generation = 0;
+	};
+}
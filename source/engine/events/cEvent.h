@@ -1,9 +1,19 @@
 ﻿#pragma once
 
-#include <functional>
-#include <ranges>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
 #include <tracy/Tracy.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "engine/managers/cJobManager.h"
 #include "engine/misc/Misc.h"
 #include "iEvent.h"
 
@@ -15,38 +25,103 @@ namespace df
 	public:
 		DF_DISABLE_COPY_AND_MOVE( cEvent );
 
+		static constexpr bool   s_queueable    = ( std::is_trivially_copyable_v< std::decay_t< Targs > > && ... );
+		static constexpr size_t s_payload_size = ( size_t( 0 ) + ... + sizeof( std::decay_t< Targs > ) );
+
 		cEvent()           = default;
 		~cEvent() override = default;
 
 		template< typename T >
-		void subscribe( T* _object, void ( T::*_function )( Targs... ) );
+		void subscribe( T* _object, void ( T::*_function )( Targs... ), eDispatch _dispatch = eCaller );
 		template< typename T >
-		void subscribe( T* _object, void ( *_function )( Targs... ) );
+		void subscribe( T* _object, void ( *_function )( Targs... ), eDispatch _dispatch = eCaller );
 
 		void unsubscribe( void* _object ) override;
 
 		void invoke( Targs... _args );
 
+		// Queued arguments are copied one by one, a std::tuple of them isn't trivially copyable even when every element is.
+		static void write( std::byte* _payload, Targs... _args );
+		void        invokePayload( const std::byte* _payload );
+
 	private:
-		std::unordered_map< void*, std::function< void( Targs... ) > > m_subscribers;
+		struct sDelegate
+		{
+			void*                                      object;
+			void                                       ( *thunk )( const sDelegate& _delegate, Targs... _args );
+			alignas( void* ) std::array< std::byte, sizeof( void* ) * 3 > function;
+			eDispatch                                  dispatch;
+		};
+
+		struct sChange
+		{
+			sDelegate delegate;
+			bool      remove;
+		};
+
+		static constexpr std::array< size_t, sizeof...( Targs ) > s_payload_offsets = []
+		{
+			constexpr std::array< size_t, sizeof...( Targs ) > sizes = { sizeof( std::decay_t< Targs > )... };
+
+			std::array< size_t, sizeof...( Targs ) > offsets = {};
+			size_t                                   offset  = 0;
+			for( size_t i = 0; i < sizes.size(); ++i )
+			{
+				offsets[ i ]  = offset;
+				offset       += sizes[ i ];
+			}
+
+			return offsets;
+		}();
+
+		template< typename T >
+		static T read( const std::byte* _payload );
+		template< size_t... I >
+		void invokePayload( const std::byte* _payload, std::index_sequence< I... > );
+
+		template< typename T >
+		static void memberThunk( const sDelegate& _delegate, Targs... _args );
+		static void functionThunk( const sDelegate& _delegate, Targs... _args );
+
+		void change( const sChange& _change );
+		void apply( const sChange& _change );
+		void applyPending();
+
+		// Delegates are dispatched from the live vectors, they are only restructured while nothing dispatches.
+		std::shared_mutex        m_mutex;
+		std::vector< sDelegate > m_delegates;
+		std::vector< sDelegate > m_worker_delegates;
+		std::atomic< uint32_t >  m_dispatching = 0;
+
+		std::mutex             m_pending_mutex;
+		std::vector< sChange > m_pending;
+		std::atomic< bool >    m_has_pending = false;
 	};
 
 	template< typename... Targs >
 	template< typename T >
-	void cEvent< Targs... >::subscribe( T* _object, void ( T::*_function )( Targs... ) )
+	void cEvent< Targs... >::subscribe( T* _object, void ( T::*_function )( Targs... ), const eDispatch _dispatch )
 	{
 		ZoneScoped;
 
-		m_subscribers[ _object ] = [ _object, _function ]( Targs... _args ) { ( _object->*_function )( _args... ); };
+		static_assert( sizeof( _function ) <= sizeof( sDelegate::function ) );
+
+		sDelegate delegate{ .object = _object, .thunk = &memberThunk< T >, .function = {}, .dispatch = _dispatch };
+		std::memcpy( delegate.function.data(), &_function, sizeof( _function ) );
+
+		change( { delegate, false } );
 	}
 
 	template< typename... Targs >
 	template< typename T >
-	void cEvent< Targs... >::subscribe( T* _object, void ( *_function )( Targs... ) )
+	void cEvent< Targs... >::subscribe( T* _object, void ( *_function )( Targs... ), const eDispatch _dispatch )
 	{
 		ZoneScoped;
 
-		m_subscribers[ _object ] = [ _function ]( Targs... _args ) { ( *_function )( _args... ); };
+		sDelegate delegate{ .object = _object, .thunk = &functionThunk, .function = {}, .dispatch = _dispatch };
+		std::memcpy( delegate.function.data(), &_function, sizeof( _function ) );
+
+		change( { delegate, false } );
 	}
 
 	template< typename... Targs >
@@ -54,7 +129,7 @@ namespace df
 	{
 		ZoneScoped;
 
-		m_subscribers.erase( _object );
+		change( { sDelegate{ .object = _object, .thunk = nullptr, .function = {}, .dispatch = eCaller }, true } );
 	}
 
 	template< typename... Targs >
@@ -62,7 +137,151 @@ namespace df
 	{
 		ZoneScoped;
 
-		for( std::function< void( Targs... ) >& function: m_subscribers | std::ranges::views::values )
-			function( _args... );
+		if( m_has_pending )
+			applyPending();
+
+		{
+			std::shared_lock lock( m_mutex );
+			++m_dispatching;
+		}
+
+		const auto dispatch = [ & ]( sDelegate& _delegate )
+		{
+			if( const auto thunk = std::atomic_ref( _delegate.thunk ).load( std::memory_order_acquire ) )
+				thunk( _delegate, _args... );
+		};
+
+		if( !m_worker_delegates.empty() && cJobManager::getInstance() )
+		{
+			cJobManager::parallelFor( m_worker_delegates.size(),
+			                          1,
+			                          [ & ]( const size_t _begin, const size_t _end )
+			                          {
+										  for( size_t i = _begin; i < _end; ++i )
+											  dispatch( m_worker_delegates[ i ] );
+									  } );
+		}
+		else
+		{
+			for( sDelegate& delegate: m_worker_delegates )
+				dispatch( delegate );
+		}
+
+		for( sDelegate& delegate: m_delegates )
+			dispatch( delegate );
+
+		if( --m_dispatching == 0 && m_has_pending )
+			applyPending();
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::write( [[maybe_unused]] std::byte* _payload, Targs... _args )
+	{
+		[[maybe_unused]] size_t index = 0;
+		( ..., std::memcpy( _payload + s_payload_offsets[ index++ ], &_args, sizeof( std::decay_t< Targs > ) ) );
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::invokePayload( const std::byte* _payload )
+	{
+		invokePayload( _payload, std::index_sequence_for< Targs... >() );
+	}
+
+	template< typename... Targs >
+	template< typename T >
+	T cEvent< Targs... >::read( const std::byte* _payload )
+	{
+		alignas( T ) std::byte storage[ sizeof( T ) ];
+		std::memcpy( storage, _payload, sizeof( T ) );
+
+		return *std::launder( reinterpret_cast< T* >( storage ) );
+	}
+
+	template< typename... Targs >
+	template< size_t... I >
+	void cEvent< Targs... >::invokePayload( [[maybe_unused]] const std::byte* _payload, std::index_sequence< I... > )
+	{
+		invoke( read< std::decay_t< Targs > >( _payload + s_payload_offsets[ I ] )... );
+	}
+
+	template< typename... Targs >
+	template< typename T >
+	void cEvent< Targs... >::memberThunk( const sDelegate& _delegate, Targs... _args )
+	{
+		void ( T::*function )( Targs... );
+		std::memcpy( &function, _delegate.function.data(), sizeof( function ) );
+
+		( static_cast< T* >( _delegate.object )->*function )( _args... );
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::functionThunk( const sDelegate& _delegate, Targs... _args )
+	{
+		void ( *function )( Targs... );
+		std::memcpy( &function, _delegate.function.data(), sizeof( function ) );
+
+		function( _args... );
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::change( const sChange& _change )
+	{
+		std::unique_lock lock( m_mutex );
+		if( !m_dispatching )
+		{
+			apply( _change );
+			return;
+		}
+
+		// A removed delegate must not run again in the dispatch that is still going, its object may already be gone.
+		if( _change.remove )
+		{
+			for( std::vector< sDelegate >* delegates: { &m_delegates, &m_worker_delegates } )
+			{
+				for( sDelegate& delegate: *delegates )
+				{
+					if( delegate.object == _change.delegate.object )
+						std::atomic_ref( delegate.thunk ).store( nullptr, std::memory_order_release );
+				}
+			}
+		}
+
+		std::lock_guard pending_lock( m_pending_mutex );
+		m_pending.push_back( _change );
+		m_has_pending = true;
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::apply( const sChange& _change )
+	{
+		const auto matches = [ & ]( const sDelegate& _delegate ) { return _delegate.object == _change.delegate.object; };
+
+		std::erase_if( m_delegates, matches );
+		std::erase_if( m_worker_delegates, matches );
+
+		if( _change.remove )
+			return;
+
+		if( _change.delegate.dispatch == eWorker )
+			m_worker_delegates.push_back( _change.delegate );
+		else
+			m_delegates.push_back( _change.delegate );
+	}
+
+	template< typename... Targs >
+	void cEvent< Targs... >::applyPending()
+	{
+		ZoneScoped;
+
+		std::unique_lock lock( m_mutex );
+		if( m_dispatching )
+			return;
+
+		std::lock_guard pending_lock( m_pending_mutex );
+		for( const sChange& change: m_pending )
+			apply( change );
+
+		m_pending.clear();
+		m_has_pending = false;
 	}
 }
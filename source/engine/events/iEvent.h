@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <cstdint>
+
 #include "engine/misc/Misc.h"
 
 namespace df
@@ -9,6 +11,12 @@ namespace df
 	public:
 		DF_DISABLE_COPY_AND_MOVE( iEvent );
 
+		enum eDispatch
+		{
+			eCaller,
+			eWorker,
+		};
+
 		iEvent()          = default;
 		virtual ~iEvent() = default;
 
@@ -0,0 +1,160 @@
+﻿#include "Compression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+namespace df::compression
+{
+	constexpr size_t   s_min_match      = 4;
+	constexpr size_t   s_last_literals  = 5;
+	constexpr size_t   s_match_limit    = 12;
+	constexpr size_t   s_max_offset     = 65535;
+	constexpr uint32_t s_hash_bits      = 16;
+	constexpr uint32_t s_invalid_offset = UINT32_MAX;
+
+	uint32_t read32( const unsigned char* _data )
+	{
+		uint32_t value;
+		std::memcpy( &value, _data, sizeof( value ) );
+		return value;
+	}
+
+	void writeLength( std::vector< unsigned char >& _destination, size_t _length )
+	{
+		while( _length >= 255 )
+		{
+			_destination.push_back( 255 );
+			_length -= 255;
+		}
+
+		_destination.push_back( static_cast< unsigned char >( _length ) );
+	}
+
+	bool readLength( const std::span< const unsigned char > _source, size_t& _position, size_t& _length )
+	{
+		unsigned char byte;
+		do
+		{
+			if( _position >= _source.size() )
+				return false;
+
+			byte     = _source[ _position++ ];
+			_length += byte;
+		}
+		while( byte == 255 );
+
+		return true;
+	}
+
+	void writeSequence( std::vector< unsigned char >& _destination, const std::span< const unsigned char > _literals, const size_t _offset, const size_t _match_length )
+	{
+		const size_t  match_nibble = _match_length ? _match_length - s_min_match : 0;
+		unsigned char token        = static_cast< unsigned char >( std::min< size_t >( _literals.size(), 15 ) << 4 );
+		token                      |= static_cast< unsigned char >( std::min< size_t >( match_nibble, 15 ) );
+		_destination.push_back( token );
+
+		if( _literals.size() >= 15 )
+			writeLength( _destination, _literals.size() - 15 );
+
+		_destination.insert( _destination.end(), _literals.begin(), _literals.end() );
+
+		if( !_match_length )
+			return;
+
+		_destination.push_back( static_cast< unsigned char >( _offset & 0xFF ) );
+		_destination.push_back( static_cast< unsigned char >( _offset >> 8 ) );
+
+		if( match_nibble >= 15 )
+			writeLength( _destination, match_nibble - 15 );
+	}
+
+	std::vector< unsigned char > compress( const std::span< const unsigned char > _source )
+	{
+		ZoneScoped;
+
+		std::vector< unsigned char > destination;
+		destination.reserve( _source.size() / 2 + 16 );
+
+		std::vector< uint32_t > table( 1 << s_hash_bits, s_invalid_offset );
+
+		const size_t size   = _source.size();
+		const size_t limit  = size > s_match_limit ? size - s_match_limit : 0;
+		size_t       anchor = 0;
+		size_t       i      = 0;
+
+		while( i < limit )
+		{
+			const uint32_t sequence  = read32( &_source[ i ] );
+			const uint32_t hash      = ( sequence * 2654435761u ) >> ( 32 - s_hash_bits );
+			const uint32_t candidate = table[ hash ];
+			table[ hash ]            = static_cast< uint32_t >( i );
+
+			if( candidate == s_invalid_offset || i - candidate > s_max_offset || read32( &_source[ candidate ] ) != sequence )
+			{
+				++i;
+				continue;
+			}
+
+			size_t match_length = s_min_match;
+			while( i + match_length < size - s_last_literals && _source[ candidate + match_length ] == _source[ i + match_length ] )
+				++match_length;
+
+			writeSequence( destination, _source.subspan( anchor, i - anchor ), i - candidate, match_length );
+
+			i      += match_length;
+			anchor  = i;
+		}
+
+		writeSequence( destination, _source.subspan( anchor ), 0, 0 );
+		return destination;
+	}
+
+	bool decompress( const std::span< const unsigned char > _source, const std::span< unsigned char > _destination )
+	{
+		ZoneScoped;
+
+		size_t source_position      = 0;
+		size_t destination_position = 0;
+
+		while( source_position < _source.size() )
+		{
+			const unsigned char token = _source[ source_position++ ];
+
+			size_t literal_length = token >> 4;
+			if( literal_length == 15 && !readLength( _source, source_position, literal_length ) )
+				return false;
+
+			if( source_position + literal_length > _source.size() || destination_position + literal_length > _destination.size() )
+				return false;
+
+			std::memcpy( &_destination[ destination_position ], &_source[ source_position ], literal_length );
+			source_position      += literal_length;
+			destination_position += literal_length;
+
+			if( source_position == _source.size() )
+				break;
+
+			if( source_position + 2 > _source.size() )
+				return false;
+
+			const size_t offset  = _source[ source_position ] | _source[ source_position + 1 ] << 8;
+			source_position     += 2;
+
+			size_t match_length = token & 0xF;
+			if( match_length == 15 && !readLength( _source, source_position, match_length ) )
+				return false;
+
+			match_length += s_min_match;
+
+			if( !offset || offset > destination_position || destination_position + match_length > _destination.size() )
+				return false;
+
+			for( size_t i = 0; i < match_length; ++i, ++destination_position )
+				_destination[ destination_position ] = _destination[ destination_position - offset ];
+		}
+
+		return destination_position == _destination.size();
+	}
+}
@@ -0,0 +1,10 @@
+﻿#pragma once
+
+#include <span>
+#include <vector>
+
+namespace df::compression
+{
+	extern std::vector< unsigned char > compress( std::span< const unsigned char > _source );
+	extern bool                         decompress( std::span< const unsigned char > _source, std::span< unsigned char > _destination );
+}
@@ -0,0 +1,411 @@
+﻿#include "cAsyncIO.h"
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include <tracy/Tracy.hpp>
+
+#include "cFileSystem.h"
+#include "engine/log/Log.h"
+#include "engine/misc/cThreadPool.h"
+
+#ifdef DF_IO_URING
+	#include <fcntl.h>
+	#include <liburing.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace df
+{
+	struct cAsyncIO::sOperation
+	{
+		sRequest request;
+		int      file      = -1;
+		uint64_t completed = 0;
+	};
+
+#ifdef DF_IO_URING
+	struct cAsyncIO::sRing
+	{
+		io_uring    ring;
+		std::mutex  mutex;
+		std::thread thread;
+		bool        running = true;
+	};
+#else
+	struct cAsyncIO::sRing
+	{};
+#endif
+
+	cAsyncIO::cAsyncIO( const uint32_t _worker_count, [[maybe_unused]] const uint32_t _queue_depth )
+		: m_workers( new cThreadPool( _worker_count ) )
+		, m_ring( nullptr )
+		, m_pending( 0 )
+	{
+		ZoneScoped;
+
+#ifdef DF_IO_URING
+		m_ring = new sRing;
+		if( const int result = io_uring_queue_init( _queue_depth, &m_ring->ring, 0 ); result < 0 )
+		{
+			DF_LOG_WARNING( "Failed to initialize io_uring, falling back to thread pool: {}", -result );
+			delete m_ring;
+			m_ring = nullptr;
+		}
+		else
+		{
+			m_ring->thread = std::thread( &cAsyncIO::runRing, this );
+			DF_LOG_MESSAGE( "Initialized io_uring backend" );
+		}
+#endif
+
+		if( !m_ring )
+			DF_LOG_MESSAGE( "Initialized thread pool io backend with {} threads", m_workers->getThreadCount() );
+	}
+
+	cAsyncIO::~cAsyncIO()
+	{
+		ZoneScoped;
+
+		wait();
+
+#ifdef DF_IO_URING
+		if( m_ring )
+		{
+			{
+				std::lock_guard lock( m_ring->mutex );
+				m_ring->running = false;
+
+				io_uring_sqe* sqe = io_uring_get_sqe( &m_ring->ring );
+				io_uring_prep_nop( sqe );
+				io_uring_sqe_set_data( sqe, nullptr );
+				io_uring_submit( &m_ring->ring );
+			}
+
+			m_ring->thread.join();
+			io_uring_queue_exit( &m_ring->ring );
+			delete m_ring;
+		}
+#endif
+
+		delete m_workers;
+	}
+
+	void cAsyncIO::submit( std::vector< sRequest >& _requests )
+	{
+		ZoneScoped;
+
+		cAsyncIO* async_io = getInstance();
+		async_io->m_pending += static_cast< uint32_t >( _requests.size() );
+
+		std::vector< sOperation* > operations;
+		operations.reserve( _requests.size() );
+		for( sRequest& request: _requests )
+			operations.push_back( new sOperation{ .request = std::move( request ) } );
+
+		_requests.clear();
+
+		if( async_io->m_ring && async_io->submitRing( operations ) )
+			return;
+
+		std::vector< std::function< void() > > tasks;
+		tasks.reserve( operations.size() );
+		for( sOperation* operation: operations )
+			tasks.emplace_back( [ async_io, operation ] { async_io->execute( operation ); } );
+
+		async_io->m_workers->submit( tasks );
+	}
+
+	void cAsyncIO::read( const std::string&                                         _path,
+	                     const uint64_t                                             _offset,
+	                     const uint64_t                                             _size,
+	                     std::function< void( sRequest& _request, bool _success ) > _callback,
+	                     const eCompletion                                          _completion )
+	{
+		ZoneScoped;
+
+		std::vector< sRequest > requests( 1 );
+		requests.front() = {
+			.type       = eRead,
+			.path       = _path,
+			.offset     = _offset,
+			.size       = _size,
+			.completion = _completion,
+			.callback   = std::move( _callback ),
+		};
+
+		submit( requests );
+	}
+
+	void cAsyncIO::write( const std::string&                                         _path,
+	                      const uint64_t                                             _offset,
+	                      std::vector< unsigned char >                               _data,
+	                      std::function< void( sRequest& _request, bool _success ) > _callback,
+	                      const eCompletion                                          _completion )
+	{
+		ZoneScoped;
+
+		std::vector< sRequest > requests( 1 );
+		requests.front() = {
+			.type       = eWrite,
+			.path       = _path,
+			.offset     = _offset,
+			.size       = _data.size(),
+			.data       = std::move( _data ),
+			.completion = _completion,
+			.callback   = std::move( _callback ),
+		};
+
+		submit( requests );
+	}
+
+	void cAsyncIO::update()
+	{
+		ZoneScoped;
+
+		cAsyncIO* async_io = getInstance();
+
+		std::vector< std::pair< sOperation*, bool > > completions;
+		{
+			std::lock_guard lock( async_io->m_main_mutex );
+			completions.swap( async_io->m_main_completions );
+		}
+
+		for( const auto& [ operation, success ]: completions )
+		{
+			if( operation->request.callback )
+				operation->request.callback( operation->request, success );
+
+			delete operation;
+			--async_io->m_pending;
+		}
+	}
+
+	void cAsyncIO::wait()
+	{
+		ZoneScoped;
+
+		while( getInstance()->m_pending )
+		{
+			update();
+			std::this_thread::yield();
+		}
+	}
+
+	bool cAsyncIO::submitRing( [[maybe_unused]] std::vector< sOperation* >& _operations )
+	{
+		ZoneScoped;
+
+#ifdef DF_IO_URING
+		std::vector< sOperation* > fallback;
+
+		std::lock_guard lock( m_ring->mutex );
+		for( sOperation* operation: _operations )
+		{
+			sRequest& request = operation->request;
+
+			if( request.type == eRead )
+			{
+				operation->file = open( filesystem::getPath( request.path ).data(), O_RDONLY | O_CLOEXEC );
+				if( operation->file < 0 )
+				{
+					fallback.push_back( operation );
+					continue;
+				}
+
+				struct stat status;
+				if( !request.size && fstat( operation->file, &status ) == 0 )
+					request.size = static_cast< uint64_t >( status.st_size ) > request.offset ? static_cast< uint64_t >( status.st_size ) - request.offset : 0;
+
+				request.data.resize( request.size );
+			}
+			else
+			{
+				const std::string path = std::filesystem::path( request.path ).is_absolute() ? request.path : filesystem::getGameDirectory() + request.path;
+				operation->file        = open( path.data(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644 );
+				if( operation->file < 0 )
+				{
+					complete( operation, false );
+					continue;
+				}
+			}
+
+			if( !request.size )
+			{
+				complete( operation, true );
+				continue;
+			}
+
+			io_uring_sqe* sqe = io_uring_get_sqe( &m_ring->ring );
+			if( !sqe )
+			{
+				io_uring_submit( &m_ring->ring );
+				sqe = io_uring_get_sqe( &m_ring->ring );
+			}
+
+			// A single submission is limited to 32 bits, larger requests continue in runRing.
+			const unsigned length = static_cast< unsigned >( std::min< uint64_t >( request.size, std::numeric_limits< unsigned >::max() ) );
+
+			if( request.type == eRead )
+				io_uring_prep_read( sqe, operation->file, request.data.data(), length, request.offset );
+			else
+				io_uring_prep_write( sqe, operation->file, request.data.data(), length, request.offset );
+
+			io_uring_sqe_set_data( sqe, operation );
+		}
+
+		io_uring_submit( &m_ring->ring );
+
+		if( !fallback.empty() )
+		{
+			std::vector< std::function< void() > > tasks;
+			for( sOperation* operation: fallback )
+				tasks.emplace_back( [ this, operation ] { execute( operation ); } );
+
+			m_workers->submit( tasks );
+		}
+
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void cAsyncIO::runRing()
+	{
+		ZoneScoped;
+
+#ifdef DF_IO_URING
+		while( true )
+		{
+			io_uring_cqe* cqe = nullptr;
+			if( io_uring_wait_cqe( &m_ring->ring, &cqe ) < 0 )
+				continue;
+
+			sOperation* operation = static_cast< sOperation* >( io_uring_cqe_get_data( cqe ) );
+			const int   result    = cqe->res;
+			io_uring_cqe_seen( &m_ring->ring, cqe );
+
+			if( !operation )
+			{
+				std::lock_guard lock( m_ring->mutex );
+				if( !m_ring->running )
+					return;
+
+				continue;
+			}
+
+			sRequest& request = operation->request;
+
+			if( result < 0 || ( result == 0 && request.type == eWrite ) )
+			{
+				close( operation->file );
+				complete( operation, false );
+				continue;
+			}
+
+			operation->completed += static_cast< uint64_t >( result );
+
+			if( result == 0 || operation->completed >= request.size )
+			{
+				request.data.resize( operation->completed );
+				close( operation->file );
+				complete( operation, true );
+				continue;
+			}
+
+			std::lock_guard lock( m_ring->mutex );
+
+			io_uring_sqe* sqe = io_uring_get_sqe( &m_ring->ring );
+			if( !sqe )
+			{
+				io_uring_submit( &m_ring->ring );
+				sqe = io_uring_get_sqe( &m_ring->ring );
+			}
+
+			unsigned char* data      = request.data.data() + operation->completed;
+			const unsigned remaining = static_cast< unsigned >( std::min< uint64_t >( request.size - operation->completed, std::numeric_limits< unsigned >::max() ) );
+			const uint64_t offset    = request.offset + operation->completed;
+
+			if( request.type == eRead )
+				io_uring_prep_read( sqe, operation->file, data, remaining, offset );
+			else
+				io_uring_prep_write( sqe, operation->file, data, remaining, offset );
+
+			io_uring_sqe_set_data( sqe, operation );
+			io_uring_submit( &m_ring->ring );
+		}
+#endif
+	}
+
+	void cAsyncIO::execute( sOperation* _operation )
+	{
+		ZoneScoped;
+
+		sRequest& request = _operation->request;
+
+		if( request.type == eRead )
+		{
+			const cMappedFile file = filesystem::mapFile( request.path );
+			if( !file.isValid() || request.offset > file.getSize() )
+			{
+				complete( _operation, false );
+				return;
+			}
+
+			const uint64_t available = file.getSize() - request.offset;
+			request.size             = request.size ? std::min( request.size, available ) : available;
+
+			const std::span< const unsigned char > data = file.getData().subspan( request.offset, request.size );
+			request.data.assign( data.begin(), data.end() );
+
+			complete( _operation, true );
+			return;
+		}
+
+		const std::string path = std::filesystem::path( request.path ).is_absolute() ? request.path : filesystem::getGameDirectory() + request.path;
+		if( !std::filesystem::exists( path ) )
+			std::ofstream( path, std::ios::out | std::ios::binary );
+
+		std::fstream stream( path, std::ios::in | std::ios::out | std::ios::binary );
+		if( !stream.is_open() )
+		{
+			complete( _operation, false );
+			return;
+		}
+
+		stream.seekp( static_cast< std::streamoff >( request.offset ) );
+		stream.write( reinterpret_cast< const char* >( request.data.data() ), static_cast< std::streamsize >( request.data.size() ) );
+
+		complete( _operation, static_cast< bool >( stream ) );
+	}
+
+	void cAsyncIO::complete( sOperation* _operation, const bool _success )
+	{
+		ZoneScoped;
+
+		if( _operation->request.completion == eMainThread )
+		{
+			std::lock_guard lock( m_main_mutex );
+			m_main_completions.emplace_back( _operation, _success );
+			return;
+		}
+
+		const auto callback = [ this, _operation, _success ]
+		{
+			if( _operation->request.callback )
+				_operation->request.callback( _operation->request, _success );
+
+			delete _operation;
+			--m_pending;
+		};
+
+		if( m_ring )
+			m_workers->submit( callback );
+		else
+			callback();
+	}
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "engine/misc/iSingleton.h"
+
+namespace df
+{
+	class cThreadPool;
+
+	class cAsyncIO final : public iSingleton< cAsyncIO >
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cAsyncIO );
+
+		enum eType
+		{
+			eRead,
+			eWrite,
+		};
+
+		enum eCompletion
+		{
+			eWorker,
+			eMainThread,
+		};
+
+		struct sRequest
+		{
+			eType                                                      type = eRead;
+			std::string                                                path;
+			uint64_t                                                   offset = 0;
+			uint64_t                                                   size   = 0;
+			std::vector< unsigned char >                               data;
+			eCompletion                                                completion = eMainThread;
+			std::function< void( sRequest& _request, bool _success ) > callback;
+		};
+
+		explicit cAsyncIO( uint32_t _worker_count = 0, uint32_t _queue_depth = 256 );
+		~cAsyncIO() override;
+
+		static void submit( std::vector< sRequest >& _requests );
+		static void read( const std::string&                                         _path,
+		                  uint64_t                                                   _offset,
+		                  uint64_t                                                   _size,
+		                  std::function< void( sRequest& _request, bool _success ) > _callback,
+		                  eCompletion                                                _completion = eMainThread );
+		static void write( const std::string&                                         _path,
+		                   uint64_t                                                   _offset,
+		                   std::vector< unsigned char >                               _data,
+		                   std::function< void( sRequest& _request, bool _success ) > _callback,
+		                   eCompletion                                                _completion = eMainThread );
+
+		static void update();
+		static void wait();
+
+		static bool     isUsingIoUring() { return getInstance()->m_ring; }
+		static uint32_t getPending() { return getInstance()->m_pending; }
+
+	private:
+		struct sOperation;
+		struct sRing;
+
+		bool submitRing( std::vector< sOperation* >& _operations );
+		void runRing();
+
+		void execute( sOperation* _operation );
+		void complete( sOperation* _operation, bool _success );
+
+		cThreadPool* m_workers;
+		sRing*       m_ring;
+
+		std::mutex                                    m_main_mutex;
+		std::vector< std::pair< sOperation*, bool > > m_main_completions;
+		std::atomic< uint32_t >                       m_pending;
+	};
+}
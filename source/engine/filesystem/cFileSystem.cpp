@@ -1,16 +1,169 @@
 #include "cFileSystem.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fmt/format.h>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <tracy/Tracy.hpp>
+#include <unordered_map>
+
+#include "cPackFile.h"
+#include "engine/log/Log.h"
 
 namespace df::filesystem
 {
+	struct sIndexEntry
+	{
+		std::string path;
+		cPackFile*  pack;
+		size_t      entry;
+		bool        directory;
+	};
+
+	struct sMount
+	{
+		std::string                  virtual_path;
+		std::string                  physical_path;
+		std::unique_ptr< cPackFile > pack;
+	};
+
 	std::string                      s_game_directory{};
 	const std::vector< std::string > s_folders{
 		"data/", "data/models/", "data/textures/", "data/fonts/", "binaries/shaders/", "binaries/shaders/opengl/", "binaries/shaders/vulkan/", "data/resources/",
 	};
 
+	std::vector< sMount >                          s_mounts{};
+	std::unordered_map< std::string, sIndexEntry > s_entries{};
+	std::unordered_map< std::string, sIndexEntry > s_index{};
+	std::shared_mutex                              s_index_mutex{};
+	std::atomic< bool >                            s_indexed = false;
+
+	std::string normalize( const std::string& _path )
+	{
+		std::string path = _path;
+		std::ranges::replace( path, '\\', '/' );
+
+		if( !s_game_directory.empty() && path.starts_with( s_game_directory ) )
+			path.erase( 0, s_game_directory.size() );
+
+		path = std::filesystem::path( path ).lexically_normal().generic_string();
+		while( path.ends_with( '/' ) )
+			path.pop_back();
+
+		return path == "." ? std::string() : path;
+	}
+
+	std::string join( const std::string& _virtual_path, const std::string& _relative_path )
+	{
+		const std::string virtual_path = normalize( _virtual_path );
+		return virtual_path.empty() ? _relative_path : fmt::format( "{}/{}", virtual_path, _relative_path );
+	}
+
+	void addAliases( std::unordered_map< std::string, sIndexEntry >& _index, const std::string& _virtual_path, const sIndexEntry& _entry )
+	{
+		for( const std::string& folder: s_folders )
+		{
+			if( _virtual_path.size() > folder.size() && _virtual_path.starts_with( folder ) )
+				_index.emplace( _virtual_path.substr( folder.size() ), _entry );
+		}
+	}
+
+	void rebuildAliases()
+	{
+		ZoneScoped;
+
+		std::unordered_map< std::string, sIndexEntry > index = s_entries;
+		for( const std::string& folder: s_folders )
+		{
+			for( const std::pair< const std::string, sIndexEntry >& entry: s_entries )
+			{
+				if( entry.first.size() > folder.size() && entry.first.starts_with( folder ) )
+					index.emplace( entry.first.substr( folder.size() ), entry.second );
+			}
+		}
+
+		std::unique_lock lock( s_index_mutex );
+		s_index = std::move( index );
+	}
+
+	void indexDirectory( const std::string& _virtual_path, const std::string& _physical_path )
+	{
+		ZoneScoped;
+
+		std::error_code error;
+		for( const std::filesystem::directory_entry& entry: std::filesystem::recursive_directory_iterator( _physical_path, error ) )
+		{
+			const std::string relative_path = entry.path().lexically_relative( _physical_path ).generic_string();
+			std::string       path          = entry.path().string();
+			std::ranges::replace( path, '\\', '/' );
+
+			s_entries.insert_or_assign( join( _virtual_path, relative_path ),
+			                            sIndexEntry{
+											.path      = path,
+											.pack      = nullptr,
+											.entry     = 0,
+											.directory = entry.is_directory(),
+										} );
+		}
+
+		if( error )
+			DF_LOG_WARNING( "Failed to index directory: {}", _physical_path );
+	}
+
+	void indexPack( const sMount& _mount )
+	{
+		ZoneScoped;
+
+		const std::vector< cPackFile::sEntry >& entries = _mount.pack->getEntries();
+		for( size_t i = 0; i < entries.size(); ++i )
+		{
+			const std::string virtual_path = join( _mount.virtual_path, entries[ i ].path );
+
+			s_entries.insert_or_assign( virtual_path,
+			                            sIndexEntry{
+											.path      = s_game_directory + virtual_path,
+											.pack      = _mount.pack.get(),
+											.entry     = i,
+											.directory = false,
+										} );
+
+			for( std::filesystem::path parent = std::filesystem::path( virtual_path ).parent_path(); !parent.empty(); parent = parent.parent_path() )
+			{
+				const std::string directory = parent.generic_string();
+				s_entries.emplace( directory,
+				                   sIndexEntry{
+									   .path      = s_game_directory + directory,
+									   .pack      = nullptr,
+									   .entry     = 0,
+									   .directory = true,
+								   } );
+			}
+		}
+	}
+
+	std::optional< sIndexEntry > find( const std::string& _path )
+	{
+		ZoneScoped;
+
+		if( !s_indexed )
+			return std::nullopt;
+
+		const std::string path = normalize( _path );
+
+		std::shared_lock lock( s_index_mutex );
+		const auto       it = s_index.find( path );
+		if( it == s_index.end() )
+			return std::nullopt;
+
+		return it->second;
+	}
+
 	void setGameDirectory( const std::string& _path )
 	{
 		ZoneScoped;
@@ -26,10 +179,171 @@ namespace df::filesystem
 		return s_game_directory;
 	}
 
+	void mount( const std::string& _virtual_path, const std::string& _physical_path )
+	{
+		ZoneScoped;
+
+		std::string physical_path = std::filesystem::path( _physical_path ).is_absolute() ? _physical_path : s_game_directory + _physical_path;
+		std::ranges::replace( physical_path, '\\', '/' );
+
+		s_mounts.push_back( { .virtual_path = _virtual_path, .physical_path = physical_path, .pack = nullptr } );
+		DF_LOG_MESSAGE( "Mounted directory: {} at: {}", physical_path, _virtual_path );
+
+		if( s_indexed )
+			buildIndex();
+	}
+
+	bool mountPack( const std::string& _pack_path, const std::string& _virtual_path )
+	{
+		ZoneScoped;
+
+		const std::string pack_path = std::filesystem::path( _pack_path ).is_absolute() ? _pack_path : s_game_directory + _pack_path;
+
+		std::unique_ptr< cPackFile > pack = std::make_unique< cPackFile >( pack_path );
+		if( !pack->load() )
+			return false;
+
+		s_mounts.push_back( { .virtual_path = _virtual_path, .physical_path = pack_path, .pack = std::move( pack ) } );
+		DF_LOG_MESSAGE( "Mounted pack: {} at: {}", pack_path, _virtual_path );
+
+		if( s_indexed )
+			buildIndex();
+
+		return true;
+	}
+
+	void buildIndex()
+	{
+		ZoneScoped;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		s_entries.clear();
+
+		for( const sMount& mount: s_mounts )
+		{
+			if( mount.pack )
+				indexPack( mount );
+		}
+
+		indexDirectory( "", s_game_directory );
+
+		for( const sMount& mount: s_mounts )
+		{
+			if( !mount.pack )
+				indexDirectory( mount.virtual_path, mount.physical_path );
+		}
+
+		rebuildAliases();
+		s_indexed = true;
+
+		const std::chrono::duration< double, std::milli > duration = std::chrono::steady_clock::now() - start;
+		DF_LOG_MESSAGE( "Indexed {} files in {:.2f} ms", s_entries.size(), duration.count() );
+	}
+
+	void addToIndex( const std::string& _path )
+	{
+		ZoneScoped;
+
+		if( !s_indexed )
+			return;
+
+		std::string path = std::filesystem::path( _path ).is_absolute() ? _path : s_game_directory + _path;
+		std::ranges::replace( path, '\\', '/' );
+
+		std::error_code error;
+		if( !std::filesystem::exists( path, error ) )
+			return;
+
+		const std::string virtual_path = normalize( _path );
+		const sIndexEntry entry{
+			.path      = path,
+			.pack      = nullptr,
+			.entry     = 0,
+			.directory = std::filesystem::is_directory( path, error ),
+		};
+
+		s_entries.insert_or_assign( virtual_path, entry );
+
+		std::unique_lock lock( s_index_mutex );
+		s_index.insert_or_assign( virtual_path, entry );
+		addAliases( s_index, virtual_path, entry );
+	}
+
+	void removeFromIndex( const std::string& _path )
+	{
+		ZoneScoped;
+
+		if( !s_indexed )
+			return;
+
+		const std::string virtual_path = normalize( _path );
+		const std::string prefix       = virtual_path + "/";
+
+		std::vector< std::string > removed;
+		for( const std::pair< const std::string, sIndexEntry >& entry: s_entries )
+		{
+			if( !entry.second.pack && ( entry.first == virtual_path || entry.first.starts_with( prefix ) ) )
+				removed.push_back( entry.first );
+		}
+
+		std::unique_lock lock( s_index_mutex );
+		for( const std::string& path: removed )
+		{
+			const std::string physical_path = s_entries[ path ].path;
+			s_entries.erase( path );
+
+			if( const auto it = s_index.find( path ); it != s_index.end() && it->second.path == physical_path )
+				s_index.erase( it );
+
+			for( const std::string& folder: s_folders )
+			{
+				if( path.size() <= folder.size() || !path.starts_with( folder ) )
+					continue;
+
+				const std::string alias = path.substr( folder.size() );
+				const auto        it    = s_index.find( alias );
+				if( it == s_index.end() || it->second.path != physical_path )
+					continue;
+
+				s_index.erase( it );
+
+				// Another folder may hold a file under the same alias, which was shadowed until now.
+				for( const std::string& other: s_folders )
+				{
+					if( const auto other_it = s_entries.find( other + alias ); other_it != s_entries.end() )
+					{
+						s_index.emplace( alias, other_it->second );
+						break;
+					}
+				}
+			}
+		}
+	}
+
 	std::string getPath( const std::string& _path, const std::vector< std::string >& _folders )
 	{
 		ZoneScoped;
 
+		if( s_indexed )
+		{
+			if( _folders.empty() )
+			{
+				if( const std::optional< sIndexEntry > entry = find( _path ) )
+					return entry->path;
+
+				return _path;
+			}
+
+			for( const std::string& folder_path: _folders )
+			{
+				if( const std::optional< sIndexEntry > entry = find( folder_path + _path ) )
+					return entry->path;
+			}
+
+			return _path;
+		}
+
 		std::string full_path = s_game_directory + _path;
 		if( std::filesystem::exists( full_path ) )
 			return full_path;
@@ -61,49 +375,125 @@ namespace df::filesystem
 	{
 		ZoneScoped;
 
-		if( std::filesystem::exists( getPath( _path ) ) )
+		if( !s_indexed )
+			return std::filesystem::exists( getPath( _path ) );
+
+		return find( _path ).has_value();
+	}
+
+	bool equivalent( const std::string& _path_a, const std::string& _path_b )
+	{
+		ZoneScoped;
+
+		const std::string path_a = getPath( _path_a );
+		const std::string path_b = getPath( _path_b );
+		if( path_a == path_b )
 			return true;
 
-		return false;
+		std::error_code error;
+		return std::filesystem::equivalent( path_a, path_b, error );
 	}
 
-	std::string readAll( const std::string& _path, const std::string& _line_separator )
+	bool isInside( const std::string& _path, const std::string& _directory )
 	{
 		ZoneScoped;
 
-		std::string  data    = {};
-		std::fstream fstream = open( _path, std::ios::in );
+		const std::filesystem::path path      = std::filesystem::path( getPath( _path ) ).lexically_normal();
+		const std::filesystem::path directory = std::filesystem::path( getPath( _directory ) ).lexically_normal();
+		const std::filesystem::path relative  = path.lexically_relative( directory );
 
-		if( !fstream.is_open() )
+		return !relative.empty() && *relative.begin() != "..";
+	}
+
+	cMappedFile mapFile( const std::string& _path )
+	{
+		ZoneScoped;
+
+		const std::optional< sIndexEntry > entry = find( _path );
+		if( entry && entry->pack )
+			return entry->pack->read( entry->pack->getEntries()[ entry->entry ] );
+
+		if( entry && entry->directory )
+			return {};
+
+		return cMappedFile::map( entry ? entry->path : getPath( _path ) );
+	}
+
+	std::vector< unsigned char > readBinary( const std::string& _path )
+	{
+		ZoneScoped;
+
+		const std::optional< sIndexEntry > entry = find( _path );
+		if( entry && entry->pack )
+		{
+			const cMappedFile file = entry->pack->read( entry->pack->getEntries()[ entry->entry ] );
+			return std::vector( file.getData().begin(), file.getData().end() );
+		}
+
+		std::vector< unsigned char > data;
+		if( entry && entry->directory )
 			return data;
 
-		std::string line = {};
-		while( std::getline( fstream, line ) )
-			data += line + _line_separator;
+		std::ifstream stream( entry ? entry->path : getPath( _path ), std::ios::in | std::ios::binary | std::ios::ate );
+		const auto    size = stream.tellg();
+		if( !stream.is_open() || size < 0 )
+			return data;
 
+		data.resize( static_cast< size_t >( size ) );
+		stream.seekg( 0 );
+		stream.read( reinterpret_cast< char* >( data.data() ), static_cast< std::streamsize >( data.size() ) );
 		return data;
 	}
 
-	std::string readContent( const std::string& _path, const std::string& _line_separator )
+	std::string readLines( const std::string& _path, const std::string& _line_separator, const bool _skip_empty )
 	{
 		ZoneScoped;
 
-		std::string  data    = {};
-		std::fstream fstream = open( _path, std::ios::in );
+		const cMappedFile file = mapFile( _path );
+		std::string_view  text = file.getString();
+		std::string       data = {};
 
-		if( !fstream.is_open() )
+		if( text.empty() )
 			return data;
 
-		std::string line = {};
-		while( std::getline( fstream, line ) )
+		data.reserve( text.size() + static_cast< size_t >( std::ranges::count( text, '\n' ) + 1 ) * _line_separator.size() );
+
+		while( !text.empty() )
 		{
-			if( !line.empty() )
-				data += line + _line_separator;
+			const size_t     end  = text.find( '\n' );
+			std::string_view line = text.substr( 0, end );
+			if( line.ends_with( '\r' ) )
+				line.remove_suffix( 1 );
+
+			if( !_skip_empty || !line.empty() )
+			{
+				data.append( line );
+				data.append( _line_separator );
+			}
+
+			if( end == std::string_view::npos )
+				break;
+
+			text.remove_prefix( end + 1 );
 		}
 
 		return data;
 	}
 
+	std::string readAll( const std::string& _path, const std::string& _line_separator )
+	{
+		ZoneScoped;
+
+		return readLines( _path, _line_separator, false );
+	}
+
+	std::string readContent( const std::string& _path, const std::string& _line_separator )
+	{
+		ZoneScoped;
+
+		return readLines( _path, _line_separator, true );
+	}
+
 	void write( const std::string& _path, const std::string& _message, const std::ios::openmode _openmode )
 	{
 		ZoneScoped;
@@ -114,12 +504,20 @@ namespace df::filesystem
 			return;
 
 		fstream << _message;
+		fstream.close();
+
+		if( s_indexed && !find( _path ) )
+			addToIndex( _path );
 	}
 
 	int remove( const std::string& _path )
 	{
 		ZoneScoped;
 
-		return std::remove( getPath( _path ).c_str() );
+		const int result = std::remove( getPath( _path ).c_str() );
+		if( !result )
+			removeFromIndex( _path );
+
+		return result;
 	}
 }
@@ -4,15 +4,28 @@
 #include <string>
 #include <vector>
 
+#include "cMappedFile.h"
+
 namespace df::filesystem
 {
 	extern void               setGameDirectory( const std::string& _path );
 	extern const std::string& getGameDirectory();
 
+	extern void mount( const std::string& _virtual_path, const std::string& _physical_path );
+	extern bool mountPack( const std::string& _pack_path, const std::string& _virtual_path = "" );
+	extern void buildIndex();
+	extern void addToIndex( const std::string& _path );
+	extern void removeFromIndex( const std::string& _path );
+
 	std::string getPath( const std::string& _path, const std::vector< std::string >& _folders = {} );
 
 	extern std::fstream open( const std::string& _path, std::ios::openmode _openmode = std::ios::in );
 	extern bool         exists( const std::string& _path );
+	extern bool         equivalent( const std::string& _path_a, const std::string& _path_b );
+	extern bool         isInside( const std::string& _path, const std::string& _directory );
+
+	extern cMappedFile                  mapFile( const std::string& _path );
+	extern std::vector< unsigned char > readBinary( const std::string& _path );
 	extern std::string  readAll( const std::string& _path, const std::string& _line_separator = "" );
 	extern std::string  readContent( const std::string& _path, const std::string& _line_separator = "" );
 	extern void         write( const std::string& _path, const std::string& _message, std::ios::openmode _openmode = std::ios::out );
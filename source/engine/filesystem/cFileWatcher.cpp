@@ -0,0 +1,315 @@
+﻿#include "cFileWatcher.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fmt/format.h>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+
+#if defined( _WIN32 )
+	#include <array>
+	#include <windows.h>
+#elif defined( __linux__ )
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace df
+{
+#if defined( _WIN32 )
+	struct cFileWatcher::sPlatform
+	{
+		struct sDirectory
+		{
+			std::string                                    path;
+			HANDLE                                         handle;
+			OVERLAPPED                                     overlapped;
+			alignas( DWORD ) std::array< BYTE, 64 * 1024 > buffer;
+		};
+
+		static bool read( sDirectory* _directory )
+		{
+			return ReadDirectoryChangesW( _directory->handle,
+			                              _directory->buffer.data(),
+			                              static_cast< DWORD >( _directory->buffer.size() ),
+			                              true,
+			                              FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME,
+			                              nullptr,
+			                              &_directory->overlapped,
+			                              nullptr );
+		}
+
+		std::vector< sDirectory* > directories;
+	};
+#elif defined( __linux__ )
+	struct cFileWatcher::sPlatform
+	{
+		int                                    inotify = -1;
+		std::unordered_map< int, std::string > directories;
+	};
+#else
+	struct cFileWatcher::sPlatform
+	{};
+#endif
+
+	cFileWatcher::cFileWatcher( const std::vector< std::string >& _directories, const std::chrono::milliseconds _settle_time )
+		: m_platform( new sPlatform )
+		, m_running( false )
+		, m_settle_time( _settle_time )
+	{
+		ZoneScoped;
+
+		bool watching = false;
+		for( const std::string& directory: _directories )
+			watching |= watchDirectory( directory );
+
+		if( !watching )
+		{
+			DF_LOG_WARNING( "File watcher has no directories to watch" );
+			return;
+		}
+
+		m_running = true;
+		m_thread  = std::thread( &cFileWatcher::run, this );
+
+		DF_LOG_MESSAGE( "Started file watcher" );
+	}
+
+	cFileWatcher::~cFileWatcher()
+	{
+		ZoneScoped;
+
+		m_running = false;
+		if( m_thread.joinable() )
+			m_thread.join();
+
+#if defined( _WIN32 )
+		for( sPlatform::sDirectory* directory: m_platform->directories )
+		{
+			CancelIo( directory->handle );
+			CloseHandle( directory->handle );
+			CloseHandle( directory->overlapped.hEvent );
+			delete directory;
+		}
+#elif defined( __linux__ )
+		if( m_platform->inotify >= 0 )
+			close( m_platform->inotify );
+#endif
+
+		delete m_platform;
+	}
+
+	std::vector< std::string > cFileWatcher::getChangedFiles()
+	{
+		ZoneScoped;
+
+		std::vector< std::string > changed;
+		const auto                 now = std::chrono::steady_clock::now();
+
+		std::lock_guard lock( m_mutex );
+		for( auto it = m_pending.begin(); it != m_pending.end(); )
+		{
+			if( now - it->second < m_settle_time )
+			{
+				++it;
+				continue;
+			}
+
+			changed.push_back( it->first );
+			it = m_pending.erase( it );
+		}
+
+		return changed;
+	}
+
+	bool cFileWatcher::watchDirectory( const std::string& _path )
+	{
+		ZoneScoped;
+
+		std::string path = _path;
+		std::ranges::replace( path, '\\', '/' );
+		if( path.ends_with( '/' ) )
+			path.pop_back();
+
+		if( !std::filesystem::is_directory( path ) )
+		{
+			DF_LOG_WARNING( "Directory doesn't exist: {}", path );
+			return false;
+		}
+
+#if defined( _WIN32 )
+		sPlatform::sDirectory* directory = new sPlatform::sDirectory{ .path = path };
+
+		directory->handle = CreateFileA( path.data(),
+		                                 FILE_LIST_DIRECTORY,
+		                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		                                 nullptr,
+		                                 OPEN_EXISTING,
+		                                 FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+		                                 nullptr );
+
+		if( directory->handle == INVALID_HANDLE_VALUE )
+		{
+			DF_LOG_WARNING( "Failed to open directory: {}", path );
+			delete directory;
+			return false;
+		}
+
+		directory->overlapped.hEvent = CreateEvent( nullptr, true, false, nullptr );
+		if( !sPlatform::read( directory ) )
+		{
+			DF_LOG_WARNING( "Failed to watch directory: {}", path );
+			CloseHandle( directory->overlapped.hEvent );
+			CloseHandle( directory->handle );
+			delete directory;
+			return false;
+		}
+
+		m_platform->directories.push_back( directory );
+		DF_LOG_MESSAGE( "Watching directory: {}", path );
+		return true;
+#elif defined( __linux__ )
+		if( m_platform->inotify < 0 )
+			m_platform->inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+		if( m_platform->inotify < 0 )
+		{
+			DF_LOG_WARNING( "Failed to initialize inotify" );
+			return false;
+		}
+
+		constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM;
+
+		const int descriptor = inotify_add_watch( m_platform->inotify, path.data(), mask );
+		if( descriptor < 0 )
+		{
+			DF_LOG_WARNING( "Failed to watch directory: {}", path );
+			return false;
+		}
+
+		m_platform->directories[ descriptor ] = path;
+
+		std::error_code error;
+		for( const std::filesystem::directory_entry& entry: std::filesystem::recursive_directory_iterator( path, error ) )
+		{
+			if( !entry.is_directory() )
+				continue;
+
+			std::string sub_path = entry.path().string();
+			std::ranges::replace( sub_path, '\\', '/' );
+
+			const int sub_descriptor = inotify_add_watch( m_platform->inotify, sub_path.data(), mask );
+			if( sub_descriptor >= 0 )
+				m_platform->directories[ sub_descriptor ] = sub_path;
+		}
+
+		DF_LOG_MESSAGE( "Watching directory: {}", path );
+		return true;
+#else
+		DF_LOG_WARNING( "File watching isn't supported on this platform: {}", path );
+		return false;
+#endif
+	}
+
+	void cFileWatcher::run()
+	{
+		ZoneScoped;
+
+#if defined( _WIN32 )
+		std::vector< HANDLE > events;
+		for( const sPlatform::sDirectory* directory: m_platform->directories )
+			events.push_back( directory->overlapped.hEvent );
+
+		while( m_running )
+		{
+			const DWORD result = WaitForMultipleObjects( static_cast< DWORD >( events.size() ), events.data(), false, 100 );
+			if( result < WAIT_OBJECT_0 || result >= WAIT_OBJECT_0 + events.size() )
+				continue;
+
+			sPlatform::sDirectory* directory = m_platform->directories[ result - WAIT_OBJECT_0 ];
+
+			DWORD bytes = 0;
+			if( GetOverlappedResult( directory->handle, &directory->overlapped, &bytes, false ) && bytes > 0 )
+			{
+				const BYTE* data = directory->buffer.data();
+				while( true )
+				{
+					const FILE_NOTIFY_INFORMATION* information = reinterpret_cast< const FILE_NOTIFY_INFORMATION* >( data );
+
+					if( information->Action == FILE_ACTION_ADDED || information->Action == FILE_ACTION_MODIFIED || information->Action == FILE_ACTION_RENAMED_NEW_NAME
+					    || information->Action == FILE_ACTION_REMOVED || information->Action == FILE_ACTION_RENAMED_OLD_NAME )
+					{
+						const int   length = static_cast< int >( information->FileNameLength / sizeof( WCHAR ) );
+						std::string name( WideCharToMultiByte( CP_UTF8, 0, information->FileName, length, nullptr, 0, nullptr, nullptr ), '\0' );
+						WideCharToMultiByte( CP_UTF8, 0, information->FileName, length, name.data(), static_cast< int >( name.size() ), nullptr, nullptr );
+
+						addChanged( fmt::format( "{}/{}", directory->path, name ) );
+					}
+
+					if( !information->NextEntryOffset )
+						break;
+
+					data += information->NextEntryOffset;
+				}
+			}
+
+			ResetEvent( directory->overlapped.hEvent );
+			sPlatform::read( directory );
+		}
+#elif defined( __linux__ )
+		alignas( inotify_event ) char buffer[ 64 * 1024 ];
+
+		while( m_running )
+		{
+			pollfd poll_descriptor{ .fd = m_platform->inotify, .events = POLLIN, .revents = 0 };
+			if( poll( &poll_descriptor, 1, 100 ) <= 0 )
+				continue;
+
+			const ssize_t length = read( m_platform->inotify, buffer, sizeof( buffer ) );
+			for( ssize_t offset = 0; offset < length; )
+			{
+				const inotify_event* event = reinterpret_cast< const inotify_event* >( buffer + offset );
+				offset += static_cast< ssize_t >( sizeof( inotify_event ) + event->len );
+
+				if( event->mask & IN_IGNORED )
+				{
+					m_platform->directories.erase( event->wd );
+					continue;
+				}
+
+				const auto it = m_platform->directories.find( event->wd );
+				if( it == m_platform->directories.end() || !event->len )
+					continue;
+
+				const std::string path = fmt::format( "{}/{}", it->second, event->name );
+
+				if( event->mask & IN_ISDIR )
+				{
+					if( event->mask & ( IN_CREATE | IN_MOVED_TO ) )
+						watchDirectory( path );
+					else if( event->mask & ( IN_DELETE | IN_MOVED_FROM ) )
+						addChanged( path );
+
+					continue;
+				}
+
+				if( event->mask & ( IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM ) )
+					addChanged( path );
+			}
+		}
+#endif
+	}
+
+	void cFileWatcher::addChanged( const std::string& _path )
+	{
+		ZoneScoped;
+
+		std::string path = _path;
+		std::ranges::replace( path, '\\', '/' );
+
+		std::lock_guard lock( m_mutex );
+		m_pending[ path ] = std::chrono::steady_clock::now();
+	}
+}
@@ -0,0 +1,42 @@
+﻿#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/misc/Misc.h"
+
+namespace df
+{
+	class cFileWatcher
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cFileWatcher );
+
+		explicit cFileWatcher( const std::vector< std::string >& _directories, std::chrono::milliseconds _settle_time = std::chrono::milliseconds( 250 ) );
+		~cFileWatcher();
+
+		std::vector< std::string > getChangedFiles();
+
+		bool isWatching() const { return m_thread.joinable(); }
+
+	private:
+		struct sPlatform;
+
+		bool watchDirectory( const std::string& _path );
+		void run();
+		void addChanged( const std::string& _path );
+
+		sPlatform*          m_platform;
+		std::thread         m_thread;
+		std::atomic< bool > m_running;
+
+		std::mutex                                                               m_mutex;
+		std::unordered_map< std::string, std::chrono::steady_clock::time_point > m_pending;
+		std::chrono::milliseconds                                                m_settle_time;
+	};
+}
@@ -0,0 +1,117 @@
+﻿#include "cMappedFile.h"
+
+#include <tracy/Tracy.hpp>
+
+#if defined( _WIN32 )
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace df
+{
+	struct sMapping
+	{
+		~sMapping()
+		{
+			ZoneScoped;
+
+			if( !address )
+				return;
+
+#if defined( _WIN32 )
+			UnmapViewOfFile( address );
+#else
+			munmap( address, size );
+#endif
+		}
+
+		void*  address = nullptr;
+		size_t size    = 0;
+	};
+
+	cMappedFile::cMappedFile( std::shared_ptr< const void > _owner, const std::span< const unsigned char > _data )
+		: m_owner( std::move( _owner ) )
+		, m_data( _data )
+	{}
+
+	cMappedFile cMappedFile::map( const std::string& _path )
+	{
+		ZoneScoped;
+
+		const std::shared_ptr< sMapping > mapping = std::make_shared< sMapping >();
+
+#if defined( _WIN32 )
+		const HANDLE file = CreateFileA( _path.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+		if( file == INVALID_HANDLE_VALUE )
+			return {};
+
+		LARGE_INTEGER size;
+		if( !GetFileSizeEx( file, &size ) )
+		{
+			CloseHandle( file );
+			return {};
+		}
+
+		mapping->size = static_cast< size_t >( size.QuadPart );
+		if( mapping->size )
+		{
+			const HANDLE file_mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+			if( file_mapping )
+			{
+				mapping->address = MapViewOfFile( file_mapping, FILE_MAP_READ, 0, 0, 0 );
+				CloseHandle( file_mapping );
+			}
+		}
+
+		CloseHandle( file );
+#else
+		const int file = open( _path.data(), O_RDONLY | O_CLOEXEC );
+		if( file < 0 )
+			return {};
+
+		struct stat status;
+		if( fstat( file, &status ) != 0 || !S_ISREG( status.st_mode ) )
+		{
+			close( file );
+			return {};
+		}
+
+		mapping->size = static_cast< size_t >( status.st_size );
+		if( mapping->size )
+		{
+			void* address = mmap( nullptr, mapping->size, PROT_READ, MAP_PRIVATE, file, 0 );
+			if( address != MAP_FAILED )
+				mapping->address = address;
+		}
+
+		close( file );
+#endif
+
+		if( mapping->size && !mapping->address )
+			return {};
+
+		return cMappedFile( mapping, std::span( static_cast< const unsigned char* >( mapping->address ), mapping->size ) );
+	}
+
+	cMappedFile cMappedFile::fromBuffer( std::vector< unsigned char >&& _buffer )
+	{
+		ZoneScoped;
+
+		const std::shared_ptr< std::vector< unsigned char > > buffer = std::make_shared< std::vector< unsigned char > >( std::move( _buffer ) );
+		return cMappedFile( buffer, *buffer );
+	}
+
+	cMappedFile cMappedFile::subspan( const size_t _offset, const size_t _size ) const
+	{
+		ZoneScoped;
+
+		if( _offset > m_data.size() || _size > m_data.size() - _offset )
+			return {};
+
+		return cMappedFile( m_owner, m_data.subspan( _offset, _size ) );
+	}
+}
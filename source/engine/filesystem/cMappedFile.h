@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace df
+{
+	class cMappedFile
+	{
+	public:
+		cMappedFile() = default;
+		cMappedFile( std::shared_ptr< const void > _owner, std::span< const unsigned char > _data );
+
+		static cMappedFile map( const std::string& _path );
+		static cMappedFile fromBuffer( std::vector< unsigned char >&& _buffer );
+
+		cMappedFile subspan( size_t _offset, size_t _size ) const;
+
+		std::span< const unsigned char > getData() const { return m_data; }
+		std::string_view                 getString() const { return std::string_view( reinterpret_cast< const char* >( m_data.data() ), m_data.size() ); }
+		size_t                           getSize() const { return m_data.size(); }
+		bool                             isValid() const { return m_owner != nullptr; }
+
+	private:
+		std::shared_ptr< const void >    m_owner;
+		std::span< const unsigned char > m_data;
+	};
+}
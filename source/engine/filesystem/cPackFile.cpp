@@ -0,0 +1,224 @@
+﻿#include "cPackFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <tracy/Tracy.hpp>
+
+#include "Compression.h"
+#include "engine/log/Log.h"
+
+namespace df
+{
+	cPackFile::cPackFile( std::string _path )
+		: m_path( std::move( _path ) )
+	{}
+
+	bool cPackFile::load()
+	{
+		ZoneScoped;
+
+		m_file = cMappedFile::map( m_path );
+		if( !m_file.isValid() )
+		{
+			DF_LOG_WARNING( "Failed to open pack: {}", m_path );
+			return false;
+		}
+
+		sHeader header{};
+		if( m_file.getSize() < sizeof( header ) )
+		{
+			DF_LOG_WARNING( "Invalid pack header: {}", m_path );
+			return false;
+		}
+
+		std::memcpy( &header, m_file.getData().data(), sizeof( header ) );
+		if( std::memcmp( header.magic, s_magic, sizeof( s_magic ) ) != 0 || header.version != s_version )
+		{
+			DF_LOG_WARNING( "Invalid pack header: {}", m_path );
+			return false;
+		}
+
+		const cMappedFile toc = m_file.subspan( header.toc_offset, header.toc_size );
+		if( !toc.isValid() )
+		{
+			DF_LOG_WARNING( "Failed to read pack table of contents: {}", m_path );
+			return false;
+		}
+
+		size_t     position = 0;
+		const auto take     = [ & ]( void* _destination, const size_t _size )
+		{
+			if( position + _size > toc.getSize() )
+				return false;
+
+			std::memcpy( _destination, toc.getData().data() + position, _size );
+			position += _size;
+			return true;
+		};
+
+		m_entries.clear();
+		m_entries.reserve( header.entry_count );
+		for( uint32_t i = 0; i < header.entry_count; ++i )
+		{
+			sEntry   entry{};
+			uint32_t path_length = 0;
+
+			bool valid = take( &path_length, sizeof( path_length ) );
+			if( valid )
+			{
+				entry.path.resize( path_length );
+				valid = take( entry.path.data(), path_length );
+			}
+
+			valid = valid && take( &entry.offset, sizeof( entry.offset ) ) && take( &entry.size, sizeof( entry.size ) )
+			     && take( &entry.stored_size, sizeof( entry.stored_size ) ) && take( &entry.flags, sizeof( entry.flags ) );
+
+			if( !valid || entry.offset + entry.stored_size > header.toc_offset )
+			{
+				DF_LOG_WARNING( "Corrupt pack table of contents: {}", m_path );
+				m_entries.clear();
+				return false;
+			}
+
+			m_entries.push_back( std::move( entry ) );
+		}
+
+		DF_LOG_MESSAGE( "Loaded pack: {} with {} entries", m_path, m_entries.size() );
+		return true;
+	}
+
+	cMappedFile cPackFile::read( const sEntry& _entry ) const
+	{
+		ZoneScoped;
+
+		const cMappedFile stored = m_file.subspan( _entry.offset, _entry.stored_size );
+		if( !stored.isValid() )
+		{
+			DF_LOG_WARNING( "Failed to read pack entry: {}", _entry.path );
+			return {};
+		}
+
+		if( !( _entry.flags & eCompressed ) )
+			return stored;
+
+		std::vector< unsigned char > data( _entry.size );
+		if( !compression::decompress( stored.getData(), data ) )
+		{
+			DF_LOG_WARNING( "Failed to decompress pack entry: {}", _entry.path );
+			return {};
+		}
+
+		return cMappedFile::fromBuffer( std::move( data ) );
+	}
+
+	bool cPackFile::create( const std::string& _pack_path, const std::string& _directory, const bool _compress, const uint32_t _alignment )
+	{
+		ZoneScoped;
+
+		std::error_code                      error;
+		std::vector< std::filesystem::path > files;
+		for( const std::filesystem::directory_entry& entry: std::filesystem::recursive_directory_iterator( _directory, error ) )
+		{
+			if( entry.is_regular_file() )
+				files.push_back( entry.path() );
+		}
+
+		if( error )
+		{
+			DF_LOG_WARNING( "Failed to iterate directory: {}", _directory );
+			return false;
+		}
+
+		std::ranges::sort( files );
+
+		std::ofstream stream( _pack_path, std::ios::out | std::ios::binary | std::ios::trunc );
+		if( !stream.is_open() )
+		{
+			DF_LOG_WARNING( "Failed to create pack: {}", _pack_path );
+			return false;
+		}
+
+		sHeader header{};
+		std::memcpy( header.magic, s_magic, sizeof( s_magic ) );
+		header.version   = s_version;
+		header.alignment = std::max( _alignment, 1u );
+		stream.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+		const auto align = [ & ]
+		{
+			const uint64_t position = static_cast< uint64_t >( stream.tellp() );
+			const uint64_t padding  = ( header.alignment - position % header.alignment ) % header.alignment;
+
+			static constexpr char zeros[ 4096 ] = {};
+			for( uint64_t written = 0; written < padding; written += sizeof( zeros ) )
+				stream.write( zeros, static_cast< std::streamsize >( std::min< uint64_t >( padding - written, sizeof( zeros ) ) ) );
+		};
+
+		std::vector< sEntry > entries;
+		for( const std::filesystem::path& file: files )
+		{
+			cMappedFile input = cMappedFile::map( file.string() );
+			if( !input.isValid() )
+			{
+				DF_LOG_WARNING( "Failed to open file: {}", file.string() );
+				continue;
+			}
+
+			sEntry entry{
+				.path        = file.lexically_relative( _directory ).generic_string(),
+				.offset      = 0,
+				.size        = input.getSize(),
+				.stored_size = input.getSize(),
+				.flags       = 0,
+			};
+
+			if( _compress && input.getSize() )
+			{
+				std::vector< unsigned char > compressed = compression::compress( input.getData() );
+				if( compressed.size() < input.getSize() )
+				{
+					input             = cMappedFile::fromBuffer( std::move( compressed ) );
+					entry.stored_size = input.getSize();
+					entry.flags      |= eCompressed;
+				}
+			}
+
+			align();
+			entry.offset = static_cast< uint64_t >( stream.tellp() );
+			stream.write( reinterpret_cast< const char* >( input.getData().data() ), static_cast< std::streamsize >( input.getSize() ) );
+
+			entries.push_back( std::move( entry ) );
+		}
+
+		align();
+		header.entry_count = static_cast< uint32_t >( entries.size() );
+		header.toc_offset  = static_cast< uint64_t >( stream.tellp() );
+
+		for( const sEntry& entry: entries )
+		{
+			const uint32_t path_length = static_cast< uint32_t >( entry.path.size() );
+			stream.write( reinterpret_cast< const char* >( &path_length ), sizeof( path_length ) );
+			stream.write( entry.path.data(), path_length );
+			stream.write( reinterpret_cast< const char* >( &entry.offset ), sizeof( entry.offset ) );
+			stream.write( reinterpret_cast< const char* >( &entry.size ), sizeof( entry.size ) );
+			stream.write( reinterpret_cast< const char* >( &entry.stored_size ), sizeof( entry.stored_size ) );
+			stream.write( reinterpret_cast< const char* >( &entry.flags ), sizeof( entry.flags ) );
+		}
+
+		header.toc_size = static_cast< uint64_t >( stream.tellp() ) - header.toc_offset;
+		stream.seekp( 0 );
+		stream.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+		if( !stream )
+		{
+			DF_LOG_WARNING( "Failed to write pack: {}", _pack_path );
+			return false;
+		}
+
+		DF_LOG_MESSAGE( "Created pack: {} with {} entries", _pack_path, entries.size() );
+		return true;
+	}
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cMappedFile.h"
+#include "engine/misc/Misc.h"
+
+namespace df
+{
+	class cPackFile
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cPackFile );
+
+		enum eFlags
+		{
+			eCompressed = 1 << 0,
+		};
+
+		struct sEntry
+		{
+			std::string path;
+			uint64_t    offset;
+			uint64_t    size;
+			uint64_t    stored_size;
+			uint32_t    flags;
+		};
+
+		explicit cPackFile( std::string _path );
+		~cPackFile() = default;
+
+		bool        load();
+		cMappedFile read( const sEntry& _entry ) const;
+
+		const std::string&           getPath() const { return m_path; }
+		const std::vector< sEntry >& getEntries() const { return m_entries; }
+
+		static bool create( const std::string& _pack_path, const std::string& _directory, bool _compress = true, uint32_t _alignment = 4096 );
+
+	private:
+		struct sHeader
+		{
+			char     magic[ 4 ];
+			uint32_t version;
+			uint32_t entry_count;
+			uint32_t alignment;
+			uint64_t toc_offset;
+			uint64_t toc_size;
+		};
+
+		static constexpr char     s_magic[ 4 ] = { 'D', 'F', 'P', 'K' };
+		static constexpr uint32_t s_version    = 1;
+
+		std::string           m_path;
+		cMappedFile           m_file;
+		std::vector< sEntry > m_entries;
+	};
+}
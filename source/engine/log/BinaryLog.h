@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace df::log::binary
+{
+	enum eRecord : uint8_t
+	{
+		eFormat,
+		eEntry,
+	};
+
+	enum eArgument : uint8_t
+	{
+		eSigned,
+		eUnsigned,
+		eFloat,
+		eBool,
+		eChar,
+		eString,
+		ePointer,
+	};
+
+	struct sHeader
+	{
+		char     magic[ 4 ];
+		uint32_t version;
+		uint64_t start_time;
+	};
+
+	constexpr char     s_magic[ 4 ] = { 'D', 'F', 'L', 'G' };
+	constexpr uint32_t s_version    = 1;
+
+	template< typename T >
+	void write( std::string& _buffer, const T& _value )
+	{
+		_buffer.append( reinterpret_cast< const char* >( &_value ), sizeof( T ) );
+	}
+
+	inline void writeString( std::string& _buffer, const std::string_view _value )
+	{
+		write( _buffer, static_cast< uint32_t >( _value.size() ) );
+		_buffer.append( _value );
+	}
+
+	template< typename T >
+	bool read( std::string_view& _buffer, T& _value )
+	{
+		if( _buffer.size() < sizeof( T ) )
+			return false;
+
+		std::memcpy( &_value, _buffer.data(), sizeof( T ) );
+		_buffer.remove_prefix( sizeof( T ) );
+		return true;
+	}
+
+	inline bool readString( std::string_view& _buffer, std::string_view& _value )
+	{
+		uint32_t size = 0;
+		if( !read( _buffer, size ) || _buffer.size() < size )
+			return false;
+
+		_value = _buffer.substr( 0, size );
+		_buffer.remove_prefix( size );
+		return true;
+	}
+}
@@ -1,48 +1,459 @@
 ﻿#include "Log.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <fmt/color.h>
 #include <fmt/format.h>
+#include <limits>
+#include <thread>
 #include <tracy/Tracy.hpp>
+#include <unordered_map>
+#include <vector>
 
+#include "BinaryLog.h"
 #include "engine/filesystem/cFileSystem.h"
+#include "engine/misc/cBoundedQueue.h"
 
 namespace df::log
 {
-	void print( const eType _type, const char* _function, const unsigned _line, const std::string& _message )
+	namespace
 	{
-		ZoneScoped;
+		struct sRecord
+		{
+			eType            type;
+			eCategory        category;
+			const char*      function;
+			unsigned         line;
+			fmt::string_view format;
+			tArguments       arguments;
+			uint64_t         timestamp;
+			uint32_t         thread;
+		};
+
+		struct sFormatKey
+		{
+			const char* format;
+			const char* function;
+			unsigned    line;
+
+			bool operator==( const sFormatKey& ) const = default;
+		};
+
+		struct sFormatHash
+		{
+			size_t operator()( const sFormatKey& _key ) const
+			{
+				return std::hash< const void* >()( _key.format ) ^ std::hash< const void* >()( _key.function ) * 31 ^ _key.line;
+			}
+		};
+
+		struct sWriter
+		{
+			explicit sWriter( const eOverflow _overflow, const size_t _capacity, const eFormat _format )
+				: queue( _capacity )
+				, overflow( _overflow )
+				, format( _format )
+				, file( nullptr )
+				, console( true )
+				, running( true )
+				, sleeping( false )
+				, signal( 0 )
+				, pushed( 0 )
+				, written( 0 )
+				, dropped( 0 )
+			{}
+
+			cBoundedQueue< sRecord > queue;
+			eOverflow                overflow;
+			eFormat                  format;
+			std::FILE*               file;
+			bool                     console;
+			std::thread              thread;
+
+			std::unordered_map< sFormatKey, uint32_t, sFormatHash > formats;
+
+			std::atomic< bool >     running;
+			std::atomic< bool >     sleeping;
+			std::atomic< uint32_t > signal;
+			std::atomic< uint64_t > pushed;
+			std::atomic< uint64_t > written;
+			std::atomic< uint64_t > dropped;
+		};
+
+		std::atomic< sWriter* > s_writer = nullptr;
+
+		std::atomic< uint32_t > s_thread_count = 0;
+		thread_local uint32_t   s_thread_id    = s_thread_count++;
+
+		uint64_t getTimestamp()
+		{
+			return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::system_clock::now().time_since_epoch() ).count() );
+		}
 
-		printFile( _type, _function, _line, _message );
+		std::string formatFile( const eType _type, const char* _function, const unsigned _line, const std::string& _message )
+		{
+			std::string message = {};
+
+			switch( _type )
+			{
+				case eRaw:
+					message = "[  RAW  ];;";
+					break;
+				case eMessage:
+					message = "[MESSAGE];;";
+					break;
+				case eWarning:
+					message = "[WARNING];;";
+					break;
+				case eError:
+					message = "[ ERROR ];;";
+					break;
+			}
+
+			message += fmt::format( "{};;{};;{}\n", _function, _line, _message );
+			return message;
+		}
+
+		void wake( sWriter* _writer )
+		{
+			if( !_writer->sleeping.load() )
+				return;
+
+			++_writer->signal;
+			_writer->signal.notify_one();
+		}
+
+		void writeArguments( std::string& _batch, const fmt::format_args _arguments )
+		{
+			std::string values;
+			uint8_t     count = 0;
+
+			for( int i = 0; count < std::numeric_limits< uint8_t >::max(); ++i, ++count )
+			{
+				const fmt::basic_format_arg< fmt::format_context > argument = _arguments.get( i );
+				if( !argument )
+					break;
+
+				fmt::visit_format_arg(
+					[ & ]( const auto _value )
+					{
+						using T = std::remove_cvref_t< decltype( _value ) >;
+
+						if constexpr( std::is_same_v< T, bool > )
+						{
+							binary::write( values, binary::eBool );
+							binary::write( values, static_cast< uint8_t >( _value ) );
+						}
+						else if constexpr( std::is_same_v< T, char > )
+						{
+							binary::write( values, binary::eChar );
+							binary::write( values, _value );
+						}
+						else if constexpr( std::is_integral_v< T > && std::is_signed_v< T > )
+						{
+							binary::write( values, binary::eSigned );
+							binary::write( values, static_cast< int64_t >( _value ) );
+						}
+						else if constexpr( std::is_integral_v< T > )
+						{
+							binary::write( values, binary::eUnsigned );
+							binary::write( values, static_cast< uint64_t >( _value ) );
+						}
+						else if constexpr( std::is_floating_point_v< T > )
+						{
+							binary::write( values, binary::eFloat );
+							binary::write( values, static_cast< double >( _value ) );
+						}
+						else if constexpr( std::is_same_v< T, const char* > )
+						{
+							binary::write( values, binary::eString );
+							binary::writeString( values, _value );
+						}
+						else if constexpr( std::is_same_v< T, fmt::string_view > )
+						{
+							binary::write( values, binary::eString );
+							binary::writeString( values, std::string_view( _value.data(), _value.size() ) );
+						}
+						else if constexpr( std::is_same_v< T, const void* > )
+						{
+							binary::write( values, binary::ePointer );
+							binary::write( values, static_cast< uint64_t >( reinterpret_cast< uintptr_t >( _value ) ) );
+						}
+						else
+						{
+							binary::write( values, binary::eString );
+							binary::writeString( values, fmt::vformat( "{}", fmt::format_args( &argument, 1 ) ) );
+						}
+					},
+					argument );
+			}
+
+			binary::write( _batch, count );
+			_batch += values;
+		}
+
+		void writeBinary( sWriter* _writer, std::string& _batch, const sRecord& _record )
+		{
+			const sFormatKey key{ _record.format.data(), _record.function, _record.line };
+
+			auto it = _writer->formats.find( key );
+			if( it == _writer->formats.end() )
+			{
+				it = _writer->formats.emplace( key, static_cast< uint32_t >( _writer->formats.size() ) ).first;
+
+				binary::write( _batch, binary::eFormat );
+				binary::write( _batch, it->second );
+				binary::write( _batch, static_cast< uint8_t >( _record.type ) );
+				binary::write( _batch, static_cast< uint8_t >( _record.category ) );
+				binary::write( _batch, static_cast< uint32_t >( _record.line ) );
+				binary::writeString( _batch, _record.function );
+				binary::writeString( _batch, std::string_view( _record.format.data(), _record.format.size() ) );
+			}
+
+			binary::write( _batch, binary::eEntry );
+			binary::write( _batch, it->second );
+			binary::write( _batch, _record.timestamp );
+			binary::write( _batch, _record.thread );
+			writeArguments( _batch, _record.arguments );
+		}
+
+		void write( sWriter* _writer, std::string& _batch, const sRecord& _record )
+		{
+			if( _writer->format == eBinary )
+			{
+				writeBinary( _writer, _batch, _record );
 
 #if defined( DEBUG ) || defined( PROFILING )
-		printConsole( _type, _function, _line, _message );
+				if( _writer->console )
+					printConsole( _record.type, _record.function, _record.line, fmt::vformat( _record.format, _record.arguments ) );
 #endif
+				return;
+			}
+
+			const std::string message = fmt::vformat( _record.format, _record.arguments );
+			_batch += formatFile( _record.type, _record.function, _record.line, message );
+
+#if defined( DEBUG ) || defined( PROFILING )
+			if( _writer->console )
+				printConsole( _record.type, _record.function, _record.line, message );
+#endif
+		}
+
+		void push( sWriter* _writer, sRecord&& _record )
+		{
+			++_writer->pushed;
+
+			while( !_writer->queue.push( std::move( _record ) ) )
+			{
+				if( _writer->overflow == eDrop )
+				{
+					--_writer->pushed;
+					++_writer->dropped;
+					return;
+				}
+
+				wake( _writer );
+				std::this_thread::yield();
+			}
+
+			wake( _writer );
+		}
+
+		void stop( sWriter* _writer )
+		{
+			_writer->running  = false;
+			_writer->sleeping = true;
+			wake( _writer );
+			_writer->thread.join();
+
+			if( _writer->file )
+				std::fclose( _writer->file );
+
+			delete _writer;
+		}
+
+		void run( sWriter* _writer )
+		{
+			ZoneScoped;
+
+			std::string batch;
+			sRecord     record;
+
+			while( true )
+			{
+				uint64_t count = 0;
+				while( _writer->queue.pop( record ) )
+				{
+					write( _writer, batch, record );
+					record.arguments.clear();
+
+					++count;
+				}
+
+				if( const uint64_t dropped = _writer->dropped.exchange( 0 ) )
+				{
+					sRecord notice{ eWarning, eGeneral, __FUNCTION__, __LINE__, "Dropped {} log messages", {}, getTimestamp(), s_thread_id };
+					notice.arguments.push_back( dropped );
+
+					write( _writer, batch, notice );
+				}
+
+				if( !batch.empty() && _writer->file )
+				{
+					std::fwrite( batch.data(), 1, batch.size(), _writer->file );
+					std::fflush( _writer->file );
+				}
+
+				batch.clear();
+				_writer->written += count;
+
+				if( count )
+					continue;
+
+				if( !_writer->running )
+					break;
+
+				const uint32_t signal = _writer->signal.load();
+				_writer->sleeping     = true;
+
+				if( _writer->written == _writer->pushed && _writer->running )
+					_writer->signal.wait( signal );
+
+				_writer->sleeping = false;
+			}
+		}
 	}
 
-	void printFile( const eType _type, const char* _function, const unsigned _line, const std::string& _message )
+	void initialize( const eOverflow _overflow, const size_t _capacity, const eFormat _format )
 	{
 		ZoneScoped;
 
-		std::string message = {};
+		if( s_writer )
+			return;
 
-		switch( _type )
+		sWriter* writer = new sWriter( _overflow, _capacity, _format );
+
+		if( _format == eBinary )
 		{
-			case eRaw:
-				message = "[  RAW  ];;";
-				break;
-			case eMessage:
-				message = "[MESSAGE];;";
-				break;
-			case eWarning:
-				message = "[WARNING];;";
-				break;
-			case eError:
-				message = "[ ERROR ];;";
-				break;
+			const std::string path = filesystem::getGameDirectory() + "binaries/log.bin";
+			writer->file           = std::fopen( path.data(), "wb" );
+
+			binary::sHeader header{ .magic = {}, .version = binary::s_version, .start_time = getTimestamp() };
+			std::memcpy( header.magic, binary::s_magic, sizeof( header.magic ) );
+
+			if( writer->file )
+				std::fwrite( &header, sizeof( header ), 1, writer->file );
+		}
+		else
+		{
+			const std::string path = filesystem::getGameDirectory() + "binaries/log.csv";
+			writer->file           = std::fopen( path.data(), "ab" );
+		}
+
+		writer->thread = std::thread( run, writer );
+		s_writer       = writer;
+	}
+
+	void deinitialize()
+	{
+		ZoneScoped;
+
+		sWriter* writer = s_writer.exchange( nullptr );
+		if( !writer )
+			return;
+
+		stop( writer );
+	}
+
+	void flush()
+	{
+		ZoneScoped;
+
+		sWriter* writer = s_writer;
+		if( !writer )
+			return;
+
+		while( writer->written < writer->pushed )
+		{
+			wake( writer );
+			std::this_thread::yield();
 		}
+	}
+
+	double benchmark( const uint32_t _threads, const uint32_t _messages )
+	{
+		ZoneScoped;
+
+		const sWriter* current = s_writer;
+
+		sWriter* writer = new sWriter( eBlock, 8192, current ? current->format : eText );
+		writer->file    = std::tmpfile();
+		writer->console = false;
+		writer->thread  = std::thread( run, writer );
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector< std::thread > threads;
+		for( uint32_t i = 0; i < _threads; ++i )
+		{
+			threads.emplace_back(
+				[ writer, i, _messages ]
+				{
+					for( uint32_t j = 0; j < _messages; ++j )
+					{
+						sRecord record{ eMessage, eGeneral, __FUNCTION__, __LINE__, "Benchmark thread {} message {}", {}, getTimestamp(), s_thread_id };
+						record.arguments.push_back( i );
+						record.arguments.push_back( j );
+
+						push( writer, std::move( record ) );
+					}
+				} );
+		}
+
+		for( std::thread& thread: threads )
+			thread.join();
+
+		while( writer->written < writer->pushed )
+		{
+			wake( writer );
+			std::this_thread::yield();
+		}
+
+		const std::chrono::duration< double > duration = std::chrono::steady_clock::now() - start;
+		const double                          rate     = static_cast< double >( _threads ) * _messages / duration.count();
+
+		stop( writer );
+
+		print( eMessage, eGeneral, __FUNCTION__, __LINE__, "Logged {} messages from {} threads at {:.0f} messages/sec", _threads * _messages, _threads, rate );
+		return rate;
+	}
+
+	void submit( const eType _type, const eCategory _category, const char* _function, const unsigned _line, const fmt::string_view _format, tArguments&& _arguments )
+	{
+		ZoneScoped;
+
+		sWriter* writer = s_writer;
+		if( !writer )
+		{
+			const std::string message = fmt::vformat( _format, _arguments );
+			printFile( _type, _function, _line, message );
+
+#if defined( DEBUG ) || defined( PROFILING )
+			printConsole( _type, _function, _line, message );
+#endif
+			return;
+		}
+
+		push( writer, sRecord{ _type, _category, _function, _line, _format, std::move( _arguments ), getTimestamp(), s_thread_id } );
+	}
+
+	void printFile( const eType _type, const char* _function, const unsigned _line, const std::string& _message )
+	{
+		ZoneScoped;
 
-		message += fmt::format( "{};;{};;{}\n", _function, _line, _message );
-		filesystem::write( "binaries/log.csv", message, std::ios::out | std::ios::app );
+		filesystem::write( "binaries/log.csv", formatFile( _type, _function, _line, _message ), std::ios::out | std::ios::app );
 	}
 
 	void printConsole( const eType _type, const char* _function, const unsigned _line, const std::string& _message )
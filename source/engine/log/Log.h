@@ -1,6 +1,21 @@
 ﻿#pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fmt/args.h>
+#include <fmt/format.h>
 #include <string>
+#include <string_view>
+#include <type_traits>
+
+#ifndef DF_LOG_LEVEL
+	#if defined( DEBUG ) || defined( PROFILING )
+		#define DF_LOG_LEVEL df::log::eMessage
+	#else
+		#define DF_LOG_LEVEL df::log::eWarning
+	#endif
+#endif
 
 namespace df::log
 {
@@ -12,12 +27,81 @@ namespace df::log
 		eError,
 	};
 
-	extern void print( eType _type, const char* _function, unsigned _line, const std::string& _message );
+	enum eCategory
+	{
+		eGeneral,
+		eAssets,
+		eRendering,
+		eFilesystem,
+
+		eCategoryCount,
+	};
+
+	enum eOverflow
+	{
+		eDrop,
+		eBlock,
+	};
+
+	enum eFormat
+	{
+		eText,
+		eBinary,
+	};
+
+	typedef fmt::dynamic_format_arg_store< fmt::format_context > tArguments;
+
+	inline std::array< std::atomic< eType >, eCategoryCount > s_levels = { eMessage, eMessage, eMessage, eMessage };
+
+	constexpr bool isCompiled( const eType _type ) { return _type == eRaw || _type >= DF_LOG_LEVEL; }
+	inline bool    isEnabled( const eType _type, const eCategory _category ) { return _type == eRaw || _type >= s_levels[ _category ].load( std::memory_order_relaxed ); }
+
+	inline void  setLevel( const eCategory _category, const eType _level ) { s_levels[ _category ] = _level; }
+	inline eType getLevel( const eCategory _category ) { return s_levels[ _category ]; }
+
+	extern void initialize( eOverflow _overflow = eBlock, size_t _capacity = 8192, eFormat _format = eText );
+	extern void deinitialize();
+	extern void flush();
+
+	extern double benchmark( uint32_t _threads, uint32_t _messages );
+
+	extern void submit( eType _type, eCategory _category, const char* _function, unsigned _line, fmt::string_view _format, tArguments&& _arguments );
+
+	template< typename T >
+	void capture( tArguments& _arguments, T&& _argument )
+	{
+		if constexpr( std::is_convertible_v< const std::remove_cvref_t< T >&, std::string_view > )
+			_arguments.push_back( std::string( std::string_view( _argument ) ) );
+		else
+			_arguments.push_back( std::forward< T >( _argument ) );
+	}
+
+	template< typename... Targs >
+	void print( const eType _type, const eCategory _category, const char* _function, const unsigned _line, fmt::format_string< Targs... > _format, Targs&&... _args )
+	{
+		tArguments arguments;
+		arguments.reserve( sizeof...( Targs ), 0 );
+		( capture( arguments, std::forward< Targs >( _args ) ), ... );
+
+		submit( _type, _category, _function, _line, fmt::string_view( _format ), std::move( arguments ) );
+	}
+
 	extern void printFile( eType _type, const char* _function, unsigned _line, const std::string& _message );
 	extern void printConsole( eType _type, const char* _function, unsigned _line, const std::string& _message );
 }
 
-#define DF_LOG_RAW( ... )     df::log::print( df::log::eType::eRaw, __FUNCTION__, __LINE__, std::string( __VA_ARGS__ ) )
-#define DF_LOG_MESSAGE( ... ) df::log::print( df::log::eType::eMessage, __FUNCTION__, __LINE__, std::string( __VA_ARGS__ ) )
-#define DF_LOG_WARNING( ... ) df::log::print( df::log::eType::eWarning, __FUNCTION__, __LINE__, std::string( __VA_ARGS__ ) )
-#define DF_LOG_ERROR( ... )   df::log::print( df::log::eType::eError, __FUNCTION__, __LINE__, std::string( __VA_ARGS__ ) )
\ No newline at end of file
+#define DF_LOG( type, category, ... )                                                  \
+	do                                                                                 \
+	{                                                                                  \
+		if constexpr( df::log::isCompiled( type ) )                                    \
+		{                                                                              \
+			if( df::log::isEnabled( type, category ) )                                 \
+				df::log::print( type, category, __FUNCTION__, __LINE__, __VA_ARGS__ ); \
+		}                                                                              \
+	}                                                                                  \
+	while( false )
+
+#define DF_LOG_RAW( ... )     DF_LOG( df::log::eRaw, df::log::eGeneral, __VA_ARGS__ )
+#define DF_LOG_MESSAGE( ... ) DF_LOG( df::log::eMessage, df::log::eGeneral, __VA_ARGS__ )
+#define DF_LOG_WARNING( ... ) DF_LOG( df::log::eWarning, df::log::eGeneral, __VA_ARGS__ )
+#define DF_LOG_ERROR( ... )   DF_LOG( df::log::eError, df::log::eGeneral, __VA_ARGS__ )
@@ -1,12 +1,25 @@
 ﻿#include "cModelManager.h"
 
+#include "cCameraManager.h"
+#include "engine/filesystem/cFileSystem.h"
+#include "engine/misc/cBoundingVolumeHierarchy.h"
+#include "engine/misc/sFrustum.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
+#include "engine/rendering/assets/iMesh.h"
+#include "engine/rendering/assets/iTexture.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/opengl/assets/cModel_opengl.h"
+#include "engine/rendering/vulkan/assets/cMesh_vulkan.h"
 #include "engine/rendering/vulkan/assets/cModel_vulkan.h"
+#include "engine/rendering/vulkan/cGpuCulling_vulkan.h"
+#include "engine/rendering/vulkan/cRenderer_vulkan.h"
 
 namespace df
 {
 	cModelManager::cModelManager()
+		: m_bvh( new cBoundingVolumeHierarchy )
+		, m_gpu_culling( nullptr )
+		, m_cpu_items( 0 )
 	{
 		ZoneScoped;
 
@@ -20,6 +33,7 @@ namespace df
 			case cRenderer::eVulkan:
 			{
 				m_default_render_callback = vulkan::cModel_vulkan::createDefaults();
+				m_gpu_culling             = reinterpret_cast< vulkan::cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getGpuCulling();
 				break;
 			}
 		}
@@ -29,6 +43,8 @@ namespace df
 	{
 		ZoneScoped;
 
+		clear();
+
 		switch( cRenderer::getInstanceType() )
 		{
 			case cRenderer::eOpenGL:
@@ -39,6 +55,8 @@ namespace df
 				break;
 			}
 		}
+
+		delete m_bvh;
 	}
 
 	iModel* cModelManager::load( const std::string& _name, const std::string& _folder_path, const unsigned _load_flags )
@@ -61,8 +79,180 @@ namespace df
 		}
 
 		if( model )
+		{
 			model->load( _folder_path, _load_flags );
+			getInstance()->addModel( model );
+		}
 
 		return model;
 	}
+
+	bool cModelManager::reload( const std::string& _file_path )
+	{
+		ZoneScoped;
+
+		bool reloaded = false;
+		for( iAsset* asset: getInstance()->m_assets | std::views::values )
+		{
+			iModel* model = reinterpret_cast< iModel* >( asset );
+
+			bool texture_reloaded = false;
+			for( iTexture* texture: model->textures | std::views::values )
+			{
+				if( texture && !texture->getFilePath().empty() && filesystem::equivalent( texture->getFilePath(), _file_path ) )
+					texture_reloaded |= texture->reload();
+			}
+
+			if( texture_reloaded )
+			{
+				DF_LOG_MESSAGE( "Reloaded texture: {} in model: {}", _file_path, model->name );
+				reloaded = true;
+				continue;
+			}
+
+			if( filesystem::isInside( _file_path, model->folder ) )
+			{
+				getInstance()->removeModel( model );
+				reloaded |= model->reload();
+				getInstance()->addModel( model );
+			}
+		}
+
+		return reloaded;
+	}
+
+	void cModelManager::render()
+	{
+		ZoneScoped;
+
+		cModelManager* manager = getInstance();
+		manager->refit();
+
+		const cCamera* camera = cCameraManager::getInstance()->current;
+		if( !camera )
+		{
+			iAssetManager::render();
+			return;
+		}
+
+		const bool gpu_driven = manager->m_gpu_culling && !getForcedRenderCallback() && manager->m_gpu_culling->render( camera );
+		if( gpu_driven && !manager->m_cpu_items )
+			return;
+
+		manager->m_visible.clear();
+		manager->m_bvh->query( sFrustum( camera->view_projection ), manager->m_visible );
+
+		for( const uint32_t item: manager->m_visible )
+		{
+			if( gpu_driven && manager->m_items[ item ].gpu_driven )
+				continue;
+
+			manager->m_items[ item ].model->renderMesh( manager->m_items[ item ].mesh );
+		}
+	}
+
+	void cModelManager::refitBounds()
+	{
+		ZoneScoped;
+
+		getInstance()->refit();
+	}
+
+	iMesh* cModelManager::pick( const glm::vec3& _origin, const glm::vec3& _direction, float* _distance )
+	{
+		ZoneScoped;
+
+		cModelManager* manager = getInstance();
+		manager->refit();
+
+		uint32_t item;
+		float    distance;
+		if( !manager->m_bvh->raycast( _origin, _direction, item, distance ) )
+			return nullptr;
+
+		if( _distance )
+			*_distance = distance;
+
+		return manager->m_items[ item ].mesh;
+	}
+
+	void cModelManager::onDestroy( iModel* _model )
+	{
+		ZoneScoped;
+
+		getInstance()->removeModel( _model );
+	}
+
+	void cModelManager::addModel( iModel* _model )
+	{
+		ZoneScoped;
+
+		for( iMesh* mesh: _model->meshes )
+		{
+			if( !mesh->getBounds().isValid() )
+				continue;
+
+			const cTransformSystem::tHandle handle = mesh->transform->getHandle();
+			const uint32_t                  item   = m_bvh->insert( mesh->getBounds().transform( mesh->transform->getWorld() ) );
+
+			if( item >= m_items.size() )
+				m_items.resize( item + 1 );
+
+			const bool gpu_driven = m_gpu_culling && !_model->render_callback && !mesh->render_callback;
+
+			m_items[ item ]             = { _model, mesh, cTransformSystem::getVersion( handle ), gpu_driven };
+			m_transform_items[ handle ] = item;
+
+			if( gpu_driven )
+				m_gpu_culling->set( item, static_cast< vulkan::cMesh_vulkan* >( mesh ) );
+			else
+				m_cpu_items++;
+		}
+	}
+
+	void cModelManager::removeModel( const iModel* _model )
+	{
+		ZoneScoped;
+
+		for( const iMesh* mesh: _model->meshes )
+		{
+			const auto it = m_transform_items.find( mesh->transform->getHandle() );
+			if( it == m_transform_items.end() )
+				continue;
+
+			if( m_items[ it->second ].gpu_driven )
+				m_gpu_culling->remove( it->second );
+			else
+				m_cpu_items--;
+
+			m_bvh->remove( it->second );
+			m_items[ it->second ] = {};
+			m_transform_items.erase( it );
+		}
+	}
+
+	void cModelManager::refit()
+	{
+		ZoneScoped;
+
+		for( const cTransformSystem::tHandle handle: cTransformSystem::getChanged() )
+		{
+			const auto it = m_transform_items.find( handle );
+			if( it == m_transform_items.end() )
+				continue;
+
+			sMeshItem&     item    = m_items[ it->second ];
+			const uint32_t version = cTransformSystem::getVersion( handle );
+			if( item.version == version )
+				continue;
+
+			item.version = version;
+			m_bvh->update( it->second, item.mesh->getBounds().transform( item.mesh->transform->getWorld() ) );
+
+			if( item.gpu_driven )
+				m_gpu_culling->set( it->second, static_cast< vulkan::cMesh_vulkan* >( item.mesh ) );
+		}
+
+		m_bvh->refit();
+	}
 }
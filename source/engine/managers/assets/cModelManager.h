@@ -1,12 +1,27 @@
 ﻿#pragma once
 
+#include <glm/vec3.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "engine/misc/cTransformSystem.h"
 #include "engine/rendering/assets/iModel.h"
 #include "iAssetManager.h"
 
 namespace df
 {
+	class iMesh;
+	class cBoundingVolumeHierarchy;
+
+	namespace vulkan
+	{
+		class cGpuCulling_vulkan;
+	}
+
 	class cModelManager final : public iAssetManager< cModelManager, iModel >
 	{
+		friend iAssetManager;
+
 	public:
 		DF_DISABLE_COPY_AND_MOVE( cModelManager )
 
@@ -14,5 +29,34 @@ namespace df
 		~cModelManager() override;
 
 		static iModel* load( const std::string& _name, const std::string& _folder_path, unsigned _load_flags = aiProcess_Triangulate );
+		static bool    reload( const std::string& _file_path );
+
+		static void   render();
+		static void   refitBounds();
+		static iMesh* pick( const glm::vec3& _origin, const glm::vec3& _direction, float* _distance = nullptr );
+
+		static cBoundingVolumeHierarchy* getBoundingVolumeHierarchy() { return getInstance()->m_bvh; }
+
+	private:
+		struct sMeshItem
+		{
+			iModel*  model;
+			iMesh*   mesh;
+			uint32_t version;
+			bool     gpu_driven;
+		};
+
+		static void onDestroy( iModel* _model );
+
+		void addModel( iModel* _model );
+		void removeModel( const iModel* _model );
+		void refit();
+
+		cBoundingVolumeHierarchy*                                 m_bvh;
+		vulkan::cGpuCulling_vulkan*                               m_gpu_culling;
+		std::vector< sMeshItem >                                  m_items;
+		std::unordered_map< cTransformSystem::tHandle, uint32_t > m_transform_items;
+		std::vector< uint32_t >                                   m_visible;
+		uint32_t                                                  m_cpu_items;
 	};
 }
@@ -1,5 +1,7 @@
 ﻿#include "cQuadManager.h"
 
+#include "engine/filesystem/cFileSystem.h"
+#include "engine/rendering/assets/iTexture.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/opengl/assets/cQuad_opengl.h"
 #include "engine/rendering/vulkan/assets/cQuad_vulkan.h"
@@ -55,4 +57,26 @@ namespace df
 
 		return nullptr;
 	}
+
+	bool cQuadManager::reload( const std::string& _file_path )
+	{
+		ZoneScoped;
+
+		bool reloaded = false;
+		for( iAsset* asset: getInstance()->m_assets | std::views::values )
+		{
+			const iQuad* quad = reinterpret_cast< iQuad* >( asset );
+
+			if( !quad->texture || quad->texture->getFilePath().empty() || !filesystem::equivalent( quad->texture->getFilePath(), _file_path ) )
+				continue;
+
+			if( quad->texture->reload() )
+			{
+				DF_LOG_MESSAGE( "Reloaded texture: {} in quad: {}", _file_path, quad->name );
+				reloaded = true;
+			}
+		}
+
+		return reloaded;
+	}
 }
@@ -14,5 +14,6 @@ namespace df
 		~cQuadManager() override;
 
 		static iQuad* load( const std::string& _name, const glm::vec3& _position, const glm::vec2& _size, const cColor& _color = color::white );
+		static bool   reload( const std::string& _file_path );
 	};
 }
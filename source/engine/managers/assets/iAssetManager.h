@@ -39,6 +39,8 @@ namespace df
 		static iRenderCallback* getForcedRenderCallback() { return iAssetManager::getInstance()->m_forced_render_callback; }
 
 	protected:
+		static void onDestroy( Tasset* /*_asset*/ ) {}
+
 		std::unordered_map< std::string, iAsset* > m_assets;
 		iRenderCallback*                           m_default_render_callback;
 		iRenderCallback*                           m_forced_render_callback;
@@ -68,14 +70,14 @@ namespace df
 
 		if( assets.contains( _name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Asset already exist: {}", _name ) );
+			DF_LOG( df::log::eWarning, df::log::eAssets, "Asset already exist: {}", _name );
 			return nullptr;
 		}
 
 		Ttype* asset    = new Ttype( _name, _args... );
 		assets[ _name ] = asset;
 
-		DF_LOG_MESSAGE( fmt::format( "Created asset: {}", _name ) );
+		DF_LOG( df::log::eMessage, df::log::eAssets, "Created asset: {}", _name );
 		return asset;
 	}
 
@@ -88,13 +90,13 @@ namespace df
 
 		if( assets.contains( _asset->name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Asset already exist: {}", _asset->name ) );
+			DF_LOG( df::log::eWarning, df::log::eAssets, "Asset already exist: {}", _asset->name );
 			return false;
 		}
 
 		assets[ _asset->name ] = _asset;
 
-		DF_LOG_MESSAGE( fmt::format( "Added Asset: {}", _asset->name ) );
+		DF_LOG( df::log::eMessage, df::log::eAssets, "Added Asset: {}", _asset->name );
 		return true;
 	}
 
@@ -130,13 +132,14 @@ namespace df
 		const auto it = assets.find( _name );
 		if( it == assets.end() )
 		{
-			DF_LOG_WARNING( fmt::format( "Asset doesn't exist: {}", _name ) );
+			DF_LOG( df::log::eWarning, df::log::eAssets, "Asset doesn't exist: {}", _name );
 			return false;
 		}
 
+		T::onDestroy( reinterpret_cast< Tasset* >( it->second ) );
 		delete it->second;
 		assets.erase( it );
-		DF_LOG_MESSAGE( fmt::format( "Destroyed asset: {}", _name ) );
+		DF_LOG( df::log::eMessage, df::log::eAssets, "Destroyed asset: {}", _name );
 
 		return true;
 	}
@@ -155,14 +158,15 @@ namespace df
 		{
 			if( asset.second == _asset )
 			{
-				DF_LOG_MESSAGE( fmt::format( "Destroyed asset: {}", asset.first ) );
+				DF_LOG( df::log::eMessage, df::log::eAssets, "Destroyed asset: {}", asset.first );
+				T::onDestroy( reinterpret_cast< Tasset* >( asset.second ) );
 				delete asset.second;
 				assets.erase( asset.first );
 				return true;
 			}
 		}
 
-		DF_LOG_WARNING( fmt::format( "Asset isn't managed: {}", _asset->name ) );
+		DF_LOG( df::log::eWarning, df::log::eAssets, "Asset isn't managed: {}", _asset->name );
 		return false;
 	}
 
@@ -175,7 +179,8 @@ namespace df
 
 		for( std::pair< const std::string, iAsset* >& asset: assets )
 		{
-			DF_LOG_MESSAGE( fmt::format( "Destroyed asset: {}", asset.first ) );
+			DF_LOG( df::log::eMessage, df::log::eAssets, "Destroyed asset: {}", asset.first );
+			T::onDestroy( reinterpret_cast< Tasset* >( asset.second ) );
 			delete asset.second;
 		}
 
@@ -192,7 +197,7 @@ namespace df
 		const auto it = assets.find( _name );
 		if( it == assets.end() )
 		{
-			DF_LOG_WARNING( fmt::format( "Asset doesn't exist: {}", _name ) );
+			DF_LOG( df::log::eWarning, df::log::eAssets, "Asset doesn't exist: {}", _name );
 			return nullptr;
 		}
 
@@ -0,0 +1,90 @@
+﻿#include "cEntityManager.h"
+
+#include <chrono>
+#include <tracy/Tracy.hpp>
+
+#include "engine/ecs/Components.h"
+#include "engine/ecs/cWorld.h"
+#include "engine/ecs/Systems.h"
+#include "engine/log/Log.h"
+#include "engine/misc/cTransformSystem.h"
+
+namespace df
+{
+	cEntityManager::cEntityManager()
+		: m_world( new ecs::cWorld )
+	{
+		ZoneScoped;
+
+		ecs::addDefaultSystems( *m_world );
+	}
+
+	cEntityManager::~cEntityManager()
+	{
+		ZoneScoped;
+
+		delete m_world;
+	}
+
+	void cEntityManager::update( const float _delta_time )
+	{
+		ZoneScoped;
+
+		getInstance()->m_world->run( ecs::cWorld::eUpdate, _delta_time );
+	}
+
+	void cEntityManager::render()
+	{
+		ZoneScoped;
+
+		getInstance()->m_world->run( ecs::cWorld::eRender, 0 );
+	}
+
+	double cEntityManager::benchmark( const uint32_t _count, const uint32_t _frames )
+	{
+		ZoneScoped;
+
+		ecs::cWorld world;
+		ecs::addDefaultSystems( world );
+
+		std::vector< cTransformSystem::tHandle > handles( _count );
+		for( uint32_t i = 0; i < _count; ++i )
+		{
+			handles[ i ] = cTransformSystem::create();
+			cTransformSystem::setTranslation( handles[ i ], glm::vec3( static_cast< float >( i ), 0, 0 ) );
+
+			const ecs::sTransform transform{ .handle = handles[ i ] };
+
+			if( i % 3 == 0 )
+				world.create( transform );
+			else if( i % 3 == 1 )
+				world.create( transform, ecs::sLight{} );
+			else
+				world.create( transform, ecs::sVoxelChunk{ .coordinate = glm::ivec3( static_cast< int >( i ), 0, 0 ) } );
+		}
+
+		world.run( ecs::cWorld::eUpdate, 0 );
+		cTransformSystem::update();
+
+		const auto start = std::chrono::steady_clock::now();
+		for( uint32_t frame = 0; frame < _frames; ++frame )
+		{
+			const glm::quat rotation = angleAxis( static_cast< float >( frame ) * .01f, glm::vec3( 0, 1, 0 ) );
+			world.each< const ecs::sTransform >( [ & ]( const ecs::sTransform& _transform ) { cTransformSystem::setRotation( _transform.handle, rotation ); } );
+
+			world.run( ecs::cWorld::eUpdate, 0 );
+			cTransformSystem::update();
+		}
+
+		const std::chrono::duration< double, std::micro > duration = ( std::chrono::steady_clock::now() - start ) / _frames;
+
+		for( const cTransformSystem::tHandle handle: handles )
+			cTransformSystem::destroy( handle );
+
+		cTransformSystem::update();
+
+		DF_LOG_MESSAGE( "Updated {} entities in {} archetypes in {:.1f} us/frame", world.getCount(), world.getArchetypeCount(), duration.count() );
+
+		return duration.count();
+	}
+}
@@ -0,0 +1,32 @@
+﻿#pragma once
+
+#include <cstdint>
+
+#include "engine/misc/iSingleton.h"
+
+namespace df
+{
+	namespace ecs
+	{
+		class cWorld;
+	}
+
+	class cEntityManager final : public iSingleton< cEntityManager >
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cEntityManager );
+
+		cEntityManager();
+		~cEntityManager() override;
+
+		static void update( float _delta_time );
+		static void render();
+
+		static ecs::cWorld* getWorld() { return getInstance()->m_world; }
+
+		static double benchmark( uint32_t _count = 100000, uint32_t _frames = 10 );
+
+	private:
+		ecs::cWorld* m_world;
+	};
+}
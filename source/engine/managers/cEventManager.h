@@ -1,22 +1,53 @@
 ﻿#pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
 #include <ranges>
-#include <string>
-#include <unordered_map>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "engine/events/cEvent.h"
+#include "engine/input/Input.h"
 #include "engine/misc/iSingleton.h"
 
+#define DF_EVENT( _name, ... )                                               \
+	struct _name##_t                                                         \
+	{                                                                        \
+		using tEvent = df::cEvent< __VA_ARGS__ >;                            \
+                                                                             \
+		static constexpr std::string_view name = #_name;                     \
+		static constexpr uint32_t         id   = df::event::hash( #_name ); \
+	};                                                                       \
+	inline constexpr _name##_t _name
+
 namespace df
 {
 	namespace event
 	{
-		static std::string input            = "input";
-		static std::string update           = "update";
-		static std::string render_3d        = "render_3d";
-		static std::string render_2d        = "render_2d";
-		static std::string imgui            = "imgui";
-		static std::string on_window_resize = "on_window_resize";
+		constexpr uint32_t hash( const std::string_view _name )
+		{
+			uint32_t hash = 2166136261u;
+			for( const char character: _name )
+			{
+				hash ^= static_cast< uint8_t >( character );
+				hash *= 16777619u;
+			}
+
+			return hash;
+		}
+
+		DF_EVENT( input, const df::input::sInput& );
+		DF_EVENT( update, float );
+		DF_EVENT( render_3d );
+		DF_EVENT( render_2d );
+		DF_EVENT( imgui );
+		DF_EVENT( on_window_resize, int, int );
 	}
 
 	class cEventManager final : public iSingleton< cEventManager >
@@ -27,79 +58,169 @@ namespace df
 		cEventManager() = default;
 		~cEventManager() override;
 
-		template< typename T, typename... Targs >
-		static void subscribe( const std::string& _name, T* _object, void ( T::*_function )( Targs... ) );
-		template< typename T, typename... Targs >
-		static void subscribe( const std::string& _name, T* _object, void ( *_function )( Targs... ) );
+		template< typename Tevent, typename T, typename... Targs >
+		static void subscribe( const Tevent& _event, T* _object, void ( T::*_function )( Targs... ), iEvent::eDispatch _dispatch = iEvent::eCaller );
+		template< typename Tevent, typename T, typename... Targs >
+		static void subscribe( const Tevent& _event, T* _object, void ( *_function )( Targs... ), iEvent::eDispatch _dispatch = iEvent::eCaller );
 
-		template< typename T >
-		static void unsubscribe( const std::string& _name, T* _object );
+		template< typename Tevent, typename T >
+		static void unsubscribe( const Tevent& _event, T* _object );
 
-		template< typename... Targs >
-		static void invoke( const std::string& _name, Targs... _args );
+		template< typename Tevent, typename... Targs >
+		static void invoke( const Tevent& _event, Targs&&... _args );
+
+		template< typename Tevent, typename... Targs >
+		static void queue( const Tevent& _event, Targs&&... _args );
+		static void dispatchQueued();
 
 	private:
-		std::unordered_map< std::string, iEvent* > m_events;
+		struct sQueuedEvent
+		{
+			uint32_t id;
+			uint32_t size;
+			void     ( *dispatch )( const std::byte* _payload );
+		};
+
+		template< typename Tevent >
+		static typename Tevent::tEvent* getEvent();
+
+		template< typename Tevent >
+		static void dispatchPayload( const std::byte* _payload );
+
+		static constexpr uint32_t s_max_events = 256;
+
+		inline static std::atomic< uint32_t > s_event_count = 0;
+
+		std::array< std::atomic< iEvent* >, s_max_events > m_events = {};
+
+		std::mutex                                   m_queue_mutex;
+		std::vector< std::byte >                     m_queue;
+		std::vector< std::byte >                     m_dispatching;
+		std::vector< std::pair< uint32_t, size_t > > m_batch;
 	};
 
 	inline cEventManager::~cEventManager()
 	{
 		ZoneScoped;
 
-		for( const iEvent* event: m_events | std::ranges::views::values )
-			delete event;
+		for( const std::atomic< iEvent* >& event: m_events )
+			delete event.load();
 	}
 
-	template< typename T, typename... Targs >
-	void cEventManager::subscribe( const std::string& _name, T* _object, void ( T::*_function )( Targs... ) )
+	template< typename Tevent, typename T, typename... Targs >
+	void cEventManager::subscribe( const Tevent& /*_event*/, T* _object, void ( T::*_function )( Targs... ), const iEvent::eDispatch _dispatch )
 	{
 		ZoneScoped;
 
-		auto event = reinterpret_cast< cEvent< Targs... >* >( getInstance()->m_events[ _name ] );
+		getEvent< Tevent >()->subscribe( _object, _function, _dispatch );
+	}
 
-		if( !event )
-		{
-			event                            = new cEvent< Targs... >;
-			getInstance()->m_events[ _name ] = event;
-		}
+	template< typename Tevent, typename T, typename... Targs >
+	void cEventManager::subscribe( const Tevent& /*_event*/, T* _object, void ( *_function )( Targs... ), const iEvent::eDispatch _dispatch )
+	{
+		ZoneScoped;
 
-		event->subscribe( _object, _function );
+		getEvent< Tevent >()->subscribe( _object, _function, _dispatch );
 	}
 
-	template< typename T, typename... Targs >
-	void cEventManager::subscribe( const std::string& _name, T* _object, void ( *_function )( Targs... ) )
+	template< typename Tevent, typename T >
+	void cEventManager::unsubscribe( const Tevent& /*_event*/, T* _object )
 	{
 		ZoneScoped;
 
-		auto event = reinterpret_cast< cEvent< Targs... >* >( getInstance()->m_events[ _name ] );
+		getEvent< Tevent >()->unsubscribe( _object );
+	}
 
-		if( !event )
-		{
-			event                            = new cEvent< Targs... >();
-			getInstance()->m_events[ _name ] = event;
-		}
+	template< typename Tevent, typename... Targs >
+	void cEventManager::invoke( const Tevent& /*_event*/, Targs&&... _args )
+	{
+		ZoneScoped;
 
-		event->subscribe( _object, _function );
+		getEvent< Tevent >()->invoke( std::forward< Targs >( _args )... );
 	}
 
-	template< typename T >
-	void cEventManager::unsubscribe( const std::string& _name, T* _object )
+	template< typename Tevent, typename... Targs >
+	void cEventManager::queue( const Tevent& /*_event*/, Targs&&... _args )
 	{
 		ZoneScoped;
 
-		const auto event = getInstance()->m_events[ _name ];
+		using tEvent = typename Tevent::tEvent;
+		static_assert( tEvent::s_queueable, "Queued events must be trivially copyable" );
+
+		const sQueuedEvent header{ .id = Tevent::id, .size = static_cast< uint32_t >( tEvent::s_payload_size ), .dispatch = &dispatchPayload< Tevent > };
+
+		cEventManager*  event_manager = getInstance();
+		std::lock_guard lock( event_manager->m_queue_mutex );
 
-		if( event )
-			event->unsubscribe( _object );
+		const size_t offset = event_manager->m_queue.size();
+		event_manager->m_queue.resize( offset + sizeof( header ) + tEvent::s_payload_size );
+
+		std::memcpy( event_manager->m_queue.data() + offset, &header, sizeof( header ) );
+		tEvent::write( event_manager->m_queue.data() + offset + sizeof( header ), std::forward< Targs >( _args )... );
 	}
 
-	template< typename... Targs >
-	void cEventManager::invoke( const std::string& _name, Targs... _args )
+	inline void cEventManager::dispatchQueued()
 	{
 		ZoneScoped;
 
-		auto event = reinterpret_cast< cEvent< Targs... >* >( getInstance()->m_events[ _name ] );
-		if( event )
-			event->invoke( _args... );
+		cEventManager* event_manager = getInstance();
+		{
+			std::lock_guard lock( event_manager->m_queue_mutex );
+			event_manager->m_queue.swap( event_manager->m_dispatching );
+		}
+
+		const std::vector< std::byte >& buffer = event_manager->m_dispatching;
+		if( buffer.empty() )
+			return;
+
+		std::vector< std::pair< uint32_t, size_t > >& batch = event_manager->m_batch;
+		for( size_t offset = 0; offset < buffer.size(); )
+		{
+			sQueuedEvent header;
+			std::memcpy( &header, buffer.data() + offset, sizeof( header ) );
+
+			batch.emplace_back( header.id, offset );
+			offset += sizeof( header ) + header.size;
+		}
+
+		std::ranges::stable_sort( batch, {}, &std::pair< uint32_t, size_t >::first );
+
+		for( const size_t offset: batch | std::views::values )
+		{
+			sQueuedEvent header;
+			std::memcpy( &header, buffer.data() + offset, sizeof( header ) );
+
+			header.dispatch( buffer.data() + offset + sizeof( header ) );
+		}
+
+		batch.clear();
+		event_manager->m_dispatching.clear();
+	}
+
+	template< typename Tevent >
+	typename Tevent::tEvent* cEventManager::getEvent()
+	{
+		static const uint32_t index = s_event_count++;
+		_ASSERT( index < s_max_events );
+
+		std::atomic< iEvent* >& slot  = getInstance()->m_events[ index ];
+		iEvent*                 event = slot.load( std::memory_order_acquire );
+
+		if( !event )
+		{
+			iEvent* created = new typename Tevent::tEvent;
+			if( slot.compare_exchange_strong( event, created, std::memory_order_acq_rel ) )
+				event = created;
+			else
+				delete created;
+		}
+
+		return static_cast< typename Tevent::tEvent* >( event );
+	}
+
+	template< typename Tevent >
+	void cEventManager::dispatchPayload( const std::byte* _payload )
+	{
+		getEvent< Tevent >()->invokePayload( _payload );
 	}
 }
@@ -0,0 +1,77 @@
+﻿#include "cHotReloadManager.h"
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <tracy/Tracy.hpp>
+
+#include "assets/cModelManager.h"
+#include "assets/cQuadManager.h"
+#include "cRenderCallbackManager.h"
+#include "engine/filesystem/cFileSystem.h"
+#include "engine/filesystem/cFileWatcher.h"
+#include "engine/log/Log.h"
+
+namespace df
+{
+	cHotReloadManager::cHotReloadManager()
+	{
+		ZoneScoped;
+
+		m_file_watcher = new cFileWatcher( {
+			filesystem::getGameDirectory() + "data",
+			filesystem::getGameDirectory() + "binaries/shaders",
+		} );
+	}
+
+	cHotReloadManager::~cHotReloadManager()
+	{
+		ZoneScoped;
+
+		delete m_file_watcher;
+	}
+
+	void cHotReloadManager::update()
+	{
+		ZoneScoped;
+
+		cFileWatcher* file_watcher = getInstance()->m_file_watcher;
+		if( !file_watcher->isWatching() )
+			return;
+
+		for( const std::string& file_path: file_watcher->getChangedFiles() )
+			reload( file_path );
+	}
+
+	void cHotReloadManager::reload( const std::string& _file_path )
+	{
+		ZoneScoped;
+
+		std::error_code error;
+		if( !std::filesystem::exists( _file_path, error ) )
+		{
+			filesystem::removeFromIndex( _file_path );
+			DF_LOG_MESSAGE( "Removed file from index: {}", _file_path );
+			return;
+		}
+
+		filesystem::addToIndex( _file_path );
+
+		if( filesystem::isInside( _file_path, filesystem::getGameDirectory() + "binaries/shaders" ) )
+		{
+			std::filesystem::path shader = std::filesystem::path( _file_path ).filename();
+			if( shader.extension() == ".spv" )
+				shader.replace_extension();
+
+			if( !cRenderCallbackManager::reloadShader( shader.string() ) )
+				DF_LOG_MESSAGE( "Changed shader isn't used: {}", _file_path );
+
+			return;
+		}
+
+		const bool reloaded_model = cModelManager::reload( _file_path );
+		const bool reloaded_quad  = cQuadManager::reload( _file_path );
+
+		if( !reloaded_model && !reloaded_quad )
+			DF_LOG_MESSAGE( "Changed file isn't used: {}", _file_path );
+	}
+}
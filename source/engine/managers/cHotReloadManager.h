@@ -0,0 +1,26 @@
+﻿#pragma once
+
+#include <string>
+
+#include "engine/misc/iSingleton.h"
+
+namespace df
+{
+	class cFileWatcher;
+
+	class cHotReloadManager final : public iSingleton< cHotReloadManager >
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cHotReloadManager );
+
+		cHotReloadManager();
+		~cHotReloadManager() override;
+
+		static void update();
+
+	private:
+		static void reload( const std::string& _file_path );
+
+		cFileWatcher* m_file_watcher;
+	};
+}
@@ -0,0 +1,52 @@
+﻿#include "cJobManager.h"
+
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+#include "engine/misc/cThreadPool.h"
+
+namespace df
+{
+	cJobManager::cJobManager( const uint32_t _thread_count )
+		: m_pool( new cThreadPool( _thread_count ) )
+	{
+		ZoneScoped;
+
+		DF_LOG_MESSAGE( "Initialized job manager with {} threads", m_pool->getThreadCount() );
+	}
+
+	cJobManager::~cJobManager()
+	{
+		ZoneScoped;
+
+		delete m_pool;
+	}
+
+	void cJobManager::submit( std::function< void() > _job )
+	{
+		ZoneScoped;
+
+		getInstance()->m_pool->submit( std::move( _job ) );
+	}
+
+	void cJobManager::parallelFor( const size_t _count, const size_t _chunk_size, const std::function< void( size_t _begin, size_t _end ) >& _function )
+	{
+		ZoneScoped;
+
+		getInstance()->m_pool->parallelFor( _count, _chunk_size, _function );
+	}
+
+	void cJobManager::wait()
+	{
+		ZoneScoped;
+
+		getInstance()->m_pool->wait();
+	}
+
+	uint32_t cJobManager::getThreadCount()
+	{
+		ZoneScoped;
+
+		return getInstance()->m_pool->getThreadCount();
+	}
+}
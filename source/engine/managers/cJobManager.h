@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "engine/misc/iSingleton.h"
+
+namespace df
+{
+	class cThreadPool;
+
+	class cJobManager final : public iSingleton< cJobManager >
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cJobManager );
+
+		explicit cJobManager( uint32_t _thread_count = 0 );
+		~cJobManager() override;
+
+		static void submit( std::function< void() > _job );
+		static void parallelFor( size_t _count, size_t _chunk_size, const std::function< void( size_t _begin, size_t _end ) >& _function );
+		static void wait();
+
+		static uint32_t getThreadCount();
+
+	private:
+		cThreadPool* m_pool;
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <ranges>
 
 #include "engine/misc/iSingleton.h"
 #include "engine/rendering/cRenderCallback.h"
@@ -35,6 +36,8 @@ namespace df
 		static bool destroy( const iRenderCallback* _callback );
 		static void clear();
 
+		static bool reloadShader( const std::string& _shader_name );
+
 		template< typename T, typename... Targs >
 		static void render( const std::string& _name, Targs... _args );
 		template< typename T, typename... Targs >
@@ -61,14 +64,14 @@ namespace df
 
 		if( render_callbacks.contains( _shader_name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback already exist: {}", _shader_name ) );
+			DF_LOG_WARNING( "Callback already exist: {}", _shader_name );
 			return nullptr;
 		}
 
 		cRenderCallback< T, Targs... >* callback = new cRenderCallback< T, Targs... >( _shader_name, _shader_name, _callback );
 		render_callbacks[ _shader_name ]         = callback;
 
-		DF_LOG_MESSAGE( fmt::format( "Created callback: {}", _shader_name ) );
+		DF_LOG_MESSAGE( "Created callback: {}", _shader_name );
 		return callback;
 	}
 
@@ -83,14 +86,14 @@ namespace df
 
 		if( render_callbacks.contains( _callback_name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback already exist: {}", _callback_name ) );
+			DF_LOG_WARNING( "Callback already exist: {}", _callback_name );
 			return nullptr;
 		}
 
 		cRenderCallback< T, Targs... >* callback = new cRenderCallback< T, Targs... >( _callback_name, _shader_names, _callback );
 		render_callbacks[ _callback_name ]       = callback;
 
-		DF_LOG_MESSAGE( fmt::format( "Created callback: {}", _callback_name ) );
+		DF_LOG_MESSAGE( "Created callback: {}", _callback_name );
 		return callback;
 	}
 
@@ -105,14 +108,14 @@ namespace df
 
 		if( render_callbacks.contains( _name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback already exist: {}", _name ) );
+			DF_LOG_WARNING( "Callback already exist: {}", _name );
 			return nullptr;
 		}
 
 		cRenderCallback< T, Targs... >* callback = new cRenderCallback< T, Targs... >( _name, _pipelines, _callback );
 		render_callbacks[ _name ]                = callback;
 
-		DF_LOG_MESSAGE( fmt::format( "Created callback: {}", _name ) );
+		DF_LOG_MESSAGE( "Created callback: {}", _name );
 		return callback;
 	}
 
@@ -127,14 +130,14 @@ namespace df
 
 		if( render_callbacks.contains( _name ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback already exist: {}", _name ) );
+			DF_LOG_WARNING( "Callback already exist: {}", _name );
 			return nullptr;
 		}
 
 		cRenderCallback< T, Targs... >* callback = new cRenderCallback< T, Targs... >( _name, _pipelines, _callback );
 		render_callbacks[ _name ]                = callback;
 
-		DF_LOG_MESSAGE( fmt::format( "Created callback: {}", _name ) );
+		DF_LOG_MESSAGE( "Created callback: {}", _name );
 		return callback;
 	}
 
@@ -147,13 +150,13 @@ namespace df
 		const auto it = render_callbacks.find( _name );
 		if( it == render_callbacks.end() )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback doesn't exist: {}", _name ) );
+			DF_LOG_WARNING( "Callback doesn't exist: {}", _name );
 			return false;
 		}
 
 		delete it->second;
 		render_callbacks.erase( it );
-		DF_LOG_MESSAGE( fmt::format( "Destroyed callback: {}", _name ) );
+		DF_LOG_MESSAGE( "Destroyed callback: {}", _name );
 
 		return true;
 	}
@@ -171,14 +174,14 @@ namespace df
 		{
 			if( callback.second == _callback )
 			{
-				DF_LOG_MESSAGE( fmt::format( "Destroyed callback: {}", callback.first ) );
+				DF_LOG_MESSAGE( "Destroyed callback: {}", callback.first );
 				delete callback.second;
 				render_callbacks.erase( callback.first );
 				return true;
 			}
 		}
 
-		DF_LOG_WARNING( fmt::format( "Callback isn't managed: {}", _callback->name ) );
+		DF_LOG_WARNING( "Callback isn't managed: {}", _callback->name );
 		return false;
 	}
 
@@ -192,7 +195,7 @@ namespace df
 		{
 			if( callback.second )
 			{
-				DF_LOG_MESSAGE( fmt::format( "Destroyed callback: {}", callback.first ) );
+				DF_LOG_MESSAGE( "Destroyed callback: {}", callback.first );
 				delete callback.second;
 			}
 		}
@@ -200,6 +203,23 @@ namespace df
 		render_callbacks.clear();
 	}
 
+	inline bool cRenderCallbackManager::reloadShader( const std::string& _shader_name )
+	{
+		ZoneScoped;
+
+		bool reloaded = false;
+		for( iRenderCallback* callback: getInstance()->m_render_callbacks | std::views::values )
+		{
+			if( !callback || !callback->reloadShader( _shader_name ) )
+				continue;
+
+			DF_LOG_MESSAGE( "Reloaded shader: {} in callback: {}", _shader_name, callback->name );
+			reloaded = true;
+		}
+
+		return reloaded;
+	}
+
 	template< typename T, typename... Targs >
 	void cRenderCallbackManager::render( const std::string& _name, Targs... _args )
 	{
@@ -229,7 +249,7 @@ namespace df
 		const auto it = render_callbacks.find( _name );
 		if( it == render_callbacks.end() )
 		{
-			DF_LOG_WARNING( fmt::format( "Callback doesn't exist: {}", _name ) );
+			DF_LOG_WARNING( "Callback doesn't exist: {}", _name );
 			return nullptr;
 		}
 
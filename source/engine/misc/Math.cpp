@@ -0,0 +1,142 @@
+﻿#include "Math.h"
+
+#if defined( _M_X64 ) || defined( __SSE2__ )
+	#define DF_MATH_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace df::math
+{
+	static_assert( sizeof( glm::mat4 ) == sizeof( float ) * 16, "Matrices are stored as four packed columns" );
+
+	glm::mat4 compose( const glm::vec3& _translation, const glm::quat& _rotation, const glm::vec3& _scale )
+	{
+		const float xx = _rotation.x * _rotation.x;
+		const float yy = _rotation.y * _rotation.y;
+		const float zz = _rotation.z * _rotation.z;
+		const float xy = _rotation.x * _rotation.y;
+		const float xz = _rotation.x * _rotation.z;
+		const float yz = _rotation.y * _rotation.z;
+		const float wx = _rotation.w * _rotation.x;
+		const float wy = _rotation.w * _rotation.y;
+		const float wz = _rotation.w * _rotation.z;
+
+		return glm::mat4( glm::vec4( ( 1 - 2 * ( yy + zz ) ) * _scale.x, 2 * ( xy + wz ) * _scale.x, 2 * ( xz - wy ) * _scale.x, 0 ),
+		                  glm::vec4( 2 * ( xy - wz ) * _scale.y, ( 1 - 2 * ( xx + zz ) ) * _scale.y, 2 * ( yz + wx ) * _scale.y, 0 ),
+		                  glm::vec4( 2 * ( xz + wy ) * _scale.z, 2 * ( yz - wx ) * _scale.z, ( 1 - 2 * ( xx + yy ) ) * _scale.z, 0 ),
+		                  glm::vec4( _translation, 1 ) );
+	}
+
+	void compose( const uint32_t* _indices, const size_t _count, const glm::vec3* _translations, const glm::quat* _rotations, const glm::vec3* _scales, glm::mat4* _out )
+	{
+		size_t i = 0;
+
+#if defined( DF_MATH_SSE )
+		const __m128 one = _mm_set1_ps( 1 );
+		const __m128 two = _mm_set1_ps( 2 );
+
+		for( ; i + 4 <= _count; i += 4 )
+		{
+			const uint32_t a = _indices[ i ];
+			const uint32_t b = _indices[ i + 1 ];
+			const uint32_t c = _indices[ i + 2 ];
+			const uint32_t d = _indices[ i + 3 ];
+
+			__m128 qx = _mm_set_ps( _rotations[ a ].w, _rotations[ a ].z, _rotations[ a ].y, _rotations[ a ].x );
+			__m128 qy = _mm_set_ps( _rotations[ b ].w, _rotations[ b ].z, _rotations[ b ].y, _rotations[ b ].x );
+			__m128 qz = _mm_set_ps( _rotations[ c ].w, _rotations[ c ].z, _rotations[ c ].y, _rotations[ c ].x );
+			__m128 qw = _mm_set_ps( _rotations[ d ].w, _rotations[ d ].z, _rotations[ d ].y, _rotations[ d ].x );
+			_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+
+			const __m128 sx = _mm_set_ps( _scales[ d ].x, _scales[ c ].x, _scales[ b ].x, _scales[ a ].x );
+			const __m128 sy = _mm_set_ps( _scales[ d ].y, _scales[ c ].y, _scales[ b ].y, _scales[ a ].y );
+			const __m128 sz = _mm_set_ps( _scales[ d ].z, _scales[ c ].z, _scales[ b ].z, _scales[ a ].z );
+
+			const __m128 xx = _mm_mul_ps( qx, qx );
+			const __m128 yy = _mm_mul_ps( qy, qy );
+			const __m128 zz = _mm_mul_ps( qz, qz );
+			const __m128 xy = _mm_mul_ps( qx, qy );
+			const __m128 xz = _mm_mul_ps( qx, qz );
+			const __m128 yz = _mm_mul_ps( qy, qz );
+			const __m128 wx = _mm_mul_ps( qw, qx );
+			const __m128 wy = _mm_mul_ps( qw, qy );
+			const __m128 wz = _mm_mul_ps( qw, qz );
+
+			__m128 m00 = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( yy, zz ) ) ), sx );
+			__m128 m01 = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( xy, wz ) ), sx );
+			__m128 m02 = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( xz, wy ) ), sx );
+			__m128 m03 = _mm_setzero_ps();
+
+			__m128 m10 = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( xy, wz ) ), sy );
+			__m128 m11 = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, zz ) ) ), sy );
+			__m128 m12 = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( yz, wx ) ), sy );
+			__m128 m13 = _mm_setzero_ps();
+
+			__m128 m20 = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( xz, wy ) ), sz );
+			__m128 m21 = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( yz, wx ) ), sz );
+			__m128 m22 = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, yy ) ) ), sz );
+			__m128 m23 = _mm_setzero_ps();
+
+			__m128 m30 = _mm_set_ps( _translations[ d ].x, _translations[ c ].x, _translations[ b ].x, _translations[ a ].x );
+			__m128 m31 = _mm_set_ps( _translations[ d ].y, _translations[ c ].y, _translations[ b ].y, _translations[ a ].y );
+			__m128 m32 = _mm_set_ps( _translations[ d ].z, _translations[ c ].z, _translations[ b ].z, _translations[ a ].z );
+			__m128 m33 = one;
+
+			_MM_TRANSPOSE4_PS( m00, m01, m02, m03 );
+			_MM_TRANSPOSE4_PS( m10, m11, m12, m13 );
+			_MM_TRANSPOSE4_PS( m20, m21, m22, m23 );
+			_MM_TRANSPOSE4_PS( m30, m31, m32, m33 );
+
+			_mm_storeu_ps( &_out[ a ][ 0 ].x, m00 );
+			_mm_storeu_ps( &_out[ a ][ 1 ].x, m10 );
+			_mm_storeu_ps( &_out[ a ][ 2 ].x, m20 );
+			_mm_storeu_ps( &_out[ a ][ 3 ].x, m30 );
+
+			_mm_storeu_ps( &_out[ b ][ 0 ].x, m01 );
+			_mm_storeu_ps( &_out[ b ][ 1 ].x, m11 );
+			_mm_storeu_ps( &_out[ b ][ 2 ].x, m21 );
+			_mm_storeu_ps( &_out[ b ][ 3 ].x, m31 );
+
+			_mm_storeu_ps( &_out[ c ][ 0 ].x, m02 );
+			_mm_storeu_ps( &_out[ c ][ 1 ].x, m12 );
+			_mm_storeu_ps( &_out[ c ][ 2 ].x, m22 );
+			_mm_storeu_ps( &_out[ c ][ 3 ].x, m32 );
+
+			_mm_storeu_ps( &_out[ d ][ 0 ].x, m03 );
+			_mm_storeu_ps( &_out[ d ][ 1 ].x, m13 );
+			_mm_storeu_ps( &_out[ d ][ 2 ].x, m23 );
+			_mm_storeu_ps( &_out[ d ][ 3 ].x, m33 );
+		}
+#endif
+
+		for( ; i < _count; ++i )
+		{
+			const uint32_t index = _indices[ i ];
+			_out[ index ]        = compose( _translations[ index ], _rotations[ index ], _scales[ index ] );
+		}
+	}
+
+	void multiply( const glm::mat4& _a, const glm::mat4& _b, glm::mat4& _out )
+	{
+#if defined( DF_MATH_SSE )
+		const __m128 a0 = _mm_loadu_ps( &_a[ 0 ].x );
+		const __m128 a1 = _mm_loadu_ps( &_a[ 1 ].x );
+		const __m128 a2 = _mm_loadu_ps( &_a[ 2 ].x );
+		const __m128 a3 = _mm_loadu_ps( &_a[ 3 ].x );
+
+		for( int i = 0; i < 4; ++i )
+		{
+			const glm::vec4& column = _b[ i ];
+
+			__m128 result = _mm_mul_ps( a0, _mm_set1_ps( column.x ) );
+			result        = _mm_add_ps( result, _mm_mul_ps( a1, _mm_set1_ps( column.y ) ) );
+			result        = _mm_add_ps( result, _mm_mul_ps( a2, _mm_set1_ps( column.z ) ) );
+			result        = _mm_add_ps( result, _mm_mul_ps( a3, _mm_set1_ps( column.w ) ) );
+
+			_mm_storeu_ps( &_out[ i ].x, result );
+		}
+#else
+		_out = _a * _b;
+#endif
+	}
+}
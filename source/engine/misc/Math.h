@@ -0,0 +1,14 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace df::math
+{
+	glm::mat4 compose( const glm::vec3& _translation, const glm::quat& _rotation, const glm::vec3& _scale );
+	void      compose( const uint32_t* _indices, size_t _count, const glm::vec3* _translations, const glm::quat* _rotations, const glm::vec3* _scales, glm::mat4* _out );
+
+	void multiply( const glm::mat4& _a, const glm::mat4& _b, glm::mat4& _out );
+}
@@ -0,0 +1,110 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Misc.h"
+
+namespace df
+{
+	template< typename T >
+	class cBoundedQueue
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cBoundedQueue );
+
+		explicit cBoundedQueue( size_t _capacity );
+		~cBoundedQueue() = default;
+
+		bool push( T&& _value );
+		bool pop( T& _value );
+
+		size_t getCapacity() const { return m_cells.size(); }
+
+	private:
+		struct sCell
+		{
+			std::atomic< size_t > sequence;
+			T                     value;
+		};
+
+		std::vector< sCell > m_cells;
+		size_t               m_mask;
+
+		alignas( 64 ) std::atomic< size_t > m_enqueue;
+		alignas( 64 ) std::atomic< size_t > m_dequeue;
+	};
+
+	template< typename T >
+	cBoundedQueue< T >::cBoundedQueue( const size_t _capacity )
+		: m_cells( std::bit_ceil( std::max< size_t >( _capacity, 2 ) ) )
+		, m_mask( m_cells.size() - 1 )
+		, m_enqueue( 0 )
+		, m_dequeue( 0 )
+	{
+		for( size_t i = 0; i < m_cells.size(); ++i )
+			m_cells[ i ].sequence.store( i, std::memory_order_relaxed );
+	}
+
+	template< typename T >
+	bool cBoundedQueue< T >::push( T&& _value )
+	{
+		sCell* cell     = nullptr;
+		size_t position = m_enqueue.load( std::memory_order_relaxed );
+
+		while( true )
+		{
+			cell = &m_cells[ position & m_mask ];
+
+			const size_t    sequence   = cell->sequence.load( std::memory_order_acquire );
+			const ptrdiff_t difference = static_cast< ptrdiff_t >( sequence ) - static_cast< ptrdiff_t >( position );
+
+			if( difference == 0 )
+			{
+				if( m_enqueue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+					break;
+			}
+			else if( difference < 0 )
+				return false;
+			else
+				position = m_enqueue.load( std::memory_order_relaxed );
+		}
+
+		cell->value = std::move( _value );
+		cell->sequence.store( position + 1, std::memory_order_release );
+		return true;
+	}
+
+	template< typename T >
+	bool cBoundedQueue< T >::pop( T& _value )
+	{
+		sCell* cell     = nullptr;
+		size_t position = m_dequeue.load( std::memory_order_relaxed );
+
+		while( true )
+		{
+			cell = &m_cells[ position & m_mask ];
+
+			const size_t    sequence   = cell->sequence.load( std::memory_order_acquire );
+			const ptrdiff_t difference = static_cast< ptrdiff_t >( sequence ) - static_cast< ptrdiff_t >( position + 1 );
+
+			if( difference == 0 )
+			{
+				if( m_dequeue.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+					break;
+			}
+			else if( difference < 0 )
+				return false;
+			else
+				position = m_dequeue.load( std::memory_order_relaxed );
+		}
+
+		_value = std::move( cell->value );
+		cell->sequence.store( position + m_mask + 1, std::memory_order_release );
+		return true;
+	}
+}
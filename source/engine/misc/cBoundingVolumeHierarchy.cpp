@@ -0,0 +1,469 @@
+﻿#include "cBoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <tracy/Tracy.hpp>
+
+#include "engine/misc/sFrustum.h"
+
+namespace df
+{
+	constexpr uint32_t s_bin_count      = 16;
+	constexpr uint32_t s_max_leaf_size  = 4;
+	constexpr float    s_traversal_cost = 2;
+	constexpr float    s_rebuild_ratio  = 2;
+
+	static float surfaceArea( const sBoundingBox& _bounds )
+	{
+		if( !_bounds.isValid() )
+			return 0;
+
+		const glm::vec3 size = _bounds.max - _bounds.min;
+		return 2 * ( size.x * size.y + size.y * size.z + size.z * size.x );
+	}
+
+	static bool intersectRay( const sBoundingBox& _bounds, const glm::vec3& _origin, const glm::vec3& _inverse_direction, const float _max_distance, float& _distance )
+	{
+		const glm::vec3 t0 = ( _bounds.min - _origin ) * _inverse_direction;
+		const glm::vec3 t1 = ( _bounds.max - _origin ) * _inverse_direction;
+
+		const glm::vec3 near = glm::min( t0, t1 );
+		const glm::vec3 far  = glm::max( t0, t1 );
+
+		const float enter = std::max( { near.x, near.y, near.z, 0.f } );
+		const float exit  = std::min( { far.x, far.y, far.z, _max_distance } );
+
+		_distance = enter;
+		return enter <= exit;
+	}
+
+	cBoundingVolumeHierarchy::cBoundingVolumeHierarchy()
+		: m_built_area( 0 )
+		, m_built( false )
+		, m_has_dirty( false )
+	{}
+
+	uint32_t cBoundingVolumeHierarchy::insert( const sBoundingBox& _bounds )
+	{
+		ZoneScoped;
+
+		uint32_t item;
+		if( m_free.empty() )
+		{
+			item = static_cast< uint32_t >( m_bounds.size() );
+			m_bounds.push_back( _bounds );
+			m_valid.push_back( true );
+		}
+		else
+		{
+			item = m_free.back();
+			m_free.pop_back();
+			m_bounds[ item ] = _bounds;
+			m_valid[ item ]  = true;
+		}
+
+		m_built = false;
+		return item;
+	}
+
+	void cBoundingVolumeHierarchy::remove( const uint32_t _item )
+	{
+		ZoneScoped;
+
+		m_valid[ _item ] = false;
+		m_free.push_back( _item );
+
+		m_built = false;
+	}
+
+	void cBoundingVolumeHierarchy::update( const uint32_t _item, const sBoundingBox& _bounds )
+	{
+		m_bounds[ _item ] = _bounds;
+
+		if( !m_built )
+			return;
+
+		m_dirty[ m_item_lanes[ _item ] >> 2 ] = true;
+		m_has_dirty                           = true;
+	}
+
+	void cBoundingVolumeHierarchy::build()
+	{
+		ZoneScoped;
+
+		m_nodes.clear();
+		m_parents.clear();
+		m_references.clear();
+		m_item_lanes.assign( m_bounds.size(), s_invalid );
+
+		std::vector< glm::vec3 > centroids( m_bounds.size() );
+		for( uint32_t i = 0; i < m_bounds.size(); ++i )
+		{
+			if( !m_valid[ i ] )
+				continue;
+
+			m_references.push_back( i );
+			centroids[ i ] = m_bounds[ i ].getCenter();
+		}
+
+		m_built     = true;
+		m_has_dirty = false;
+
+		if( m_references.empty() )
+		{
+			m_dirty.clear();
+			m_built_area = 0;
+			return;
+		}
+
+		std::vector< sBuildNode > build_nodes;
+		build_nodes.reserve( m_references.size() * 2 );
+
+		const uint32_t root = buildRecursive( build_nodes, centroids, 0, static_cast< uint32_t >( m_references.size() ) );
+		collapse( build_nodes, root, s_invalid );
+
+		m_dirty.assign( m_nodes.size(), false );
+		m_built_area = surfaceArea( build_nodes[ root ].bounds );
+	}
+
+	void cBoundingVolumeHierarchy::refit()
+	{
+		ZoneScoped;
+
+		if( !m_built )
+		{
+			build();
+			return;
+		}
+
+		if( !m_has_dirty )
+			return;
+
+		for( size_t i = m_nodes.size(); i-- > 0; )
+		{
+			if( !m_dirty[ i ] )
+				continue;
+
+			sNode&       node = m_nodes[ i ];
+			sBoundingBox bounds;
+
+			for( uint32_t lane = 0; lane < 4; ++lane )
+			{
+				if( node.counts[ lane ] )
+					setLane( node, lane, getLeafBounds( node.children[ lane ], node.counts[ lane ] ) );
+
+				if( node.children[ lane ] != s_invalid )
+					bounds.expand( getLane( node, lane ) );
+			}
+
+			m_dirty[ i ] = false;
+
+			const uint32_t parent = m_parents[ i ];
+			if( parent == s_invalid )
+			{
+				if( surfaceArea( bounds ) > m_built_area * s_rebuild_ratio )
+				{
+					build();
+					return;
+				}
+
+				continue;
+			}
+
+			setLane( m_nodes[ parent >> 2 ], parent & 3, bounds );
+			m_dirty[ parent >> 2 ] = true;
+		}
+
+		m_has_dirty = false;
+	}
+
+	void cBoundingVolumeHierarchy::query( const sFrustum& _frustum, std::vector< uint32_t >& _items ) const
+	{
+		ZoneScoped;
+
+		if( m_nodes.empty() )
+			return;
+
+		std::vector< uint32_t > stack;
+		stack.reserve( 64 );
+		stack.push_back( 0 );
+
+		while( !stack.empty() )
+		{
+			const sNode& node = m_nodes[ stack.back() ];
+			stack.pop_back();
+
+			std::array< bool, 4 > outside{};
+			for( const glm::vec4& plane: _frustum.planes )
+			{
+				for( uint32_t lane = 0; lane < 4; ++lane )
+				{
+					const float x = plane.x > 0 ? node.max_x[ lane ] : node.min_x[ lane ];
+					const float y = plane.y > 0 ? node.max_y[ lane ] : node.min_y[ lane ];
+					const float z = plane.z > 0 ? node.max_z[ lane ] : node.min_z[ lane ];
+
+					outside[ lane ] |= plane.x * x + plane.y * y + plane.z * z + plane.w < 0;
+				}
+			}
+
+			for( uint32_t lane = 0; lane < 4; ++lane )
+			{
+				if( outside[ lane ] || node.children[ lane ] == s_invalid )
+					continue;
+
+				if( !node.counts[ lane ] )
+				{
+					stack.push_back( node.children[ lane ] );
+					continue;
+				}
+
+				for( uint32_t i = node.children[ lane ]; i < node.children[ lane ] + node.counts[ lane ]; ++i )
+				{
+					if( _frustum.intersects( m_bounds[ m_references[ i ] ] ) )
+						_items.push_back( m_references[ i ] );
+				}
+			}
+		}
+	}
+
+	bool cBoundingVolumeHierarchy::raycast( const glm::vec3& _origin, const glm::vec3& _direction, uint32_t& _item, float& _distance ) const
+	{
+		ZoneScoped;
+
+		if( m_nodes.empty() )
+			return false;
+
+		const glm::vec3 inverse_direction = 1.f / _direction;
+
+		float closest = std::numeric_limits< float >::max();
+		_item         = s_invalid;
+
+		std::vector< uint32_t > stack;
+		stack.reserve( 64 );
+		stack.push_back( 0 );
+
+		while( !stack.empty() )
+		{
+			const sNode& node = m_nodes[ stack.back() ];
+			stack.pop_back();
+
+			for( uint32_t lane = 0; lane < 4; ++lane )
+			{
+				float distance;
+				if( node.children[ lane ] == s_invalid || !intersectRay( getLane( node, lane ), _origin, inverse_direction, closest, distance ) )
+					continue;
+
+				if( !node.counts[ lane ] )
+				{
+					stack.push_back( node.children[ lane ] );
+					continue;
+				}
+
+				for( uint32_t i = node.children[ lane ]; i < node.children[ lane ] + node.counts[ lane ]; ++i )
+				{
+					if( !intersectRay( m_bounds[ m_references[ i ] ], _origin, inverse_direction, closest, distance ) )
+						continue;
+
+					closest = distance;
+					_item   = m_references[ i ];
+				}
+			}
+		}
+
+		_distance = closest;
+		return _item != s_invalid;
+	}
+
+	uint32_t cBoundingVolumeHierarchy::buildRecursive( std::vector< sBuildNode >& _build_nodes, const std::vector< glm::vec3 >& _centroids, const uint32_t _first, const uint32_t _count )
+	{
+		const uint32_t     index  = static_cast< uint32_t >( _build_nodes.size() );
+		const sBoundingBox bounds = getLeafBounds( _first, _count );
+		_build_nodes.push_back( { bounds, s_invalid, s_invalid, _first, _count } );
+
+		if( _count == 1 )
+			return index;
+
+		sBoundingBox centroid_bounds;
+		for( uint32_t i = _first; i < _first + _count; ++i )
+			centroid_bounds.expand( _centroids[ m_references[ i ] ] );
+
+		struct sBin
+		{
+			sBoundingBox bounds;
+			uint32_t     count = 0;
+		};
+
+		float    best_cost  = std::numeric_limits< float >::max();
+		int      best_axis  = -1;
+		uint32_t best_split = 0;
+
+		for( int axis = 0; axis < 3; ++axis )
+		{
+			const float extent = centroid_bounds.max[ axis ] - centroid_bounds.min[ axis ];
+			if( extent <= 0 )
+				continue;
+
+			const float scale = static_cast< float >( s_bin_count ) / extent;
+
+			std::array< sBin, s_bin_count > bins{};
+			for( uint32_t i = _first; i < _first + _count; ++i )
+			{
+				const uint32_t item = m_references[ i ];
+				const uint32_t bin  = std::min( static_cast< uint32_t >( ( _centroids[ item ][ axis ] - centroid_bounds.min[ axis ] ) * scale ), s_bin_count - 1 );
+
+				bins[ bin ].bounds.expand( m_bounds[ item ] );
+				++bins[ bin ].count;
+			}
+
+			std::array< float, s_bin_count > right_costs{};
+			sBoundingBox                     right_bounds;
+			uint32_t                         right_count = 0;
+			for( uint32_t bin = s_bin_count - 1; bin > 0; --bin )
+			{
+				right_bounds.expand( bins[ bin ].bounds );
+				right_count         += bins[ bin ].count;
+				right_costs[ bin ]   = static_cast< float >( right_count ) * surfaceArea( right_bounds );
+			}
+
+			sBoundingBox left_bounds;
+			uint32_t     left_count = 0;
+			for( uint32_t split = 1; split < s_bin_count; ++split )
+			{
+				left_bounds.expand( bins[ split - 1 ].bounds );
+				left_count += bins[ split - 1 ].count;
+
+				if( !left_count || left_count == _count )
+					continue;
+
+				const float cost = static_cast< float >( left_count ) * surfaceArea( left_bounds ) + right_costs[ split ];
+				if( cost < best_cost )
+				{
+					best_cost  = cost;
+					best_axis  = axis;
+					best_split = split;
+				}
+			}
+		}
+
+		const float area = surfaceArea( bounds );
+		if( _count <= s_max_leaf_size && ( best_axis < 0 || best_cost + s_traversal_cost * area >= static_cast< float >( _count ) * area ) )
+			return index;
+
+		uint32_t middle = _first + _count / 2;
+		if( best_axis >= 0 )
+		{
+			const float scale = static_cast< float >( s_bin_count ) / ( centroid_bounds.max[ best_axis ] - centroid_bounds.min[ best_axis ] );
+			const auto  begin = m_references.begin() + _first;
+
+			const auto it = std::partition( begin,
+			                                begin + _count,
+			                                [ & ]( const uint32_t _item )
+			                                {
+												const float offset = ( _centroids[ _item ][ best_axis ] - centroid_bounds.min[ best_axis ] ) * scale;
+												return std::min( static_cast< uint32_t >( offset ), s_bin_count - 1 ) < best_split;
+											} );
+
+			middle = static_cast< uint32_t >( it - m_references.begin() );
+		}
+
+		const uint32_t left  = buildRecursive( _build_nodes, _centroids, _first, middle - _first );
+		const uint32_t right = buildRecursive( _build_nodes, _centroids, middle, _first + _count - middle );
+
+		_build_nodes[ index ].left  = left;
+		_build_nodes[ index ].right = right;
+		return index;
+	}
+
+	uint32_t cBoundingVolumeHierarchy::collapse( const std::vector< sBuildNode >& _build_nodes, const uint32_t _build_node, const uint32_t _parent )
+	{
+		const uint32_t index = static_cast< uint32_t >( m_nodes.size() );
+		m_nodes.emplace_back();
+		m_parents.push_back( _parent );
+
+		std::vector< uint32_t > children;
+		if( _build_nodes[ _build_node ].left == s_invalid )
+			children.push_back( _build_node );
+		else
+			children = { _build_nodes[ _build_node ].left, _build_nodes[ _build_node ].right };
+
+		while( children.size() < 4 )
+		{
+			float  largest_area = -1;
+			size_t largest      = children.size();
+
+			for( size_t i = 0; i < children.size(); ++i )
+			{
+				const sBuildNode& child = _build_nodes[ children[ i ] ];
+				if( child.left != s_invalid && surfaceArea( child.bounds ) > largest_area )
+				{
+					largest_area = surfaceArea( child.bounds );
+					largest      = i;
+				}
+			}
+
+			if( largest == children.size() )
+				break;
+
+			const sBuildNode& child = _build_nodes[ children[ largest ] ];
+			children[ largest ]     = child.left;
+			children.push_back( child.right );
+		}
+
+		for( uint32_t lane = 0; lane < 4; ++lane )
+		{
+			sNode& node = m_nodes[ index ];
+			setLane( node, lane, sBoundingBox{} );
+			node.children[ lane ] = s_invalid;
+			node.counts[ lane ]   = 0;
+		}
+
+		for( uint32_t lane = 0; lane < children.size(); ++lane )
+		{
+			const sBuildNode& child = _build_nodes[ children[ lane ] ];
+			setLane( m_nodes[ index ], lane, child.bounds );
+
+			if( child.left != s_invalid )
+			{
+				const uint32_t child_index        = collapse( _build_nodes, children[ lane ], index << 2 | lane );
+				m_nodes[ index ].children[ lane ] = child_index;
+				continue;
+			}
+
+			m_nodes[ index ].children[ lane ] = child.first;
+			m_nodes[ index ].counts[ lane ]   = child.count;
+
+			for( uint32_t i = child.first; i < child.first + child.count; ++i )
+				m_item_lanes[ m_references[ i ] ] = index << 2 | lane;
+		}
+
+		return index;
+	}
+
+	void cBoundingVolumeHierarchy::setLane( sNode& _node, const uint32_t _lane, const sBoundingBox& _bounds )
+	{
+		_node.min_x[ _lane ] = _bounds.min.x;
+		_node.min_y[ _lane ] = _bounds.min.y;
+		_node.min_z[ _lane ] = _bounds.min.z;
+		_node.max_x[ _lane ] = _bounds.max.x;
+		_node.max_y[ _lane ] = _bounds.max.y;
+		_node.max_z[ _lane ] = _bounds.max.z;
+	}
+
+	sBoundingBox cBoundingVolumeHierarchy::getLane( const sNode& _node, const uint32_t _lane )
+	{
+		return sBoundingBox{
+			.min = glm::vec3( _node.min_x[ _lane ], _node.min_y[ _lane ], _node.min_z[ _lane ] ),
+			.max = glm::vec3( _node.max_x[ _lane ], _node.max_y[ _lane ], _node.max_z[ _lane ] ),
+		};
+	}
+
+	sBoundingBox cBoundingVolumeHierarchy::getLeafBounds( const uint32_t _first, const uint32_t _count ) const
+	{
+		sBoundingBox bounds;
+		for( uint32_t i = _first; i < _first + _count; ++i )
+			bounds.expand( m_bounds[ m_references[ i ] ] );
+
+		return bounds;
+	}
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <vector>
+
+#include "engine/misc/Misc.h"
+#include "engine/misc/sBoundingBox.h"
+
+namespace df
+{
+	struct sFrustum;
+
+	class cBoundingVolumeHierarchy
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cBoundingVolumeHierarchy );
+
+		static constexpr uint32_t s_invalid = UINT32_MAX;
+
+		cBoundingVolumeHierarchy();
+		~cBoundingVolumeHierarchy() = default;
+
+		uint32_t insert( const sBoundingBox& _bounds );
+		void     remove( uint32_t _item );
+		void     update( uint32_t _item, const sBoundingBox& _bounds );
+
+		void build();
+		void refit();
+
+		void query( const sFrustum& _frustum, std::vector< uint32_t >& _items ) const;
+		bool raycast( const glm::vec3& _origin, const glm::vec3& _direction, uint32_t& _item, float& _distance ) const;
+
+		const sBoundingBox& getBounds( const uint32_t _item ) const { return m_bounds[ _item ]; }
+		size_t              getNodeCount() const { return m_nodes.size(); }
+		bool                isBuilt() const { return m_built; }
+
+	private:
+		struct alignas( 64 ) sNode
+		{
+			float    min_x[ 4 ];
+			float    min_y[ 4 ];
+			float    min_z[ 4 ];
+			float    max_x[ 4 ];
+			float    max_y[ 4 ];
+			float    max_z[ 4 ];
+			uint32_t children[ 4 ];
+			uint32_t counts[ 4 ];
+		};
+
+		struct sBuildNode
+		{
+			sBoundingBox bounds;
+			uint32_t     left;
+			uint32_t     right;
+			uint32_t     first;
+			uint32_t     count;
+		};
+
+		uint32_t buildRecursive( std::vector< sBuildNode >& _build_nodes, const std::vector< glm::vec3 >& _centroids, uint32_t _first, uint32_t _count );
+		uint32_t collapse( const std::vector< sBuildNode >& _build_nodes, uint32_t _build_node, uint32_t _parent );
+
+		static void         setLane( sNode& _node, uint32_t _lane, const sBoundingBox& _bounds );
+		static sBoundingBox getLane( const sNode& _node, uint32_t _lane );
+		sBoundingBox        getLeafBounds( uint32_t _first, uint32_t _count ) const;
+
+		std::vector< sBoundingBox > m_bounds;
+		std::vector< uint8_t >      m_valid;
+		std::vector< uint32_t >     m_free;
+
+		std::vector< sNode >    m_nodes;
+		std::vector< uint32_t > m_parents;
+		std::vector< uint32_t > m_references;
+		std::vector< uint32_t > m_item_lanes;
+		std::vector< uint8_t >  m_dirty;
+
+		float m_built_area;
+		bool  m_built;
+		bool  m_has_dirty;
+	};
+}
@@ -0,0 +1,159 @@
+﻿#include "cThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tracy/Tracy.hpp>
+
+namespace df
+{
+	cThreadPool::cThreadPool( uint32_t _thread_count )
+		: m_active( 0 )
+		, m_running( true )
+	{
+		ZoneScoped;
+
+		if( !_thread_count )
+			_thread_count = std::max( std::thread::hardware_concurrency(), 2u ) - 1;
+
+		m_threads.reserve( _thread_count );
+		for( uint32_t i = 0; i < _thread_count; ++i )
+			m_threads.emplace_back( &cThreadPool::run, this );
+	}
+
+	cThreadPool::~cThreadPool()
+	{
+		ZoneScoped;
+
+		{
+			std::lock_guard lock( m_mutex );
+			m_running = false;
+		}
+
+		m_task_condition.notify_all();
+
+		for( std::thread& thread: m_threads )
+			thread.join();
+	}
+
+	void cThreadPool::submit( std::function< void() > _task )
+	{
+		ZoneScoped;
+
+		{
+			std::lock_guard lock( m_mutex );
+			m_tasks.push_back( std::move( _task ) );
+		}
+
+		m_task_condition.notify_one();
+	}
+
+	void cThreadPool::submit( std::vector< std::function< void() > >& _tasks )
+	{
+		ZoneScoped;
+
+		{
+			std::lock_guard lock( m_mutex );
+			for( std::function< void() >& task: _tasks )
+				m_tasks.push_back( std::move( task ) );
+		}
+
+		_tasks.clear();
+		m_task_condition.notify_all();
+	}
+
+	void cThreadPool::parallelFor( const size_t _count, size_t _chunk_size, const std::function< void( size_t _begin, size_t _end ) >& _function )
+	{
+		ZoneScoped;
+
+		if( !_count )
+			return;
+
+		_chunk_size = std::max< size_t >( _chunk_size, 1 );
+
+		struct sState
+		{
+			std::function< void( size_t, size_t ) > function;
+			size_t                                  count;
+			size_t                                  chunk_size;
+			size_t                                  chunk_count;
+			std::atomic< size_t >                   next_chunk;
+			std::atomic< size_t >                   completed_chunks;
+			std::mutex                              mutex;
+			std::condition_variable                 condition;
+		};
+
+		const std::shared_ptr< sState > state = std::make_shared< sState >();
+		state->function                       = _function;
+		state->count                          = _count;
+		state->chunk_size                     = _chunk_size;
+		state->chunk_count                    = ( _count + _chunk_size - 1 ) / _chunk_size;
+		state->next_chunk                     = 0;
+		state->completed_chunks               = 0;
+
+		const auto work = [ state ]
+		{
+			size_t completed = 0;
+			for( size_t chunk = state->next_chunk++; chunk < state->chunk_count; chunk = state->next_chunk++ )
+			{
+				const size_t begin = chunk * state->chunk_size;
+				state->function( begin, std::min( begin + state->chunk_size, state->count ) );
+				++completed;
+			}
+
+			if( completed && state->completed_chunks.fetch_add( completed ) + completed == state->chunk_count )
+			{
+				std::lock_guard lock( state->mutex );
+				state->condition.notify_all();
+			}
+		};
+
+		const size_t helpers = std::min< size_t >( m_threads.size(), state->chunk_count - 1 );
+		if( helpers )
+		{
+			std::vector< std::function< void() > > tasks( helpers, work );
+			submit( tasks );
+		}
+
+		work();
+
+		std::unique_lock lock( state->mutex );
+		state->condition.wait( lock, [ & ] { return state->completed_chunks == state->chunk_count; } );
+	}
+
+	void cThreadPool::wait()
+	{
+		ZoneScoped;
+
+		std::unique_lock lock( m_mutex );
+		m_idle_condition.wait( lock, [ this ] { return m_tasks.empty() && !m_active; } );
+	}
+
+	void cThreadPool::run()
+	{
+		while( true )
+		{
+			std::function< void() > task;
+			{
+				std::unique_lock lock( m_mutex );
+				m_task_condition.wait( lock, [ this ] { return !m_tasks.empty() || !m_running; } );
+
+				if( m_tasks.empty() )
+					return;
+
+				task = std::move( m_tasks.front() );
+				m_tasks.pop_front();
+				++m_active;
+			}
+
+			task();
+
+			{
+				std::lock_guard lock( m_mutex );
+				--m_active;
+				if( m_tasks.empty() && !m_active )
+					m_idle_condition.notify_all();
+			}
+		}
+	}
+}
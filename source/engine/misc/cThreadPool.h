@@ -0,0 +1,43 @@
+﻿#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Misc.h"
+
+namespace df
+{
+	class cThreadPool
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cThreadPool );
+
+		explicit cThreadPool( uint32_t _thread_count = 0 );
+		~cThreadPool();
+
+		void submit( std::function< void() > _task );
+		void submit( std::vector< std::function< void() > >& _tasks );
+
+		void parallelFor( size_t _count, size_t _chunk_size, const std::function< void( size_t _begin, size_t _end ) >& _function );
+		void wait();
+
+		uint32_t getThreadCount() const { return static_cast< uint32_t >( m_threads.size() ); }
+
+	private:
+		void run();
+
+		std::vector< std::thread >            m_threads;
+		std::deque< std::function< void() > > m_tasks;
+
+		std::mutex              m_mutex;
+		std::condition_variable m_task_condition;
+		std::condition_variable m_idle_condition;
+		uint32_t                m_active;
+		bool                    m_running;
+	};
+}
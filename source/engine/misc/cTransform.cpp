@@ -7,9 +7,8 @@
 namespace df
 {
 	cTransform::cTransform()
-		: local( 1 )
-		, world( 1 )
-		, parent( nullptr )
+		: parent( nullptr )
+		, m_handle( cTransformSystem::create() )
 	{}
 
 	cTransform::~cTransform()
@@ -21,16 +20,15 @@ namespace df
 
 		while( !children.empty() )
 			removeChild( *children.front() );
+
+		cTransformSystem::destroy( m_handle );
 	}
 
 	void cTransform::update()
 	{
 		ZoneScoped;
 
-		world = parent ? local * parent->world : local;
-
-		for( cTransform* child: children )
-			child->update();
+		cTransformSystem::updateNode( m_handle );
 	}
 
 	bool cTransform::addChild( cTransform& _child )
@@ -49,6 +47,9 @@ namespace df
 			return false;
 		}
 
+		if( !cTransformSystem::setParent( _child.m_handle, m_handle ) )
+			return false;
+
 		children.push_back( &_child );
 		_child.parent = this;
 		return true;
@@ -61,6 +62,7 @@ namespace df
 		if( std::erase( children, &_child ) )
 		{
 			_child.parent = nullptr;
+			cTransformSystem::setParent( _child.m_handle, cTransformSystem::s_invalid );
 			return true;
 		}
 
@@ -98,6 +100,9 @@ namespace df
 			return false;
 		}
 
+		if( !cTransformSystem::setParent( m_handle, _parent.m_handle ) )
+			return false;
+
 		parent = &_parent;
 		_parent.children.push_back( this );
 		return true;
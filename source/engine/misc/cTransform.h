@@ -3,6 +3,7 @@
 #include <glm/mat4x4.hpp>
 #include <vector>
 
+#include "engine/misc/cTransformSystem.h"
 #include "engine/misc/Misc.h"
 
 namespace df
@@ -10,14 +11,11 @@ namespace df
 	class cTransform final
 	{
 	public:
-		DF_DISABLE_COPY( cTransform )
+		DF_DISABLE_COPY_AND_MOVE( cTransform )
 
 		cTransform();
-		cTransform( cTransform&& _other ) = default;
 		~cTransform();
 
-		cTransform& operator=( cTransform&& _other ) = default;
-
 		void update();
 
 		bool addChild( cTransform& _child );
@@ -26,10 +24,21 @@ namespace df
 		bool setParent( cTransform& _parent );
 		bool removeParent();
 
-		glm::mat4 local;
-		glm::mat4 world;
+		void      setTranslation( const glm::vec3& _translation ) { cTransformSystem::setTranslation( m_handle, _translation ); }
+		void      setRotation( const glm::quat& _rotation ) { cTransformSystem::setRotation( m_handle, _rotation ); }
+		void      setScale( const glm::vec3& _scale ) { cTransformSystem::setScale( m_handle, _scale ); }
+		glm::vec3 getTranslation() const { return cTransformSystem::getTranslation( m_handle ); }
+		glm::quat getRotation() const { return cTransformSystem::getRotation( m_handle ); }
+		glm::vec3 getScale() const { return cTransformSystem::getScale( m_handle ); }
+		glm::mat4 getLocal() const { return cTransformSystem::getLocal( m_handle ); }
+		glm::mat4 getWorld() const { return cTransformSystem::getWorld( m_handle ); }
+
+		cTransformSystem::tHandle getHandle() const { return m_handle; }
 
 		cTransform*                parent;
 		std::vector< cTransform* > children;
+
+	private:
+		cTransformSystem::tHandle m_handle;
 	};
 }
@@ -0,0 +1,450 @@
+﻿#include "cTransformSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <glm/ext/matrix_transform.hpp>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+#include "engine/managers/cJobManager.h"
+#include "engine/misc/Math.h"
+
+namespace df
+{
+	constexpr size_t s_parallel_threshold = 1024;
+	constexpr size_t s_parallel_chunk     = 256;
+
+	cTransformSystem::cTransformSystem()
+		: m_sorted( true )
+		, m_has_dirty( false )
+	{
+		ZoneScoped;
+
+		DF_LOG_MESSAGE( "Initialized transform system" );
+	}
+
+	cTransformSystem::tHandle cTransformSystem::create()
+	{
+		ZoneScoped;
+
+		cTransformSystem* system = getInstance();
+
+		tHandle handle;
+		if( system->m_free.empty() )
+		{
+			handle = static_cast< tHandle >( system->m_indices.size() );
+			system->m_indices.push_back( s_invalid );
+			system->m_parents.push_back( s_invalid );
+		}
+		else
+		{
+			handle = system->m_free.back();
+			system->m_free.pop_back();
+			system->m_parents[ handle ] = s_invalid;
+		}
+
+		system->m_indices[ handle ] = static_cast< uint32_t >( system->m_handles.size() );
+
+		system->m_translations.emplace_back( 0 );
+		system->m_rotations.emplace_back( 1, 0, 0, 0 );
+		system->m_scales.emplace_back( 1 );
+		system->m_local.emplace_back( 1 );
+		system->m_world.emplace_back( 1 );
+		system->m_parent_indices.push_back( s_invalid );
+		system->m_handles.push_back( handle );
+		system->m_versions.push_back( 0 );
+		system->m_parent_versions.push_back( 0 );
+		system->m_dirty.push_back( false );
+
+		system->m_sorted = false;
+		return handle;
+	}
+
+	void cTransformSystem::destroy( const tHandle _handle )
+	{
+		ZoneScoped;
+
+		cTransformSystem* system = getInstance();
+
+		const uint32_t index = system->m_indices[ _handle ];
+		if( index == s_invalid )
+		{
+			DF_LOG_WARNING( "Transform doesn't exist" );
+			return;
+		}
+
+		system->m_handles[ index ]   = s_invalid;
+		system->m_indices[ _handle ] = s_invalid;
+		system->m_parents[ _handle ] = s_invalid;
+		system->m_destroyed.push_back( _handle );
+
+		system->m_sorted    = false;
+		system->m_has_dirty = true;
+	}
+
+	bool cTransformSystem::setParent( const tHandle _handle, const tHandle _parent )
+	{
+		ZoneScoped;
+
+		cTransformSystem* system = getInstance();
+
+		for( tHandle parent = _parent; parent != s_invalid; parent = system->m_parents[ parent ] )
+		{
+			if( parent == _handle )
+			{
+				DF_LOG_ERROR( "Transform can't be parented to its own descendant" );
+				return false;
+			}
+		}
+
+		system->m_parents[ _handle ]                    = _parent;
+		system->m_dirty[ system->m_indices[ _handle ] ] = true;
+
+		system->m_sorted    = false;
+		system->m_has_dirty = true;
+		return true;
+	}
+
+	void cTransformSystem::setTranslation( const tHandle _handle, const glm::vec3& _translation )
+	{
+		cTransformSystem* system = getInstance();
+		const uint32_t    index  = system->m_indices[ _handle ];
+
+		system->m_translations[ index ] = _translation;
+		system->markDirty( index );
+	}
+
+	void cTransformSystem::setRotation( const tHandle _handle, const glm::quat& _rotation )
+	{
+		cTransformSystem* system = getInstance();
+		const uint32_t    index  = system->m_indices[ _handle ];
+
+		system->m_rotations[ index ] = _rotation;
+		system->markDirty( index );
+	}
+
+	void cTransformSystem::setScale( const tHandle _handle, const glm::vec3& _scale )
+	{
+		cTransformSystem* system = getInstance();
+		const uint32_t    index  = system->m_indices[ _handle ];
+
+		system->m_scales[ index ] = _scale;
+		system->markDirty( index );
+	}
+
+	glm::mat4 cTransformSystem::getLocal( const tHandle _handle )
+	{
+		const cTransformSystem* system = getInstance();
+		const uint32_t          index  = system->m_indices[ _handle ];
+
+		return math::compose( system->m_translations[ index ], system->m_rotations[ index ], system->m_scales[ index ] );
+	}
+
+	void cTransformSystem::updateNode( const tHandle _handle )
+	{
+		ZoneScoped;
+
+		cTransformSystem* system = getInstance();
+
+		std::vector< tHandle >& chain = system->m_chain;
+		chain.clear();
+		for( tHandle handle = _handle; handle != s_invalid && system->m_indices[ handle ] != s_invalid; handle = system->m_parents[ handle ] )
+			chain.push_back( handle );
+
+		uint32_t parent_index = s_invalid;
+		for( auto it = chain.rbegin(); it != chain.rend(); ++it )
+		{
+			const uint32_t index = system->m_indices[ *it ];
+			if( system->m_dirty[ index ] )
+				system->m_local[ index ] = math::compose( system->m_translations[ index ], system->m_rotations[ index ], system->m_scales[ index ] );
+
+			if( system->updateIndex( index, parent_index ) )
+				system->m_changing.push_back( *it );
+
+			parent_index = index;
+		}
+	}
+
+	void cTransformSystem::update()
+	{
+		ZoneScoped;
+
+		cTransformSystem* system = getInstance();
+
+		if( !system->m_sorted )
+			system->sort();
+
+		if( system->m_has_dirty )
+		{
+			for( size_t level = 0; level + 1 < system->m_levels.size(); ++level )
+			{
+				const size_t begin = system->m_levels[ level ];
+				const size_t end   = system->m_levels[ level + 1 ];
+
+				if( end - begin < s_parallel_threshold )
+				{
+					system->updateRange( begin, end, system->m_changing );
+					continue;
+				}
+
+				cJobManager::parallelFor( end - begin,
+				                          s_parallel_chunk,
+				                          [ system, begin ]( const size_t _begin, const size_t _end )
+				                          {
+											  std::vector< tHandle > changed;
+											  system->updateRange( begin + _begin, begin + _end, changed );
+
+											  if( changed.empty() )
+												  return;
+
+											  std::lock_guard lock( system->m_changed_mutex );
+											  system->m_changing.insert( system->m_changing.end(), changed.begin(), changed.end() );
+										  } );
+			}
+
+			system->m_has_dirty = false;
+		}
+
+		system->m_changed.swap( system->m_changing );
+		system->m_changing.clear();
+	}
+
+	void cTransformSystem::sort()
+	{
+		ZoneScoped;
+
+		const size_t count = m_handles.size();
+
+		std::vector< uint32_t > depths( m_indices.size(), s_invalid );
+		std::vector< uint32_t > order;
+		order.reserve( count );
+
+		for( uint32_t i = 0; i < count; ++i )
+		{
+			const tHandle handle = m_handles[ i ];
+			if( handle == s_invalid )
+				continue;
+
+			const tHandle parent = m_parents[ handle ];
+			if( parent != s_invalid && m_indices[ parent ] == s_invalid )
+			{
+				m_parents[ handle ] = s_invalid;
+				m_dirty[ i ]        = true;
+				m_has_dirty         = true;
+			}
+		}
+
+		m_free.insert( m_free.end(), m_destroyed.begin(), m_destroyed.end() );
+		m_destroyed.clear();
+
+		for( uint32_t i = 0; i < count; ++i )
+		{
+			const tHandle handle = m_handles[ i ];
+			if( handle == s_invalid )
+				continue;
+
+			order.push_back( i );
+
+			uint32_t depth = 0;
+			for( tHandle parent = m_parents[ handle ]; parent != s_invalid; parent = m_parents[ parent ] )
+			{
+				if( depths[ parent ] != s_invalid )
+				{
+					depth += depths[ parent ] + 1;
+					break;
+				}
+
+				++depth;
+			}
+
+			depths[ handle ] = depth;
+		}
+
+		std::ranges::stable_sort( order, [ & ]( const uint32_t _a, const uint32_t _b ) { return depths[ m_handles[ _a ] ] < depths[ m_handles[ _b ] ]; } );
+
+		auto permute = [ &order ]< typename T >( std::vector< T >& _data )
+		{
+			std::vector< T > sorted;
+			sorted.reserve( order.size() );
+
+			for( const uint32_t index: order )
+				sorted.push_back( _data[ index ] );
+
+			_data.swap( sorted );
+		};
+
+		permute( m_translations );
+		permute( m_rotations );
+		permute( m_scales );
+		permute( m_local );
+		permute( m_world );
+		permute( m_handles );
+		permute( m_versions );
+		permute( m_parent_versions );
+		permute( m_dirty );
+
+		m_parent_indices.resize( order.size() );
+		m_levels.clear();
+
+		for( uint32_t i = 0; i < order.size(); ++i )
+			m_indices[ m_handles[ i ] ] = i;
+
+		for( uint32_t i = 0; i < order.size(); ++i )
+		{
+			const tHandle handle = m_handles[ i ];
+			const tHandle parent = m_parents[ handle ];
+
+			m_parent_indices[ i ] = parent == s_invalid ? s_invalid : m_indices[ parent ];
+
+			while( m_levels.size() <= depths[ handle ] )
+				m_levels.push_back( i );
+		}
+
+		m_levels.push_back( static_cast< uint32_t >( order.size() ) );
+		m_sorted = true;
+	}
+
+	void cTransformSystem::updateRange( const size_t _begin, const size_t _end, std::vector< tHandle >& _changed )
+	{
+		ZoneScoped;
+
+		std::array< uint32_t, s_parallel_chunk > dirty;
+		for( size_t block = _begin; block < _end; block += s_parallel_chunk )
+		{
+			const size_t block_end = std::min( block + s_parallel_chunk, _end );
+
+			size_t count = 0;
+			for( uint32_t i = static_cast< uint32_t >( block ); i < block_end; ++i )
+			{
+				if( m_dirty[ i ] )
+					dirty[ count++ ] = i;
+			}
+
+			math::compose( dirty.data(), count, m_translations.data(), m_rotations.data(), m_scales.data(), m_local.data() );
+		}
+
+		for( size_t i = _begin; i < _end; ++i )
+		{
+			if( updateIndex( static_cast< uint32_t >( i ), m_parent_indices[ i ] ) )
+				_changed.push_back( m_handles[ i ] );
+		}
+	}
+
+	bool cTransformSystem::updateIndex( const uint32_t _index, const uint32_t _parent_index )
+	{
+		if( !m_dirty[ _index ] && ( _parent_index == s_invalid || m_parent_versions[ _index ] == m_versions[ _parent_index ] ) )
+			return false;
+
+		if( _parent_index == s_invalid )
+			m_world[ _index ] = m_local[ _index ];
+		else
+		{
+			math::multiply( m_local[ _index ], m_world[ _parent_index ], m_world[ _index ] );
+			m_parent_versions[ _index ] = m_versions[ _parent_index ];
+		}
+
+		m_dirty[ _index ] = false;
+		++m_versions[ _index ];
+		return true;
+	}
+
+	void cTransformSystem::markDirty( const uint32_t _index )
+	{
+		m_dirty[ _index ] = true;
+		m_has_dirty       = true;
+	}
+
+	double cTransformSystem::benchmark( const uint32_t _count, const uint32_t _frames )
+	{
+		ZoneScoped;
+
+		struct sNode
+		{
+			glm::vec3             translation;
+			glm::quat             rotation;
+			glm::vec3             scale;
+			glm::mat4             local;
+			glm::mat4             world;
+			std::vector< sNode* > children;
+		};
+
+		constexpr uint32_t depth = 8;
+
+		std::vector< glm::quat > rotations( _count );
+		std::vector< sNode* >    nodes( _count );
+		std::vector< sNode* >    roots;
+		std::vector< tHandle >   handles( _count );
+
+		for( uint32_t i = 0; i < _count; ++i )
+		{
+			rotations[ i ] = angleAxis( static_cast< float >( i ) * .01f, glm::vec3( 0, 1, 0 ) );
+
+			nodes[ i ]   = new sNode{ glm::vec3( 1, 0, 0 ), rotations[ i ], glm::vec3( 1 ), glm::mat4( 1 ), glm::mat4( 1 ), {} };
+			handles[ i ] = create();
+			setTranslation( handles[ i ], glm::vec3( 1, 0, 0 ) );
+
+			if( i % depth )
+			{
+				nodes[ i - 1 ]->children.push_back( nodes[ i ] );
+				setParent( handles[ i ], handles[ i - 1 ] );
+			}
+			else
+				roots.push_back( nodes[ i ] );
+		}
+
+		update();
+
+		const std::function< void( sNode*, const sNode* ) > update_recursive = [ & ]( sNode* _node, const sNode* _parent )
+		{
+			_node->world = _parent ? _node->local * _parent->world : _node->local;
+
+			for( sNode* child: _node->children )
+				update_recursive( child, _node );
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		for( uint32_t frame = 0; frame < _frames; ++frame )
+		{
+			for( uint32_t i = 0; i < _count; ++i )
+			{
+				sNode* node    = nodes[ i ];
+				node->rotation = rotations[ ( i + frame ) % _count ];
+				node->local    = scale( translate( glm::mat4( 1 ), node->translation ) * mat4_cast( node->rotation ), node->scale );
+			}
+
+			for( sNode* root: roots )
+				update_recursive( root, nullptr );
+		}
+
+		const std::chrono::duration< double, std::milli > recursive = ( std::chrono::steady_clock::now() - start ) / _frames;
+
+		start = std::chrono::steady_clock::now();
+		for( uint32_t frame = 0; frame < _frames; ++frame )
+		{
+			for( uint32_t i = 0; i < _count; ++i )
+				setRotation( handles[ i ], rotations[ ( i + frame ) % _count ] );
+
+			update();
+		}
+
+		const std::chrono::duration< double, std::milli > batched = ( std::chrono::steady_clock::now() - start ) / _frames;
+
+		for( uint32_t i = 0; i < _count; ++i )
+		{
+			destroy( handles[ i ] );
+			delete nodes[ i ];
+		}
+
+		update();
+
+		DF_LOG_MESSAGE( "Updated {} transforms in {:.3f} ms/frame recursively and {:.3f} ms/frame batched ({:.2f}x)",
+		                _count,
+		                recursive.count(),
+		                batched.count(),
+		                recursive / batched );
+
+		return recursive / batched;
+	}
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include <cstdint>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <mutex>
+#include <vector>
+
+#include "engine/misc/iSingleton.h"
+
+namespace df
+{
+	class cTransformSystem final : public iSingleton< cTransformSystem >
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cTransformSystem );
+
+		typedef uint32_t tHandle;
+
+		static constexpr tHandle s_invalid = UINT32_MAX;
+
+		cTransformSystem();
+		~cTransformSystem() override = default;
+
+		static tHandle create();
+		static void    destroy( tHandle _handle );
+
+		static bool    setParent( tHandle _handle, tHandle _parent );
+		static tHandle getParent( tHandle _handle ) { return getInstance()->m_parents[ _handle ]; }
+
+		static void      setTranslation( tHandle _handle, const glm::vec3& _translation );
+		static void      setRotation( tHandle _handle, const glm::quat& _rotation );
+		static void      setScale( tHandle _handle, const glm::vec3& _scale );
+		static glm::vec3 getTranslation( tHandle _handle ) { return getInstance()->m_translations[ getInstance()->m_indices[ _handle ] ]; }
+		static glm::quat getRotation( tHandle _handle ) { return getInstance()->m_rotations[ getInstance()->m_indices[ _handle ] ]; }
+		static glm::vec3 getScale( tHandle _handle ) { return getInstance()->m_scales[ getInstance()->m_indices[ _handle ] ]; }
+		static glm::mat4 getLocal( tHandle _handle );
+		static glm::mat4 getWorld( tHandle _handle ) { return getInstance()->m_world[ getInstance()->m_indices[ _handle ] ]; }
+		static uint32_t  getVersion( tHandle _handle ) { return getInstance()->m_versions[ getInstance()->m_indices[ _handle ] ]; }
+
+		static void updateNode( tHandle _handle );
+		static void update();
+
+		static const std::vector< tHandle >& getChanged() { return getInstance()->m_changed; }
+		static size_t                        getCount() { return getInstance()->m_handles.size(); }
+
+		static double benchmark( uint32_t _count = 100000, uint32_t _frames = 10 );
+
+	private:
+		void sort();
+		void updateRange( size_t _begin, size_t _end, std::vector< tHandle >& _changed );
+		bool updateIndex( uint32_t _index, uint32_t _parent_index );
+		void markDirty( uint32_t _index );
+
+		std::vector< uint32_t > m_indices;
+		std::vector< tHandle >  m_parents;
+		std::vector< tHandle >  m_free;
+		std::vector< tHandle >  m_destroyed;
+
+		std::vector< glm::vec3 > m_translations;
+		std::vector< glm::quat > m_rotations;
+		std::vector< glm::vec3 > m_scales;
+		std::vector< glm::mat4 > m_local;
+		std::vector< glm::mat4 > m_world;
+		std::vector< uint32_t >  m_parent_indices;
+		std::vector< tHandle >   m_handles;
+		std::vector< uint32_t >  m_versions;
+		std::vector< uint32_t >  m_parent_versions;
+		std::vector< uint8_t >   m_dirty;
+		std::vector< uint32_t >  m_levels;
+		std::vector< tHandle >   m_chain;
+
+		std::mutex             m_changed_mutex;
+		std::vector< tHandle > m_changing;
+		std::vector< tHandle > m_changed;
+
+		bool m_sorted;
+		bool m_has_dirty;
+	};
+}
@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <limits>
+
+namespace df
+{
+	struct sBoundingBox
+	{
+		void expand( const glm::vec3& _point )
+		{
+			min = glm::min( min, _point );
+			max = glm::max( max, _point );
+		}
+
+		void expand( const sBoundingBox& _other )
+		{
+			min = glm::min( min, _other.min );
+			max = glm::max( max, _other.max );
+		}
+
+		sBoundingBox transform( const glm::mat4& _matrix ) const
+		{
+			const glm::vec3 center = _matrix * glm::vec4( getCenter(), 1 );
+			const glm::vec3 extent = getExtent();
+
+			glm::vec3 world_extent( 0 );
+			for( int i = 0; i < 3; ++i )
+				world_extent += glm::abs( glm::vec3( _matrix[ i ] ) ) * extent[ i ];
+
+			return sBoundingBox{ .min = center - world_extent, .max = center + world_extent };
+		}
+
+		bool      isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+		glm::vec3 getCenter() const { return ( min + max ) * .5f; }
+		glm::vec3 getExtent() const { return ( max - min ) * .5f; }
+		float     getRadius() const { return length( getExtent() ); }
+
+		glm::vec3 min = glm::vec3( std::numeric_limits< float >::max() );
+		glm::vec3 max = glm::vec3( std::numeric_limits< float >::lowest() );
+	};
+}
@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include <array>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+#include "engine/misc/sBoundingBox.h"
+
+namespace df
+{
+	struct sFrustum
+	{
+		explicit sFrustum( const glm::mat4& _view_projection )
+		{
+			const glm::vec4 x( _view_projection[ 0 ][ 0 ], _view_projection[ 1 ][ 0 ], _view_projection[ 2 ][ 0 ], _view_projection[ 3 ][ 0 ] );
+			const glm::vec4 y( _view_projection[ 0 ][ 1 ], _view_projection[ 1 ][ 1 ], _view_projection[ 2 ][ 1 ], _view_projection[ 3 ][ 1 ] );
+			const glm::vec4 z( _view_projection[ 0 ][ 2 ], _view_projection[ 1 ][ 2 ], _view_projection[ 2 ][ 2 ], _view_projection[ 3 ][ 2 ] );
+			const glm::vec4 w( _view_projection[ 0 ][ 3 ], _view_projection[ 1 ][ 3 ], _view_projection[ 2 ][ 3 ], _view_projection[ 3 ][ 3 ] );
+
+			planes = { w + x, w - x, w + y, w - y, w + z, w - z };
+		}
+
+		bool intersects( const sBoundingBox& _bounds ) const
+		{
+			for( const glm::vec4& plane: planes )
+			{
+				const glm::vec3 positive( plane.x > 0 ? _bounds.max.x : _bounds.min.x, plane.y > 0 ? _bounds.max.y : _bounds.min.y, plane.z > 0 ? _bounds.max.z : _bounds.min.z );
+
+				if( dot( glm::vec3( plane ), positive ) + plane.w < 0 )
+					return false;
+			}
+
+			return true;
+		}
+
+		std::array< glm::vec4, 6 > planes;
+	};
+}
@@ -30,7 +30,6 @@ namespace df
 		explicit iRenderAsset( std::string _name );
 		~iRenderAsset() override;
 
-		void update( float /*_delta_time*/ = 0 ) override { transform->update(); }
 		void render() override = 0;
 
 		cTransform*      transform;
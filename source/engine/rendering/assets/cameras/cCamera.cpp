@@ -32,6 +32,8 @@ namespace df
 	{
 		ZoneScoped;
 
+		cEventManager::unsubscribe( event::on_window_resize, this );
+
 		delete transform;
 	}
 
@@ -41,7 +43,7 @@ namespace df
 
 		transform->update();
 
-		view = inverse( transform->world );
+		view = inverse( transform->getWorld() );
 
 		view_projection = type == ePerspective ? projection * view : projection;
 	}
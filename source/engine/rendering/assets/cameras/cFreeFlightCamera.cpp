@@ -24,18 +24,15 @@ namespace df
 		if( m_movement.x != 0.f || m_movement.z != 0.f )
 		{
 			const glm::vec3 normalized_movement  = normalize( m_movement );
-			m_position                          += glm::vec3( transform->world[ 0 ] ) * normalized_movement.x * m_speed * m_speed_multiplier * _delta_time;
-			m_position                          += glm::vec3( transform->world[ 2 ] ) * normalized_movement.z * m_speed * m_speed_multiplier * _delta_time;
+			m_position                          += glm::vec3( transform->getWorld()[ 0 ] ) * normalized_movement.x * m_speed * m_speed_multiplier * _delta_time;
+			m_position                          += glm::vec3( transform->getWorld()[ 2 ] ) * normalized_movement.z * m_speed * m_speed_multiplier * _delta_time;
 		}
 
 		const glm::quat yaw_quaternion   = angleAxis( glm::radians( m_rotation.x ), glm::vec3( 1, 0, 0 ) );
 		const glm::quat pitch_quaternion = angleAxis( glm::radians( m_rotation.y ), glm::vec3( 0, 1, 0 ) );
-		const glm::mat4 rotation( mat4_cast( pitch_quaternion * yaw_quaternion ) );
 
-		glm::mat4 translation( 1 );
-		translation = translate( translation, m_position );
-
-		transform->local = translation * rotation;
+		transform->setTranslation( m_position );
+		transform->setRotation( pitch_quaternion * yaw_quaternion );
 
 		cCamera::update();
 	}
@@ -33,6 +33,7 @@ namespace df
 			{
 				const aiVector3D& ai_vertex = _mesh->mVertices[ i ];
 				vertex.position             = { ai_vertex.x, ai_vertex.y, ai_vertex.z };
+				m_bounds.expand( vertex.position );
 			}
 
 			if( _mesh->mNormals )
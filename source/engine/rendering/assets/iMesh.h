@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "AssetTypes.h"
+#include "engine/misc/sBoundingBox.h"
 
 struct aiScene;
 struct aiMesh;
@@ -33,6 +34,7 @@ namespace df
 		const std::vector< sVertex >&                         getVertices() const { return m_vertices; }
 		const std::vector< unsigned >&                        getIndices() const { return m_indices; }
 		const std::unordered_map< aiTextureType, iTexture* >& getTextures() const { return m_textures; }
+		const sBoundingBox&                                   getBounds() const { return m_bounds; }
 
 	protected:
 		void         createVertices( const aiMesh* _mesh );
@@ -42,6 +44,7 @@ namespace df
 		std::vector< sVertex >                         m_vertices;
 		std::vector< unsigned >                        m_indices;
 		std::unordered_map< aiTextureType, iTexture* > m_textures;
+		sBoundingBox                                   m_bounds;
 
 		iModel* m_parent;
 	};
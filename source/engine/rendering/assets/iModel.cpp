@@ -2,6 +2,7 @@
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
+#include <fmt/format.h>
 #include <ranges>
 #include <tracy/Tracy.hpp>
 #include <utility>
@@ -15,6 +16,7 @@ namespace df
 {
 	iModel::iModel( std::string _name )
 		: iRenderAsset( std::move( _name ) )
+		, m_load_flags( 0 )
 	{}
 
 	iModel::~iModel()
@@ -33,22 +35,28 @@ namespace df
 		ZoneScoped;
 
 		for( iMesh* mesh: meshes )
-		{
-			if( !mesh->render_callback )
-				mesh->render_callback = render_callback;
+			renderMesh( mesh );
+	}
+
+	void iModel::renderMesh( iMesh* _mesh )
+	{
+		ZoneScoped;
 
-			mesh->render();
+		if( !_mesh->render_callback )
+			_mesh->render_callback = render_callback;
 
-			if( mesh->render_callback == render_callback )
-				mesh->render_callback = nullptr;
-		}
+		_mesh->render();
+
+		if( _mesh->render_callback == render_callback )
+			_mesh->render_callback = nullptr;
 	}
 
 	bool iModel::load( const std::string& _folder_path, const unsigned _load_flags )
 	{
 		ZoneScoped;
 
-		folder = filesystem::getPath( _folder_path );
+		folder       = filesystem::getPath( _folder_path );
+		m_load_flags = _load_flags;
 
 		Assimp::Importer importer;
 
@@ -80,7 +88,39 @@ namespace df
 				return processNode( scene->mRootNode, scene );
 		}
 
-		DF_LOG_ERROR( importer.GetErrorString() );
+		DF_LOG_ERROR( "{}", importer.GetErrorString() );
 		return false;
 	}
+
+	bool iModel::reload()
+	{
+		ZoneScoped;
+
+		std::vector< iMesh* >                        old_meshes   = std::move( meshes );
+		std::unordered_map< std::string, iTexture* > old_textures = std::move( textures );
+		meshes.clear();
+		textures.clear();
+
+		const bool loaded = load( folder, m_load_flags );
+
+		std::vector< iMesh* >&                        discarded_meshes   = loaded ? old_meshes : meshes;
+		std::unordered_map< std::string, iTexture* >& discarded_textures = loaded ? old_textures : textures;
+
+		for( const iTexture* texture: discarded_textures | std::views::values )
+			delete texture;
+
+		for( const iMesh* mesh: discarded_meshes )
+			delete mesh;
+
+		if( !loaded )
+		{
+			meshes   = std::move( old_meshes );
+			textures = std::move( old_textures );
+			DF_LOG_WARNING( "Failed to reload model: {}", name );
+			return false;
+		}
+
+		DF_LOG_MESSAGE( "Reloaded model: {}", name );
+		return true;
+	}
 }
@@ -25,14 +25,18 @@ namespace df
 		~iModel() override;
 
 		void render() override;
+		void renderMesh( iMesh* _mesh );
 
 		bool load( const std::string& _folder_path, unsigned _load_flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices );
+		bool reload();
 
 		std::vector< iMesh* >                        meshes;
 		std::string                                  folder;
 		std::unordered_map< std::string, iTexture* > textures;
 
 	protected:
+		unsigned m_load_flags;
+
 		virtual bool processNode( const aiNode* _node, const aiScene* _scene ) = 0;
 	};
 }
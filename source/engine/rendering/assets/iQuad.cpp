@@ -1,7 +1,5 @@
 ﻿#include "iQuad.h"
 
-#include <glm/ext/matrix_transform.hpp>
-
 #include "engine/managers/cRenderCallbackManager.h"
 #include "engine/rendering/assets/iTexture.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
@@ -16,7 +14,7 @@ namespace df
 	{
 		ZoneScoped;
 
-		transform->local = translate( transform->world, _position );
+		transform->setTranslation( _position );
 		transform->update();
 
 		m_vertices.emplace_back( glm::vec3( _size.x / 2, _size.y / 2, 0 ), glm::vec2( 1, 1 ) );
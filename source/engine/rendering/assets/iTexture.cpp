@@ -1,8 +1,24 @@
 ﻿#include "iTexture.h"
 
+#include <tracy/Tracy.hpp>
+
 namespace df
 {
 	iTexture::iTexture( std::string _name )
 		: name( std::move( _name ) )
+		, m_mipmapped( false )
+		, m_mipmaps( 0 )
+		, m_flip_vertically_on_load( true )
 	{}
+
+	bool iTexture::reload()
+	{
+		ZoneScoped;
+
+		if( m_file_path.empty() )
+			return false;
+
+		const std::string file_path = m_file_path;
+		return load( file_path, m_mipmapped, m_mipmaps, m_flip_vertically_on_load );
+	}
 }
@@ -19,9 +19,16 @@ namespace df
 		virtual void bind( int /*_index*/ = 0 )   = 0;
 		virtual void unbind( int /*_index*/ = 0 ) = 0;
 
+		bool reload();
+
+		const std::string& getFilePath() const { return m_file_path; }
+
 		std::string name;
 
 	protected:
 		std::string m_file_path;
+		bool        m_mipmapped;
+		int         m_mipmaps;
+		bool        m_flip_vertically_on_load;
 	};
 }
@@ -18,6 +18,8 @@ namespace df
 
 		virtual ~iRenderCallback() = default;
 
+		virtual bool reloadShader( const std::string& _shader_name ) = 0;
+
 		const std::string name;
 	};
 
@@ -35,6 +37,8 @@ namespace df
 
 		~cRenderCallback() override;
 
+		bool reloadShader( const std::string& _shader_name ) override;
+
 		void render( Targs... _args );
 
 	protected:
@@ -93,6 +97,18 @@ namespace df
 			delete data;
 	}
 
+	template< typename T, typename... Targs >
+	bool cRenderCallback< T, Targs... >::reloadShader( const std::string& _shader_name )
+	{
+		ZoneScoped;
+
+		bool reloaded = false;
+		for( T* data: m_data )
+			reloaded |= data->reloadShader( _shader_name );
+
+		return reloaded;
+	}
+
 	template< typename T, typename... Targs >
 	void cRenderCallback< T, Targs... >::render( Targs... _args )
 	{
@@ -36,10 +36,16 @@ namespace df
 		if( m_is_deferred )
 			m_instance->initializeDeferred();
 
+		const cMappedFile icon_file = filesystem::mapFile( "window.png" );
+
 		int       channels;
 		GLFWimage icon;
-		icon.pixels = stbi_load( filesystem::getPath( "window.png" ).data(), &icon.width, &icon.height, &channels, 4 );
-		glfwSetWindowIcon( m_instance->getWindow(), 1, &icon );
+		icon.pixels = stbi_load_from_memory( icon_file.getData().data(), static_cast< int >( icon_file.getSize() ), &icon.width, &icon.height, &channels, 4 );
+		if( icon.pixels )
+		{
+			glfwSetWindowIcon( m_instance->getWindow(), 1, &icon );
+			stbi_image_free( icon.pixels );
+		}
 	}
 
 	cRenderer::~cRenderer()
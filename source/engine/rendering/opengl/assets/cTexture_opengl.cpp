@@ -35,13 +35,16 @@ namespace df::opengl
 	{
 		ZoneScoped;
 
+		const cMappedFile file = filesystem::mapFile( _file );
+
 		stbi_set_flip_vertically_on_load( _flip_vertically_on_load );
 		int            width, height, nr_channels;
-		unsigned char* data = stbi_load( filesystem::getPath( _file ).data(), &width, &height, &nr_channels, STBI_rgb_alpha );
+		unsigned char* data = file.getSize() ? stbi_load_from_memory( file.getData().data(), static_cast< int >( file.getSize() ), &width, &height, &nr_channels, STBI_rgb_alpha )
+		                                     : nullptr;
 
 		if( !data )
 		{
-			DF_LOG_WARNING( fmt::format( "Failed to load texture: {}", _file ) );
+			DF_LOG_WARNING( "Failed to load texture: {}", _file );
 			return false;
 		}
 
@@ -53,7 +56,10 @@ namespace df::opengl
 
 		unbind();
 		stbi_image_free( data );
-		m_file_path = _file;
+		m_file_path               = _file;
+		m_mipmapped               = _mipmapped;
+		m_mipmaps                 = _mipmaps;
+		m_flip_vertically_on_load = _flip_vertically_on_load;
 		return true;
 	}
 
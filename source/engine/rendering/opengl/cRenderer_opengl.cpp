@@ -33,7 +33,7 @@ namespace df::opengl
 			DF_LOG_ERROR( "Failed to create window" );
 			return;
 		}
-		DF_LOG_MESSAGE( fmt::format( "Created window [{}, {}]", m_window_size.x, m_window_size.y ) );
+		DF_LOG_MESSAGE( "Created window [{}, {}]", m_window_size.x, m_window_size.y );
 
 		glfwMakeContextCurrent( m_window );
 		glfwSwapInterval( 0 );
@@ -296,44 +296,50 @@ namespace df::opengl
 		{
 			case GL_DEBUG_SEVERITY_HIGH:
 			{
-				DF_LOG_ERROR( fmt::format( "OpenGL, "
-				                           "Source: {}, "
-				                           "Type: {}, "
-				                           "ID: {}, "
-				                           "Severity: High, "
-				                           "Message: {}",
-				                           source,
-				                           type,
-				                           _id,
-				                           _message ) );
+				DF_LOG( df::log::eError,
+				        df::log::eRendering,
+				        "OpenGL, "
+				        "Source: {}, "
+				        "Type: {}, "
+				        "ID: {}, "
+				        "Severity: High, "
+				        "Message: {}",
+				        source,
+				        type,
+				        _id,
+				        _message );
 			}
 			break;
 			case GL_DEBUG_SEVERITY_MEDIUM:
 			{
-				DF_LOG_WARNING( fmt::format( "OpenGL, "
-				                             "Source: {}, "
-				                             "Type: {}, "
-				                             "ID: {}, "
-				                             "Severity: Medium, "
-				                             "Message: {}",
-				                             source,
-				                             type,
-				                             _id,
-				                             _message ) );
+				DF_LOG( df::log::eWarning,
+				        df::log::eRendering,
+				        "OpenGL, "
+				        "Source: {}, "
+				        "Type: {}, "
+				        "ID: {}, "
+				        "Severity: Medium, "
+				        "Message: {}",
+				        source,
+				        type,
+				        _id,
+				        _message );
 			}
 			break;
 			case GL_DEBUG_SEVERITY_LOW:
 			{
-				DF_LOG_WARNING( fmt::format( "OpenGL, "
-				                             "Source: {}, "
-				                             "Type: {}, "
-				                             "ID: {}, "
-				                             "Severity: Low, "
-				                             "Message: {}",
-				                             source,
-				                             type,
-				                             _id,
-				                             _message ) );
+				DF_LOG( df::log::eWarning,
+				        df::log::eRendering,
+				        "OpenGL, "
+				        "Source: {}, "
+				        "Type: {}, "
+				        "ID: {}, "
+				        "Severity: Low, "
+				        "Message: {}",
+				        source,
+				        type,
+				        _id,
+				        _message );
 			}
 			break;
 			default:
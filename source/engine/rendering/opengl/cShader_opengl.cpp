@@ -16,28 +16,7 @@ namespace df::opengl
 	{
 		ZoneScoped;
 
-		const unsigned vertex   = compileShader( fmt::format( "{}.vert", name ), GL_VERTEX_SHADER );
-		const unsigned fragment = compileShader( fmt::format( "{}.frag", name ), GL_FRAGMENT_SHADER );
-
-		m_program = glCreateProgram();
-		glAttachShader( m_program, vertex );
-		glAttachShader( m_program, fragment );
-		glLinkProgram( m_program );
-
-		int success;
-		glGetProgramiv( m_program, GL_LINK_STATUS, &success );
-
-		if( success )
-			DF_LOG_MESSAGE( fmt::format( "Successfully linked shader program: {}", name ) );
-		else
-		{
-			char info_log[ 512 ];
-			glGetProgramInfoLog( m_program, 512, nullptr, info_log );
-			DF_LOG_ERROR( fmt::format( "Failed to link shader program: {} - {}", name, info_log ) );
-		}
-
-		glDeleteShader( vertex );
-		glDeleteShader( fragment );
+		m_program = createProgram();
 	}
 
 	cShader_opengl::~cShader_opengl()
@@ -54,6 +33,25 @@ namespace df::opengl
 		glUseProgram( m_program );
 	}
 
+	bool cShader_opengl::reloadShader( const std::string& _shader_name )
+	{
+		ZoneScoped;
+
+		if( _shader_name != fmt::format( "{}.vert", name ) && _shader_name != fmt::format( "{}.frag", name ) )
+			return false;
+
+		const unsigned program = createProgram();
+		if( !program )
+		{
+			DF_LOG_WARNING( "Failed to reload shader: {}, keeping program: {}", _shader_name, name );
+			return false;
+		}
+
+		glDeleteProgram( m_program );
+		m_program = program;
+		return true;
+	}
+
 	void cShader_opengl::setUniform1B( const std::string& _name, const bool& _value ) const
 	{
 		ZoneScoped;
@@ -96,6 +94,38 @@ namespace df::opengl
 		glUniformMatrix4fv( glGetUniformLocation( m_program, _name.data() ), _amount, _transpose, value_ptr( _matrix ) );
 	}
 
+	unsigned cShader_opengl::createProgram() const
+	{
+		ZoneScoped;
+
+		const unsigned vertex   = compileShader( fmt::format( "{}.vert", name ), GL_VERTEX_SHADER );
+		const unsigned fragment = compileShader( fmt::format( "{}.frag", name ), GL_FRAGMENT_SHADER );
+
+		unsigned program = glCreateProgram();
+		glAttachShader( program, vertex );
+		glAttachShader( program, fragment );
+		glLinkProgram( program );
+
+		int success;
+		glGetProgramiv( program, GL_LINK_STATUS, &success );
+
+		if( success )
+			DF_LOG_MESSAGE( "Successfully linked shader program: {}", name );
+		else
+		{
+			char info_log[ 512 ];
+			glGetProgramInfoLog( program, 512, nullptr, info_log );
+			DF_LOG_ERROR( "Failed to link shader program: {} - {}", name, info_log );
+
+			glDeleteProgram( program );
+			program = 0;
+		}
+
+		glDeleteShader( vertex );
+		glDeleteShader( fragment );
+		return program;
+	}
+
 	unsigned cShader_opengl::compileShader( const std::string& _name, const int& _type )
 	{
 		ZoneScoped;
@@ -111,12 +141,12 @@ namespace df::opengl
 		glGetShaderiv( shader_id, GL_COMPILE_STATUS, &success );
 
 		if( success )
-			DF_LOG_MESSAGE( fmt::format( "Successfully compiled shader: {}", _name ) );
+			DF_LOG_MESSAGE( "Successfully compiled shader: {}", _name );
 		else
 		{
 			char info_log[ 512 ];
 			glGetShaderInfoLog( shader_id, 512, nullptr, info_log );
-			DF_LOG_ERROR( fmt::format( "Failed to compile shader: {} - {}", _name, info_log ) );
+			DF_LOG_ERROR( "Failed to compile shader: {} - {}", _name, info_log );
 		}
 
 		return shader_id;
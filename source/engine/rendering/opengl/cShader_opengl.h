@@ -19,6 +19,8 @@ namespace df::opengl
 
 		void use() const;
 
+		bool reloadShader( const std::string& _shader_name );
+
 		void setUniform1B( const std::string& _name, const bool& _value ) const;
 		void setUniform1I( const std::string& _name, const int& _value ) const;
 		void setUniform1F( const std::string& _name, const float& _value ) const;
@@ -31,6 +33,7 @@ namespace df::opengl
 		void setUniformSampler( const std::string& _name, const int& _sampler ) const { setUniform1I( _name, _sampler ); }
 
 	private:
+		unsigned        createProgram() const;
 		static unsigned compileShader( const std::string& _name, const int& _type );
 
 		unsigned m_program;
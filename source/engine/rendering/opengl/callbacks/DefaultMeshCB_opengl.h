@@ -19,7 +19,7 @@ namespace df::opengl::render_callback
 
 		_shader->use();
 
-		_shader->setUniformMatrix4F( "u_world_matrix", _mesh->transform->world );
+		_shader->setUniformMatrix4F( "u_world_matrix", _mesh->transform->getWorld() );
 		_shader->setUniformMatrix4F( "u_view_projection_matrix", camera->view_projection );
 
 		_shader->setUniformSampler( "u_color_texture", 0 );
@@ -56,7 +56,7 @@ namespace df::opengl::render_callback
 
 		_shader->use();
 
-		_shader->setUniformMatrix4F( "u_world_matrix", _mesh->transform->world );
+		_shader->setUniformMatrix4F( "u_world_matrix", _mesh->transform->getWorld() );
 		_shader->setUniformMatrix4F( "u_view_projection_matrix", camera->view_projection );
 
 		_shader->setUniformSampler( "u_color_texture", 0 );
@@ -22,7 +22,7 @@ namespace df::opengl::render_callback
 
 		_shader->use();
 
-		_shader->setUniformMatrix4F( "u_world_matrix", _quad->transform->world );
+		_shader->setUniformMatrix4F( "u_world_matrix", _quad->transform->getWorld() );
 		_shader->setUniformMatrix4F( "u_view_projection_matrix", camera->view_projection );
 
 		_shader->setUniform4F( "u_color", _quad->color );
@@ -50,7 +50,7 @@ namespace df::opengl::render_callback
 
 		_shader->use();
 
-		_shader->setUniformMatrix4F( "u_world_matrix", _quad->transform->world );
+		_shader->setUniformMatrix4F( "u_world_matrix", _quad->transform->getWorld() );
 		_shader->setUniformMatrix4F( "u_view_projection_matrix", camera->view_projection );
 
 		_shader->setUniformSampler( "u_position_texture", 0 );
@@ -1,17 +1,21 @@
 ﻿#include "cMesh_vulkan.h"
 
+#include <algorithm>
 #include <assimp/material.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
 #include <filesystem>
+#include <glm/geometric.hpp>
+#include <ranges>
 
 #include "cModel_vulkan.h"
 #include "cTexture_vulkan.h"
+#include "engine/managers/assets/cCameraManager.h"
 #include "engine/managers/assets/cModelManager.h"
 #include "engine/managers/cRenderCallbackManager.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
-#include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 #include "engine/rendering/vulkan/pipeline/cPipeline_vulkan.h"
 
 namespace df::vulkan
@@ -25,40 +29,24 @@ namespace df::vulkan
 
 		cMesh_vulkan::createTextures( _mesh, _scene );
 
-		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
-
-		const size_t vertex_buffer_size = sizeof( *m_vertices.data() ) * m_vertices.size();
-		const size_t index_buffer_size  = sizeof( *m_indices.data() ) * m_indices.size();
-
-		vertex_buffer = helper::util::createBuffer( vertex_buffer_size,
-		                                            vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst,
-		                                            vma::MemoryUsage::eGpuOnly );
-		index_buffer  = helper::util::createBuffer( index_buffer_size, vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst, vma::MemoryUsage::eGpuOnly );
-
-		sAllocatedBuffer_vulkan staging_buffer = helper::util::createBuffer( vertex_buffer_size + index_buffer_size,
-		                                                                     vk::BufferUsageFlagBits::eTransferSrc,
-		                                                                     vma::MemoryUsage::eCpuOnly );
-
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( staging_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, m_vertices.data(), vertex_buffer_size );
-		std::memcpy( static_cast< char* >( data_dst ) + vertex_buffer_size, m_indices.data(), index_buffer_size );
-		renderer->getMemoryAllocator().unmapMemory( staging_buffer.allocation.get() );
+		geometry = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )
+		               ->getGeometryArena()
+		               ->allocate( m_vertices.data(), static_cast< uint32_t >( m_vertices.size() ), m_indices.data(), static_cast< uint32_t >( m_indices.size() ) );
+	}
 
-		renderer->immediateSubmit(
-			[ & ]( const vk::CommandBuffer _command_buffer )
-			{
-				const vk::BufferCopy vertex_copy( 0, 0, vertex_buffer_size );
-				_command_buffer.copyBuffer( staging_buffer.buffer.get(), vertex_buffer.buffer.get(), 1, &vertex_copy );
+	cMesh_vulkan::~cMesh_vulkan()
+	{
+		ZoneScoped;
 
-				const vk::BufferCopy index_copy( vertex_buffer_size, 0, index_buffer_size );
-				_command_buffer.copyBuffer( staging_buffer.buffer.get(), index_buffer.buffer.get(), 1, &index_copy );
-			} );
+		reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getGeometryArena()->free( geometry );
 	}
 
 	void cMesh_vulkan::render()
 	{
 		ZoneScoped;
 
+		requestTextureMips();
+
 		if( cModelManager::getForcedRenderCallback() )
 			cRenderCallbackManager::render< cPipeline_vulkan >( cModelManager::getForcedRenderCallback(), this );
 		else if( render_callback )
@@ -67,6 +55,34 @@ namespace df::vulkan
 			cRenderCallbackManager::render< cPipeline_vulkan >( cModelManager::getDefaultRenderCallback(), this );
 	}
 
+	void cMesh_vulkan::requestTextureMips() const
+	{
+		ZoneScoped;
+
+		const cCamera* camera = cCameraManager::getInstance()->current;
+		if( !camera || !m_bounds.isValid() )
+			return;
+
+		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		const float             height   = static_cast< float >( renderer->getRenderExtent().height );
+
+		const glm::mat4  world  = transform->getWorld();
+		const float      scale  = std::max( { length( glm::vec3( world[ 0 ] ) ), length( glm::vec3( world[ 1 ] ) ), length( glm::vec3( world[ 2 ] ) ) } );
+		const float      radius = m_bounds.getRadius() * scale;
+
+		float pixels = radius * 2;
+		if( camera->type == cCamera::ePerspective )
+		{
+			const glm::vec3 center   = world * glm::vec4( m_bounds.getCenter(), 1 );
+			const float     distance = length( center - glm::vec3( camera->transform->getWorld()[ 3 ] ) );
+
+			pixels = distance > radius ? radius / distance * std::abs( camera->projection[ 1 ][ 1 ] ) * height : height;
+		}
+
+		for( iTexture* texture: m_textures | std::views::values )
+			reinterpret_cast< cTexture_vulkan* >( texture )->requestScreenSize( pixels );
+	}
+
 	void cMesh_vulkan::createTextures( const aiMesh* _mesh, const aiScene* _scene )
 	{
 		ZoneScoped;
@@ -90,7 +106,7 @@ namespace df::vulkan
 				}
 
 				cTexture_vulkan* texture = new cTexture_vulkan( texture_name );
-				if( !texture->load( full_path ) )
+				if( !texture->load( full_path, true ) )
 				{
 					delete texture;
 					continue;
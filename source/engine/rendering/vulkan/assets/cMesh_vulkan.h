@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "engine/rendering/assets/iMesh.h"
+#include "engine/rendering/vulkan/cGeometryArena_vulkan.h"
 #include "sRenderAsset_vulkan.h"
 
 struct aiScene;
@@ -19,17 +20,17 @@ namespace df::vulkan
 
 		friend cModel_vulkan;
 
-		struct sPushConstants
-		{
-			glm::mat4 world_matrix;
-		};
-
 		explicit cMesh_vulkan( const aiMesh* _mesh, const aiScene* _scene, cModel_vulkan* _parent );
+		~cMesh_vulkan() override;
 
 		void render() override;
 
+		void requestTextureMips() const;
+
 		vk::DescriptorSetLayout getTextureLayout() const { return s_texture_layout.get(); }
 
+		cGeometryArena_vulkan::sAllocation geometry;
+
 	private:
 		void createTextures( const aiMesh* _mesh, const aiScene* _scene ) override;
 
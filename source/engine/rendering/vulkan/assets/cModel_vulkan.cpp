@@ -10,8 +10,9 @@
 #include "engine/managers/cRenderCallbackManager.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/callbacks/DefaultMeshCB_vulkan.h"
+#include "engine/rendering/vulkan/cBindlessTextures_vulkan.h"
+#include "engine/rendering/vulkan/cGpuCulling_vulkan.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
-#include "engine/rendering/vulkan/descriptor/sDescriptorLayoutBuilder_vulkan.h"
 #include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 #include "engine/rendering/vulkan/pipeline/sPipelineCreateInfo_vulkan.h"
 
@@ -35,39 +36,33 @@ namespace df::vulkan
 
 		sPipelineCreateInfo_vulkan pipeline_create_info{ .name = "default_mesh_ambient" };
 
-		pipeline_create_info.vertex_input_binding.emplace_back( 0, static_cast< uint32_t >( sizeof( iMesh::sVertex ) ), vk::VertexInputRate::eVertex );
-
-		pipeline_create_info.vertex_input_attribute.emplace_back( 0,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::position ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 1,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::normal ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 2,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tangent ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 3,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::bitangent ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 4,
-		                                                          0,
-		                                                          vk::Format::eR32G32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tex_coords ) ) );
-
-		pipeline_create_info.push_constant_ranges.emplace_back( vk::ShaderStageFlagBits::eVertex, 0, static_cast< uint32_t >( sizeof( cMesh_vulkan::sPushConstants ) ) );
-
-		sDescriptorLayoutBuilder_vulkan descriptor_layout_builder{};
-		descriptor_layout_builder.addBinding( 0, vk::DescriptorType::eCombinedImageSampler );
-		cMesh_vulkan::s_texture_layout = descriptor_layout_builder.build( vk::ShaderStageFlagBits::eFragment );
-
-		pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
-		pipeline_create_info.descriptor_layouts.push_back( cMesh_vulkan::s_texture_layout.get() );
-
-		pipeline_create_info.setShaders( helper::util::createShaderModule( "default_mesh_ambient.vert" ), helper::util::createShaderModule( "default_mesh_ambient.frag" ) );
+		if( const cBindlessTextures_vulkan* bindless_textures = renderer->getBindlessTextures() )
+		{
+			pipeline_create_info.setShaders( "default_mesh_ambient.vert", "default_mesh_ambient_bindless.frag" );
+
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( bindless_textures->getLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getObjectLayout() );
+		}
+		else
+		{
+			pipeline_create_info.setShaders( "default_mesh_ambient.vert", "default_mesh_ambient.frag" );
+
+			cMesh_vulkan::s_texture_layout = pipeline_create_info.createDescriptorLayout( 1 );
+
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( cMesh_vulkan::s_texture_layout.get() );
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getObjectLayout() );
+		}
+
+		const std::vector< uint32_t > vertex_offsets = {
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::position ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::normal ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tangent ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::bitangent ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tex_coords ) ),
+		};
+		pipeline_create_info.setVertexInput( static_cast< uint32_t >( sizeof( iMesh::sVertex ) ), vertex_offsets );
 		pipeline_create_info.setInputTopology( vk::PrimitiveTopology::eTriangleList );
 		pipeline_create_info.setpolygonMode( vk::PolygonMode::eFill );
 		pipeline_create_info.setCullMode( vk::CullModeFlagBits::eNone, vk::FrontFace::eClockwise );
@@ -77,6 +72,12 @@ namespace df::vulkan
 		pipeline_create_info.enableDepthtest( true, vk::CompareOp::eLessOrEqual );
 		pipeline_create_info.disableBlending();
 
+		if( cGpuCulling_vulkan* gpu_culling = renderer->getGpuCulling() )
+			gpu_culling->setRenderCallback( cRenderCallbackManager::create( "default_mesh_gpu_culled", pipeline_create_info, render_callback::defaultMeshGpuCulled ) );
+
+		if( renderer->getBindlessTextures() )
+			return cRenderCallbackManager::create( "default_mesh", pipeline_create_info, render_callback::defaultMeshBindless );
+
 		return cRenderCallbackManager::create( "default_mesh", pipeline_create_info, render_callback::defaultMesh );
 	}
 
@@ -85,6 +86,9 @@ namespace df::vulkan
 		ZoneScoped;
 
 		cMesh_vulkan::s_texture_layout.reset();
+
+		if( cGpuCulling_vulkan* gpu_culling = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getGpuCulling() )
+			gpu_culling->setRenderCallback( nullptr );
 	}
 
 	bool cModel_vulkan::processNode( const aiNode* _node, const aiScene* _scene )
@@ -111,41 +115,33 @@ namespace df::vulkan
 
 		sPipelineCreateInfo_vulkan pipeline_create_info{ .name = "default_mesh_deferred" };
 
-		pipeline_create_info.vertex_input_binding.emplace_back( 0, static_cast< uint32_t >( sizeof( iMesh::sVertex ) ), vk::VertexInputRate::eVertex );
-
-		pipeline_create_info.vertex_input_attribute.emplace_back( 0,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::position ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 1,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::normal ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 2,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tangent ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 3,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::bitangent ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 4,
-		                                                          0,
-		                                                          vk::Format::eR32G32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tex_coords ) ) );
-
-		pipeline_create_info.push_constant_ranges.emplace_back( vk::ShaderStageFlagBits::eVertex, 0, static_cast< uint32_t >( sizeof( cMesh_vulkan::sPushConstants ) ) );
-
-		sDescriptorLayoutBuilder_vulkan descriptor_layout_builder{};
-		descriptor_layout_builder.addBinding( 0, vk::DescriptorType::eCombinedImageSampler );
-		descriptor_layout_builder.addBinding( 1, vk::DescriptorType::eCombinedImageSampler );
-		descriptor_layout_builder.addBinding( 2, vk::DescriptorType::eCombinedImageSampler );
-		cMesh_vulkan::s_texture_layout = descriptor_layout_builder.build( vk::ShaderStageFlagBits::eFragment );
-
-		pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
-		pipeline_create_info.descriptor_layouts.push_back( cMesh_vulkan::s_texture_layout.get() );
-
-		pipeline_create_info.setShaders( helper::util::createShaderModule( "default_mesh_deferred.vert" ), helper::util::createShaderModule( "default_mesh_deferred.frag" ) );
+		if( const cBindlessTextures_vulkan* bindless_textures = renderer->getBindlessTextures() )
+		{
+			pipeline_create_info.setShaders( "default_mesh_deferred.vert", "default_mesh_deferred_bindless.frag" );
+
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( bindless_textures->getLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getObjectLayout() );
+		}
+		else
+		{
+			pipeline_create_info.setShaders( "default_mesh_deferred.vert", "default_mesh_deferred.frag" );
+
+			cMesh_vulkan::s_texture_layout = pipeline_create_info.createDescriptorLayout( 1 );
+
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
+			pipeline_create_info.descriptor_layouts.push_back( cMesh_vulkan::s_texture_layout.get() );
+			pipeline_create_info.descriptor_layouts.push_back( renderer->getObjectLayout() );
+		}
+
+		const std::vector< uint32_t > vertex_offsets = {
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::position ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::normal ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tangent ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::bitangent ) ),
+			static_cast< uint32_t >( offsetof( iMesh::sVertex, iMesh::sVertex::tex_coords ) ),
+		};
+		pipeline_create_info.setVertexInput( static_cast< uint32_t >( sizeof( iMesh::sVertex ) ), vertex_offsets );
 		pipeline_create_info.setInputTopology( vk::PrimitiveTopology::eTriangleList );
 		pipeline_create_info.setpolygonMode( vk::PolygonMode::eFill );
 		pipeline_create_info.setCullMode( vk::CullModeFlagBits::eNone, vk::FrontFace::eClockwise );
@@ -155,6 +151,12 @@ namespace df::vulkan
 		pipeline_create_info.enableDepthtest( true, vk::CompareOp::eLessOrEqual );
 		pipeline_create_info.disableBlending();
 
+		if( cGpuCulling_vulkan* gpu_culling = renderer->getGpuCulling() )
+			gpu_culling->setRenderCallback( cRenderCallbackManager::create( "default_mesh_gpu_culled", pipeline_create_info, render_callback::defaultMeshGpuCulled ) );
+
+		if( renderer->getBindlessTextures() )
+			return cRenderCallbackManager::create( "default_mesh", pipeline_create_info, render_callback::defaultMeshDeferredBindless );
+
 		return cRenderCallbackManager::create( "default_mesh", pipeline_create_info, render_callback::defaultMeshDeferred );
 	}
 }
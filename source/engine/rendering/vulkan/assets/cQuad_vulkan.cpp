@@ -1,12 +1,17 @@
 ﻿#include "cQuad_vulkan.h"
 
+#include <glm/common.hpp>
+#include <limits>
+
 #include "cTexture_vulkan.h"
+#include "engine/managers/assets/cCameraManager.h"
 #include "engine/managers/assets/cQuadManager.h"
 #include "engine/managers/cRenderCallbackManager.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/callbacks/DefaultQuadCB_vulkan.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
-#include "engine/rendering/vulkan/descriptor/sDescriptorLayoutBuilder_vulkan.h"
+#include "engine/rendering/vulkan/cUploadManager_vulkan.h"
 #include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 
 namespace df::vulkan
@@ -20,7 +25,7 @@ namespace df::vulkan
 
 		texture = new cTexture_vulkan( fmt::format( "{}_{}", name, "texture" ) );
 
-		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		cUploadManager_vulkan* upload_manager = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getUploadManager();
 
 		const size_t vertex_buffer_size = sizeof( *m_vertices.data() ) * m_vertices.size();
 		const size_t index_buffer_size  = sizeof( *m_indices.data() ) * m_indices.size();
@@ -30,24 +35,8 @@ namespace df::vulkan
 		                                            vma::MemoryUsage::eGpuOnly );
 		index_buffer  = helper::util::createBuffer( index_buffer_size, vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst, vma::MemoryUsage::eGpuOnly );
 
-		sAllocatedBuffer_vulkan staging_buffer = helper::util::createBuffer( vertex_buffer_size + index_buffer_size,
-		                                                                     vk::BufferUsageFlagBits::eTransferSrc,
-		                                                                     vma::MemoryUsage::eCpuOnly );
-
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( staging_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, m_vertices.data(), vertex_buffer_size );
-		std::memcpy( static_cast< char* >( data_dst ) + vertex_buffer_size, m_indices.data(), index_buffer_size );
-		renderer->getMemoryAllocator().unmapMemory( staging_buffer.allocation.get() );
-
-		renderer->immediateSubmit(
-			[ & ]( const vk::CommandBuffer _command_buffer )
-			{
-				const vk::BufferCopy vertex_copy( 0, 0, vertex_buffer_size );
-				_command_buffer.copyBuffer( staging_buffer.buffer.get(), vertex_buffer.buffer.get(), 1, &vertex_copy );
-
-				const vk::BufferCopy index_copy( vertex_buffer_size, 0, index_buffer_size );
-				_command_buffer.copyBuffer( staging_buffer.buffer.get(), index_buffer.buffer.get(), 1, &index_copy );
-			} );
+		upload_manager->uploadBuffer( vertex_buffer.buffer.get(), 0, m_vertices.data(), vertex_buffer_size );
+		upload_manager->uploadBuffer( index_buffer.buffer.get(), 0, m_indices.data(), index_buffer_size );
 	}
 
 	bool cQuad_vulkan::loadTexture( const std::string& _file_path, const bool _mipmapped, const int _mipmaps, const bool _flip_vertically_on_load )
@@ -61,6 +50,8 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
+		requestTextureMips();
+
 		if( cQuadManager::getForcedRenderCallback() )
 			cRenderCallbackManager::render< cPipeline_vulkan >( cQuadManager::getForcedRenderCallback(), this );
 		else if( render_callback )
@@ -69,6 +60,36 @@ namespace df::vulkan
 			cRenderCallbackManager::render< cPipeline_vulkan >( cQuadManager::getDefaultRenderCallback(), this );
 	}
 
+	void cQuad_vulkan::requestTextureMips() const
+	{
+		ZoneScoped;
+
+		const cCamera* camera = cCameraManager::getInstance()->current;
+		if( !texture || !camera )
+			return;
+
+		const vk::Extent2D extent = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getRenderExtent();
+		const glm::mat4    clip   = camera->view_projection * transform->getWorld();
+
+		glm::vec2 lower( std::numeric_limits< float >::max() );
+		glm::vec2 upper( std::numeric_limits< float >::lowest() );
+		for( const sVertex& vertex: m_vertices )
+		{
+			const glm::vec4 position = clip * glm::vec4( vertex.position, 1 );
+			if( position.w <= 0 )
+			{
+				reinterpret_cast< cTexture_vulkan* >( texture )->requestScreenSize( static_cast< float >( std::max( extent.width, extent.height ) ) );
+				return;
+			}
+
+			lower = glm::min( lower, glm::vec2( position ) / position.w );
+			upper = glm::max( upper, glm::vec2( position ) / position.w );
+		}
+
+		const glm::vec2 pixels = ( upper - lower ) * .5f * glm::vec2( extent.width, extent.height );
+		reinterpret_cast< cTexture_vulkan* >( texture )->requestScreenSize( std::max( pixels.x, pixels.y ) );
+	}
+
 	iRenderCallback* cQuad_vulkan::createDefaults()
 	{
 		ZoneScoped;
@@ -77,29 +98,19 @@ namespace df::vulkan
 
 		sPipelineCreateInfo_vulkan pipeline_create_info{ .name = "default_quad" };
 
-		pipeline_create_info.vertex_input_binding.emplace_back( 0, static_cast< uint32_t >( sizeof( sVertex ) ), vk::VertexInputRate::eVertex );
-
-		pipeline_create_info.vertex_input_attribute.emplace_back( 0,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iQuad::sVertex, iQuad::sVertex::position ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 1,
-		                                                          0,
-		                                                          vk::Format::eR32G32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( iQuad::sVertex, iQuad::sVertex::tex_coord ) ) );
-
-		pipeline_create_info.push_constant_ranges.emplace_back( vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
-		                                                        0,
-		                                                        static_cast< uint32_t >( sizeof( sPushConstants ) ) );
+		pipeline_create_info.setShaders( "default_quad.vert", "default_quad.frag" );
+		const std::vector< uint32_t > vertex_offsets = {
+			static_cast< uint32_t >( offsetof( sVertex, sVertex::position ) ),
+			static_cast< uint32_t >( offsetof( sVertex, sVertex::tex_coord ) ),
+		};
+		pipeline_create_info.setVertexInput( static_cast< uint32_t >( sizeof( sVertex ) ), vertex_offsets );
+		pipeline_create_info.setPushConstants( static_cast< uint32_t >( sizeof( sPushConstants ) ) );
 
-		sDescriptorLayoutBuilder_vulkan descriptor_layout_builder{};
-		descriptor_layout_builder.addBinding( 0, vk::DescriptorType::eCombinedImageSampler );
-		s_texture_layout = descriptor_layout_builder.build( vk::ShaderStageFlagBits::eFragment );
+		s_texture_layout = pipeline_create_info.createDescriptorLayout( 1 );
 
 		pipeline_create_info.descriptor_layouts.push_back( renderer->getVertexSceneUniformLayout() );
 		pipeline_create_info.descriptor_layouts.push_back( s_texture_layout.get() );
 
-		pipeline_create_info.setShaders( helper::util::createShaderModule( "default_quad.vert" ), helper::util::createShaderModule( "default_quad.frag" ) );
 		pipeline_create_info.setInputTopology( vk::PrimitiveTopology::eTriangleList );
 		pipeline_create_info.setpolygonMode( vk::PolygonMode::eFill );
 		pipeline_create_info.setCullMode( vk::CullModeFlagBits::eNone, vk::FrontFace::eClockwise );
@@ -35,6 +35,8 @@ namespace df::vulkan
 
 		void render() override;
 
+		void requestTextureMips() const;
+
 		static iRenderCallback* createDefaults();
 		static void             destroyDefaults();
 
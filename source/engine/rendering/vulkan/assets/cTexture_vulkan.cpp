@@ -4,28 +4,48 @@
 #include <stb_image.h>
 #include <tracy/Tracy.hpp>
 
+#include "engine/filesystem/cAsyncIO.h"
 #include "engine/filesystem/cFileSystem.h"
 #include "engine/log/Log.h"
 #include "engine/rendering/cRenderer.h"
+#include "engine/rendering/vulkan/cBindlessTextures_vulkan.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
+#include "engine/rendering/vulkan/cTextureStreamer_vulkan.h"
+#include "engine/rendering/vulkan/cUploadManager_vulkan.h"
 #include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 
 namespace df::vulkan
 {
+	std::atomic< uint32_t > cTexture_vulkan::s_version = 1;
+
 	cTexture_vulkan::cTexture_vulkan( std::string _name )
 		: iTexture( std::move( _name ) )
+		, m_version( s_version++ )
+		, m_bindless_index( cBindlessTextures_vulkan::s_invalid )
+		, m_cached_mip( 0 )
+		, m_resident_mip( 0 )
+		, m_requested_mip( 0 )
+		, m_last_used_frame( 0 )
 	{
 		ZoneScoped;
 
 		constexpr uint32_t white = 0xFFFFFFFF;
-		m_texture                = helper::util::createImage( &white, vk::Extent3D{ 1, 1, 1 }, vk::Format::eR8G8B8A8Unorm, vk::ImageUsageFlagBits::eSampled );
+		setImage( helper::util::createImage( &white, vk::Extent3D{ 1, 1, 1 }, vk::Format::eR8G8B8A8Unorm, vk::ImageUsageFlagBits::eSampled ) );
 	}
 
 	cTexture_vulkan::~cTexture_vulkan()
 	{
 		ZoneScoped;
 
-		if( reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
+		cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		renderer->getTextureStreamer()->unregisterTexture( this );
+
+		if( renderer->getBindlessTextures() )
+			renderer->getBindlessTextures()->remove( m_bindless_index );
+
+		renderer->getUploadManager()->discard( m_texture.image.get() );
+
+		if( renderer->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to wait for device idle" );
 	}
 
@@ -33,28 +53,261 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
+		const cMappedFile file = filesystem::mapFile( _file );
+
 		stbi_set_flip_vertically_on_load( _flip_vertically_on_load );
 		int            width, height, nr_channels;
-		unsigned char* data = stbi_load( filesystem::getPath( _file ).data(), &width, &height, &nr_channels, STBI_rgb_alpha );
+		unsigned char* data = file.getSize() ? stbi_load_from_memory( file.getData().data(), static_cast< int >( file.getSize() ), &width, &height, &nr_channels, STBI_rgb_alpha )
+		                                     : nullptr;
 
 		if( !data )
 		{
-			DF_LOG_WARNING( fmt::format( "Failed to load texture: {}", _file ) );
+			DF_LOG_WARNING( "Failed to load texture: {}", _file );
 			return false;
 		}
 
-		const VkExtent3D size{
-			.width  = static_cast< uint32_t >( width ),
-			.height = static_cast< uint32_t >( height ),
-			.depth  = 1,
-		};
+		cTextureStreamer_vulkan* streamer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getTextureStreamer();
+		streamer->retire( m_texture, this );
+		streamer->unregisterTexture( this );
+
+		m_mip_extents.clear();
+		m_streaming.reset();
+		m_cached_mips.clear();
+		m_file_path               = _file;
+		m_mipmapped               = _mipmapped;
+		m_mipmaps                 = _mipmaps;
+		m_flip_vertically_on_load = _flip_vertically_on_load;
+
+		if( !_mipmapped )
+		{
+			const VkExtent3D size{
+				.width  = static_cast< uint32_t >( width ),
+				.height = static_cast< uint32_t >( height ),
+				.depth  = 1,
+			};
+
+			setImage( helper::util::createImage( data, size, vk::Format::eR8G8B8A8Unorm, vk::ImageUsageFlagBits::eSampled ) );
+			m_resident_mip  = 0;
+			m_requested_mip = 0;
+
+			stbi_image_free( data );
+			return true;
+		}
 
-		helper::util::destroyImage( m_texture );
+		const uint32_t texture_width  = static_cast< uint32_t >( width );
+		const uint32_t texture_height = static_cast< uint32_t >( height );
 
-		m_texture = helper::util::createImage( data, size, vk::Format::eR8G8B8A8Unorm, vk::ImageUsageFlagBits::eSampled, _mipmapped, _mipmaps );
+		uint32_t mip_count = static_cast< uint32_t >( std::floor( std::log2( std::max( texture_width, texture_height ) ) ) ) + 1;
+		if( _mipmaps >= 1 )
+			mip_count = std::min( mip_count, static_cast< uint32_t >( _mipmaps ) );
 
+		for( uint32_t i = 0; i < mip_count; ++i )
+			m_mip_extents.emplace_back( std::max( texture_width >> i, 1u ), std::max( texture_height >> i, 1u ), 1 );
+
+		m_requested_mip = streamer->getInitialMip( this );
+		makeResident( m_requested_mip, generateMips( data, texture_width, texture_height, mip_count, m_requested_mip ) );
 		stbi_image_free( data );
-		m_path = _file;
+
+		if( m_mip_extents.size() > 1 )
+			streamer->registerTexture( this );
+
 		return true;
 	}
+
+	void cTexture_vulkan::requestMip( const uint32_t _mip )
+	{
+		m_requested_mip   = std::min( m_requested_mip, _mip );
+		m_last_used_frame = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getTextureStreamer()->getFrame();
+	}
+
+	void cTexture_vulkan::requestScreenSize( const float _pixels )
+	{
+		if( m_mip_extents.size() <= 1 )
+			return;
+
+		const float    texels = static_cast< float >( std::max( m_mip_extents.front().width, m_mip_extents.front().height ) );
+		const float    ratio  = texels / std::max( _pixels, 1.f );
+		const uint32_t mip    = ratio > 1 ? static_cast< uint32_t >( std::floor( std::log2( ratio ) ) ) : 0;
+
+		requestMip( std::min( mip, getMipCount() - 1 ) );
+	}
+
+	std::vector< cTexture_vulkan::sMip > cTexture_vulkan::generateMips( const unsigned char* _data,
+	                                                                    const uint32_t       _width,
+	                                                                    const uint32_t       _height,
+	                                                                    const uint32_t       _mip_count,
+	                                                                    const uint32_t       _first_mip )
+	{
+		ZoneScoped;
+
+		std::vector< sMip > mips;
+		mips.reserve( _mip_count - std::min( _first_mip, _mip_count ) );
+
+		sMip source{
+			.extent = vk::Extent3D( _width, _height, 1 ),
+			.data   = std::vector( _data, _data + static_cast< size_t >( _width ) * _height * 4 ),
+		};
+
+		for( uint32_t i = 0; i < _mip_count; ++i )
+		{
+			if( i )
+			{
+				const vk::Extent3D extent( std::max( source.extent.width / 2, 1u ), std::max( source.extent.height / 2, 1u ), 1 );
+
+				sMip mip{
+					.extent = extent,
+					.data   = std::vector< unsigned char >( static_cast< size_t >( extent.width ) * extent.height * 4 ),
+				};
+
+				for( uint32_t y = 0; y < extent.height; ++y )
+				{
+					const uint32_t y0 = std::min( y * 2, source.extent.height - 1 );
+					const uint32_t y1 = std::min( y * 2 + 1, source.extent.height - 1 );
+
+					for( uint32_t x = 0; x < extent.width; ++x )
+					{
+						const uint32_t x0 = std::min( x * 2, source.extent.width - 1 );
+						const uint32_t x1 = std::min( x * 2 + 1, source.extent.width - 1 );
+
+						for( uint32_t c = 0; c < 4; ++c )
+						{
+							const uint32_t sum = source.data[ ( y0 * source.extent.width + x0 ) * 4 + c ] + source.data[ ( y0 * source.extent.width + x1 ) * 4 + c ]
+							                   + source.data[ ( y1 * source.extent.width + x0 ) * 4 + c ] + source.data[ ( y1 * source.extent.width + x1 ) * 4 + c ];
+
+							mip.data[ ( y * extent.width + x ) * 4 + c ] = static_cast< unsigned char >( ( sum + 2 ) / 4 );
+						}
+					}
+				}
+
+				source = std::move( mip );
+			}
+
+			if( i >= _first_mip )
+				mips.push_back( source );
+		}
+
+		return mips;
+	}
+
+	bool cTexture_vulkan::stream( const uint32_t _mip )
+	{
+		ZoneScoped;
+
+		if( m_streaming || _mip >= m_mip_extents.size() || _mip == m_resident_mip )
+			return false;
+
+		if( _mip > m_resident_mip )
+		{
+			sAllocatedImage_vulkan image = helper::util::createImage( m_mip_extents[ _mip ],
+			                                                          vk::Format::eR8G8B8A8Unorm,
+			                                                          vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst
+			                                                              | vk::ImageUsageFlagBits::eTransferSrc,
+			                                                          true,
+			                                                          getMipCount() - _mip );
+
+			reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getTextureStreamer()->copyMips( this, m_texture, image.image.get(), _mip );
+
+			setImage( std::move( image ) );
+			m_resident_mip = _mip;
+			return true;
+		}
+
+		if( !m_cached_mips.empty() && _mip >= m_cached_mip )
+		{
+			makeResident( _mip, std::span( m_cached_mips ).subspan( _mip - m_cached_mip ) );
+			return true;
+		}
+
+		const std::shared_ptr< sStreaming > streaming = std::make_shared< sStreaming >();
+		streaming->mip                                = _mip;
+		m_streaming                                   = streaming;
+
+		const vk::Extent3D extent    = m_mip_extents.front();
+		const uint32_t     mip_count = getMipCount();
+		const bool         flip      = m_flip_vertically_on_load;
+
+		cAsyncIO::read(
+			m_file_path,
+			0,
+			0,
+			[ streaming, extent, mip_count, flip ]( const cAsyncIO::sRequest& _request, const bool _success )
+			{
+				ZoneScoped;
+
+				int            width = 0, height = 0, nr_channels = 0;
+				unsigned char* data  = nullptr;
+				if( _success && !_request.data.empty() )
+				{
+					stbi_set_flip_vertically_on_load_thread( flip );
+					data = stbi_load_from_memory( _request.data.data(), static_cast< int >( _request.data.size() ), &width, &height, &nr_channels, STBI_rgb_alpha );
+				}
+
+				if( data && static_cast< uint32_t >( width ) == extent.width && static_cast< uint32_t >( height ) == extent.height )
+					streaming->mips = generateMips( data, extent.width, extent.height, mip_count, streaming->mip );
+
+				stbi_image_free( data );
+				streaming->ready.store( true, std::memory_order_release );
+			},
+			cAsyncIO::eWorker );
+
+		return true;
+	}
+
+	bool cTexture_vulkan::finishStreaming()
+	{
+		ZoneScoped;
+
+		if( !m_streaming || !m_streaming->ready.load( std::memory_order_acquire ) )
+			return false;
+
+		const std::shared_ptr< sStreaming > streaming = std::move( m_streaming );
+		m_streaming.reset();
+
+		if( streaming->mips.size() != m_mip_extents.size() - streaming->mip )
+		{
+			DF_LOG_WARNING( "Failed to stream mips of texture: {}", m_file_path );
+			return true;
+		}
+
+		makeResident( streaming->mip, streaming->mips );
+
+		m_cached_mips = std::move( streaming->mips );
+		m_cached_mip  = streaming->mip;
+		return true;
+	}
+
+	void cTexture_vulkan::makeResident( const uint32_t _mip, const std::span< const sMip > _mips )
+	{
+		ZoneScoped;
+
+		std::vector< std::span< const unsigned char > > mips;
+		for( const sMip& mip: _mips )
+			mips.emplace_back( mip.data );
+
+		reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getTextureStreamer()->retire( m_texture, this );
+
+		setImage( helper::util::createImage( mips, m_mip_extents[ _mip ], vk::Format::eR8G8B8A8Unorm, vk::ImageUsageFlagBits::eSampled ) );
+		m_resident_mip = _mip;
+	}
+
+	void cTexture_vulkan::setImage( sAllocatedImage_vulkan&& _image )
+	{
+		m_texture = std::move( _image );
+		m_version = s_version++;
+
+		if( cBindlessTextures_vulkan* bindless_textures = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getBindlessTextures() )
+		{
+			bindless_textures->remove( m_bindless_index );
+			m_bindless_index = bindless_textures->add( m_texture.image_view.get() );
+		}
+	}
+
+	size_t cTexture_vulkan::getMipChainSize( const uint32_t _mip ) const
+	{
+		size_t size = 0;
+		for( uint32_t i = _mip; i < m_mip_extents.size(); ++i )
+			size += static_cast< size_t >( m_mip_extents[ i ].width ) * m_mip_extents[ i ].height * 4;
+
+		return size;
+	}
 }
@@ -1,6 +1,10 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 #include "engine/misc/Misc.h"
 #include "engine/rendering/assets/iTexture.h"
@@ -8,11 +12,21 @@
 
 namespace df::vulkan
 {
+	class cTextureStreamer_vulkan;
+
 	class cTexture_vulkan : public iTexture
 	{
 	public:
 		DF_DISABLE_COPY_AND_MOVE( cTexture_vulkan );
 
+		friend cTextureStreamer_vulkan;
+
+		struct sMip
+		{
+			vk::Extent3D                 extent;
+			std::vector< unsigned char > data;
+		};
+
 		explicit cTexture_vulkan( std::string _name );
 		~cTexture_vulkan() override;
 
@@ -21,10 +35,50 @@ namespace df::vulkan
 		void bind( int /*_index*/ = 0 ) override {}
 		void unbind( int /*_index*/ = 0 ) override {}
 
+		void requestMip( uint32_t _mip );
+		void requestScreenSize( float _pixels );
+
 		const sAllocatedImage_vulkan& getImage() const { return m_texture; }
+		uint32_t                      getMipCount() const { return static_cast< uint32_t >( m_mip_extents.size() ); }
+		uint32_t                      getResidentMip() const { return m_resident_mip; }
+		uint32_t                      getTargetMip() const { return m_streaming ? m_streaming->mip : m_resident_mip; }
+		uint32_t                      getVersion() const { return m_version; }
+		uint32_t                      getBindlessIndex() const { return m_bindless_index; }
+		size_t                        getResidentSize() const { return getMipChainSize( getTargetMip() ); }
+		bool                          isStreaming() const { return m_streaming != nullptr; }
+
+		static uint32_t getLatestVersion() { return s_version; }
 
 	protected:
+		struct sStreaming
+		{
+			uint32_t            mip;
+			std::vector< sMip > mips;
+			std::atomic< bool > ready;
+		};
+
+		static std::vector< sMip > generateMips( const unsigned char* _data, uint32_t _width, uint32_t _height, uint32_t _mip_count, uint32_t _first_mip );
+
+		bool   stream( uint32_t _mip );
+		bool   finishStreaming();
+		void   makeResident( uint32_t _mip, std::span< const sMip > _mips );
+		size_t getMipChainSize( uint32_t _mip ) const;
+
+		void setImage( sAllocatedImage_vulkan&& _image );
+
 		sAllocatedImage_vulkan m_texture;
-		std::string            m_path;
+		uint32_t               m_version;
+		uint32_t               m_bindless_index;
+
+		std::vector< vk::Extent3D >   m_mip_extents;
+		std::shared_ptr< sStreaming > m_streaming;
+		std::vector< sMip >           m_cached_mips;
+		uint32_t                      m_cached_mip;
+		uint32_t                      m_resident_mip;
+		uint32_t                      m_requested_mip;
+		uint64_t                      m_last_used_frame;
+
+	private:
+		static std::atomic< uint32_t > s_version;
 	};
 }
@@ -2,8 +2,11 @@
 
 #include <tracy/Tracy.hpp>
 
+#include "cTexture_vulkan.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
+#include "engine/rendering/vulkan/cUploadManager_vulkan.h"
+#include "engine/rendering/vulkan/descriptor/sDescriptorWriter_vulkan.h"
 #include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 
 namespace df::vulkan
@@ -12,7 +15,50 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
-		if( reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
+		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		renderer->getUploadManager()->discard( vertex_buffer.buffer.get() );
+		renderer->getUploadManager()->discard( index_buffer.buffer.get() );
+
+		if( renderer->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to wait for device idle" );
 	}
+
+	vk::DescriptorSet sRenderAsset_vulkan::getTextureSet( const vk::DescriptorSetLayout& _layout, const std::span< const cTexture_vulkan* const > _textures ) const
+	{
+		ZoneScoped;
+
+		cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		if( m_texture_sets.empty() )
+			m_texture_sets.resize( renderer->getFramesInFlight() );
+
+		sTextureSet& texture_set = m_texture_sets[ renderer->getCurrentFrameIndex() ];
+		if( !texture_set.set || texture_set.layout != _layout )
+		{
+			texture_set.set    = renderer->getStaticDescriptors().allocateUnique( _layout );
+			texture_set.layout = _layout;
+			texture_set.versions.fill( 0 );
+		}
+
+		bool dirty = false;
+		for( size_t i = 0; i < _textures.size() && i < s_max_textures; ++i )
+			dirty |= texture_set.versions[ i ] != _textures[ i ]->getVersion();
+
+		if( !dirty )
+			return texture_set.set.get();
+
+		sDescriptorWriter_vulkan writer;
+		for( size_t i = 0; i < _textures.size() && i < s_max_textures; ++i )
+		{
+			writer.writeImage( static_cast< uint32_t >( i ),
+			                   _textures[ i ]->getImage().image_view.get(),
+			                   renderer->getNearestSampler(),
+			                   vk::ImageLayout::eShaderReadOnlyOptimal,
+			                   vk::DescriptorType::eCombinedImageSampler );
+
+			texture_set.versions[ i ] = _textures[ i ]->getVersion();
+		}
+		writer.updateSet( texture_set.set.get() );
+
+		return texture_set.set.get();
+	}
 }
@@ -1,10 +1,16 @@
 ﻿#pragma once
 
+#include <array>
+#include <span>
+#include <vector>
+
 #include "engine/misc/Misc.h"
 #include "engine/rendering/vulkan/misc/Types_vulkan.h"
 
 namespace df::vulkan
 {
+	class cTexture_vulkan;
+
 	struct sRenderAsset_vulkan
 	{
 		DF_DISABLE_COPY_AND_MOVE( sRenderAsset_vulkan );
@@ -15,5 +21,19 @@ namespace df::vulkan
 		sAllocatedBuffer_vulkan vertex_buffer;
 		sAllocatedBuffer_vulkan fragment_buffer;
 		sAllocatedBuffer_vulkan index_buffer;
+
+		vk::DescriptorSet getTextureSet( const vk::DescriptorSetLayout& _layout, std::span< const cTexture_vulkan* const > _textures ) const;
+
+	private:
+		static constexpr size_t s_max_textures = 4;
+
+		struct sTextureSet
+		{
+			vk::UniqueDescriptorSet                set;
+			vk::DescriptorSetLayout                layout;
+			std::array< uint32_t, s_max_textures > versions;
+		};
+
+		mutable std::vector< sTextureSet > m_texture_sets;
 	};
 }
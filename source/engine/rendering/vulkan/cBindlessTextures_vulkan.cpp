@@ -0,0 +1,125 @@
+﻿#include "cBindlessTextures_vulkan.h"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+#include "descriptor/sDescriptorLayoutBuilder_vulkan.h"
+#include "engine/log/Log.h"
+
+namespace df::vulkan
+{
+	cBindlessTextures_vulkan::cBindlessTextures_vulkan( const vk::PhysicalDevice& _physical_device,
+	                                                    const vk::Device&         _logical_device,
+	                                                    const vk::Sampler&        _sampler,
+	                                                    const uint32_t            _frames_in_flight,
+	                                                    const uint32_t            _capacity )
+		: m_logical_device( _logical_device )
+		, m_sampler( _sampler )
+		, m_capacity( std::min( _capacity, getMaxCapacity( _physical_device ) ) )
+		, m_count( 0 )
+		, m_frames_in_flight( _frames_in_flight )
+		, m_frame( 0 )
+	{
+		ZoneScoped;
+
+		if( m_capacity < _capacity )
+			DF_LOG_WARNING( "Device limits bindless textures to {} of the {} requested slots", m_capacity, _capacity );
+
+		const vk::DescriptorPoolSize       pool_size( vk::DescriptorType::eCombinedImageSampler, m_capacity );
+		const vk::DescriptorPoolCreateInfo pool_create_info( vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind, 1, 1, &pool_size );
+		m_pool = m_logical_device.createDescriptorPoolUnique( pool_create_info ).value;
+
+		const vk::DescriptorSetLayoutBinding binding( 0, vk::DescriptorType::eCombinedImageSampler, m_capacity, vk::ShaderStageFlagBits::eFragment );
+		const vk::DescriptorBindingFlags     binding_flags = vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind
+		                                                 | vk::DescriptorBindingFlagBits::eUpdateUnusedWhilePending;
+
+		const vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags_create_info( 1, &binding_flags );
+		const vk::DescriptorSetLayoutCreateInfo             layout_create_info( vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool, 1, &binding, &binding_flags_create_info );
+		m_layout = m_logical_device.createDescriptorSetLayoutUnique( layout_create_info ).value;
+		sDescriptorLayoutBuilder_vulkan::registerLayout( m_layout.get(), layout_create_info );
+
+		const vk::DescriptorSetAllocateInfo allocate_info( m_pool.get(), 1, &m_layout.get() );
+		m_set = m_logical_device.allocateDescriptorSets( allocate_info ).value.front();
+
+		DF_LOG_MESSAGE( "Created bindless texture array with {} slots", m_capacity );
+	}
+
+	uint32_t cBindlessTextures_vulkan::add( const vk::ImageView& _image_view )
+	{
+		ZoneScoped;
+
+		uint32_t index;
+		if( !m_free.empty() )
+		{
+			index = m_free.back();
+			m_free.pop_back();
+		}
+		else if( m_count < m_capacity )
+			index = m_count++;
+		else
+		{
+			DF_LOG_ERROR( "Bindless texture array is full, capacity is {}", m_capacity );
+			return s_invalid;
+		}
+
+		const vk::DescriptorImageInfo image_info( m_sampler, _image_view, vk::ImageLayout::eShaderReadOnlyOptimal );
+		const vk::WriteDescriptorSet  write( m_set, 0, index, 1, vk::DescriptorType::eCombinedImageSampler, &image_info );
+		m_logical_device.updateDescriptorSets( 1, &write, 0, nullptr );
+
+		return index;
+	}
+
+	void cBindlessTextures_vulkan::remove( const uint32_t _index )
+	{
+		ZoneScoped;
+
+		if( _index != s_invalid )
+			m_retired.push_back( { m_frame, _index } );
+	}
+
+	void cBindlessTextures_vulkan::update( const uint64_t _frame )
+	{
+		ZoneScoped;
+
+		m_frame = _frame;
+
+		std::erase_if( m_retired,
+		               [ & ]( const sRetiredIndex& _retired )
+		               {
+						   if( _retired.frame + m_frames_in_flight > m_frame )
+							   return false;
+
+						   m_free.push_back( _retired.index );
+						   return true;
+					   } );
+	}
+
+	bool cBindlessTextures_vulkan::isSupported( const vk::PhysicalDevice& _physical_device )
+	{
+		ZoneScoped;
+
+		const vk::StructureChain features = _physical_device.getFeatures2< vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDescriptorIndexingFeatures >();
+
+		const vk::PhysicalDeviceDescriptorIndexingFeatures& indexing_features = features.get< vk::PhysicalDeviceDescriptorIndexingFeatures >();
+
+		return indexing_features.runtimeDescriptorArray && indexing_features.descriptorBindingPartiallyBound
+		    && indexing_features.descriptorBindingSampledImageUpdateAfterBind && indexing_features.descriptorBindingUpdateUnusedWhilePending
+		    && indexing_features.shaderSampledImageArrayNonUniformIndexing;
+	}
+
+	uint32_t cBindlessTextures_vulkan::getMaxCapacity( const vk::PhysicalDevice& _physical_device )
+	{
+		ZoneScoped;
+
+		const vk::StructureChain properties = _physical_device.getProperties2< vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorIndexingProperties >();
+
+		const vk::PhysicalDeviceDescriptorIndexingProperties& indexing_properties = properties.get< vk::PhysicalDeviceDescriptorIndexingProperties >();
+
+		// Combined image samplers count against both the sampled image and the sampler limits.
+		return std::min( { indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+		                   indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+		                   indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+		                   indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+		                   indexing_properties.maxPerStageUpdateAfterBindResources } );
+	}
+}
@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "engine/misc/Misc.h"
+
+namespace df::vulkan
+{
+	class cBindlessTextures_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cBindlessTextures_vulkan )
+
+		static constexpr uint32_t s_invalid = UINT32_MAX;
+
+		cBindlessTextures_vulkan( const vk::PhysicalDevice& _physical_device,
+		                          const vk::Device&         _logical_device,
+		                          const vk::Sampler&        _sampler,
+		                          uint32_t                  _frames_in_flight,
+		                          uint32_t                  _capacity = 4096 );
+		~cBindlessTextures_vulkan() = default;
+
+		uint32_t add( const vk::ImageView& _image_view );
+		void     remove( uint32_t _index );
+
+		void update( uint64_t _frame );
+
+		const vk::DescriptorSetLayout& getLayout() const { return m_layout.get(); }
+		const vk::DescriptorSet&       getSet() const { return m_set; }
+		uint32_t                       getCount() const { return m_count - static_cast< uint32_t >( m_free.size() ); }
+		uint32_t                       getCapacity() const { return m_capacity; }
+
+		static bool     isSupported( const vk::PhysicalDevice& _physical_device );
+		static uint32_t getMaxCapacity( const vk::PhysicalDevice& _physical_device );
+
+	private:
+		struct sRetiredIndex
+		{
+			uint64_t frame;
+			uint32_t index;
+		};
+
+		vk::Device                    m_logical_device;
+		vk::Sampler                   m_sampler;
+		vk::UniqueDescriptorPool      m_pool;
+		vk::UniqueDescriptorSetLayout m_layout;
+		vk::DescriptorSet             m_set;
+
+		std::vector< uint32_t >      m_free;
+		std::vector< sRetiredIndex > m_retired;
+
+		uint32_t m_capacity;
+		uint32_t m_count;
+		uint32_t m_frames_in_flight;
+		uint64_t m_frame;
+	};
+}
@@ -1,12 +1,12 @@
 ﻿#include "cDeferredRenderer_vulkan.h"
 
-#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <tracy/Tracy.hpp>
 
 #include "assets/cQuad_vulkan.h"
 #include "callbacks/DefaultQuadCB_vulkan.h"
 #include "cFramebuffer_vulkan.h"
-#include "descriptor/sDescriptorLayoutBuilder_vulkan.h"
+#include "cGpuCulling_vulkan.h"
 #include "engine/managers/cEventManager.h"
 #include "engine/rendering/cRenderCallback.h"
 #include "misc/Helper_vulkan.h"
@@ -54,18 +54,19 @@ namespace df::vulkan
 		const std::vector< sAllocatedImage_vulkan >& framebuffer_images = framebuffer->getCurrentFrameImages( getCurrentFrameIndex() );
 
 		std::vector< vk::RenderingAttachmentInfo > color_attachments;
+		std::vector< vk::Format >                  color_formats;
 		for( const sAllocatedImage_vulkan& framebuffer_image: framebuffer_images )
 		{
 			color_attachments.push_back(
 				helper::init::attachmentInfo( framebuffer_image.image_view.get(), color ? &clear_color_value : nullptr, vk::ImageLayout::eColorAttachmentOptimal ) );
+			color_formats.push_back( framebuffer_image.format );
 		}
 
 		const vk::RenderingAttachmentInfo depth_attachment = helper::init::attachmentInfo( m_depth_image.image_view.get(),
 		                                                                                   depth ? &clear_depth_stencil_value : nullptr,
 		                                                                                   vk::ImageLayout::eDepthAttachmentOptimal );
 
-		const vk::RenderingInfo rendering_info = helper::init::renderingInfo( m_render_extent, color_attachments, &depth_attachment );
-		command_buffer->beginRendering( &rendering_info );
+		beginRenderingScope( command_buffer.get(), std::move( color_attachments ), std::move( color_formats ), depth_attachment );
 	}
 
 	void cDeferredRenderer_vulkan::renderDeferred( const vk::CommandBuffer& _command_buffer )
@@ -84,6 +85,9 @@ namespace df::vulkan
 
 		m_begin_deferred = true;
 		cEventManager::invoke( event::render_3d );
+		if( m_gpu_culling )
+			m_gpu_culling->buildDepthPyramid( _command_buffer, m_depth_image );
+
 		cEventManager::invoke( event::render_2d );
 
 		for( const sAllocatedImage_vulkan& image: deferred_images )
@@ -100,10 +104,10 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
+		const glm::quat rotation = angleAxis( glm::radians( 180.f ), glm::vec3( 0.f, 0.f, 1.f ) ) * angleAxis( glm::radians( 180.f ), glm::vec3( 0.f, 1.f, 0.f ) );
+
 		m_deferred_screen_quad = new cQuad_vulkan( "deferred", glm::vec3( m_window_size / 2, 0 ), glm::vec2( m_window_size ) );
-		glm::mat4& transform   = m_deferred_screen_quad->transform->local;
-		transform              = rotate( transform, glm::radians( 180.f ), glm::vec3( 0.f, 0.f, 1.f ) );
-		transform              = rotate( transform, glm::radians( 180.f ), glm::vec3( 0.f, 1.f, 0.f ) );
+		m_deferred_screen_quad->transform->setRotation( rotation );
 		m_deferred_screen_quad->transform->update();
 
 		createQuadRenderCallback();
@@ -117,30 +121,19 @@ namespace df::vulkan
 
 		sPipelineCreateInfo_vulkan pipeline_create_info{ .name = "default_quad_final_deferred" };
 
-		pipeline_create_info.vertex_input_binding.emplace_back( 0, static_cast< uint32_t >( sizeof( cQuad_vulkan::sVertex ) ), vk::VertexInputRate::eVertex );
-
-		pipeline_create_info.vertex_input_attribute.emplace_back( 0,
-		                                                          0,
-		                                                          vk::Format::eR32G32B32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( cQuad_vulkan::sVertex, cQuad_vulkan::sVertex::position ) ) );
-		pipeline_create_info.vertex_input_attribute.emplace_back( 1,
-		                                                          0,
-		                                                          vk::Format::eR32G32Sfloat,
-		                                                          static_cast< uint32_t >( offsetof( cQuad_vulkan::sVertex, cQuad_vulkan::sVertex::tex_coord ) ) );
-
-		pipeline_create_info.push_constant_ranges.emplace_back( vk::ShaderStageFlagBits::eVertex, 0, static_cast< uint32_t >( sizeof( sPushConstants ) ) );
+		pipeline_create_info.setShaders( "default_quad_final_deferred.vert", "default_quad_final_deferred.frag" );
+		const std::vector< uint32_t > vertex_offsets = {
+			static_cast< uint32_t >( offsetof( cQuad_vulkan::sVertex, cQuad_vulkan::sVertex::position ) ),
+			static_cast< uint32_t >( offsetof( cQuad_vulkan::sVertex, cQuad_vulkan::sVertex::tex_coord ) ),
+		};
+		pipeline_create_info.setVertexInput( static_cast< uint32_t >( sizeof( cQuad_vulkan::sVertex ) ), vertex_offsets );
+		pipeline_create_info.setPushConstants( static_cast< uint32_t >( sizeof( sPushConstants ) ) );
 
-		sDescriptorLayoutBuilder_vulkan descriptor_layout_builder{};
-		descriptor_layout_builder.addBinding( 0, vk::DescriptorType::eCombinedImageSampler );
-		descriptor_layout_builder.addBinding( 1, vk::DescriptorType::eCombinedImageSampler );
-		descriptor_layout_builder.addBinding( 2, vk::DescriptorType::eCombinedImageSampler );
-		m_texture_layout = descriptor_layout_builder.build( vk::ShaderStageFlagBits::eFragment );
+		m_texture_layout = pipeline_create_info.createDescriptorLayout( 1 );
 
 		pipeline_create_info.descriptor_layouts.push_back( getVertexSceneUniformLayout() );
 		pipeline_create_info.descriptor_layouts.push_back( m_texture_layout.get() );
 
-		pipeline_create_info.setShaders( helper::util::createShaderModule( "default_quad_final_deferred.vert" ),
-		                                 helper::util::createShaderModule( "default_quad_final_deferred.vert" ) );
 		pipeline_create_info.setInputTopology( vk::PrimitiveTopology::eTriangleList );
 		pipeline_create_info.setpolygonMode( vk::PolygonMode::eFill );
 		pipeline_create_info.setCullMode( vk::CullModeFlagBits::eFront, vk::FrontFace::eClockwise );
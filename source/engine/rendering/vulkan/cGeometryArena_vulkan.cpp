@@ -0,0 +1,184 @@
+﻿#include "cGeometryArena_vulkan.h"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+#include "cRenderer_vulkan.h"
+#include "cUploadManager_vulkan.h"
+#include "engine/log/Log.h"
+#include "engine/rendering/cRenderer.h"
+#include "misc/Helper_vulkan.h"
+
+namespace df::vulkan
+{
+	cGeometryArena_vulkan::cGeometryArena_vulkan( const uint32_t _frames_in_flight,
+	                                              const uint32_t _vertex_stride,
+	                                              const uint32_t _vertex_capacity,
+	                                              const uint32_t _index_capacity )
+		: m_frames_in_flight( _frames_in_flight )
+		, m_frame( 0 )
+	{
+		ZoneScoped;
+
+		m_vertices.usage            = vk::BufferUsageFlagBits::eVertexBuffer;
+		m_vertices.stride           = _vertex_stride;
+		m_vertices.capacity         = 0;
+		m_vertices.initial_capacity = _vertex_capacity;
+		m_vertices.used             = 0;
+
+		m_indices.usage            = vk::BufferUsageFlagBits::eIndexBuffer;
+		m_indices.stride           = static_cast< uint32_t >( sizeof( uint32_t ) );
+		m_indices.capacity         = 0;
+		m_indices.initial_capacity = _index_capacity;
+		m_indices.used             = 0;
+	}
+
+	cGeometryArena_vulkan::sAllocation cGeometryArena_vulkan::allocate( const void*     _vertices,
+	                                                                    const uint32_t  _vertex_count,
+	                                                                    const uint32_t* _indices,
+	                                                                    const uint32_t  _index_count )
+	{
+		ZoneScoped;
+
+		const sAllocation allocation{
+			.vertices = { allocateRange( m_vertices, _vertex_count ), _vertex_count },
+			.indices  = { allocateRange( m_indices, _index_count ), _index_count },
+		};
+
+		const vk::DeviceSize vertex_size = static_cast< vk::DeviceSize >( _vertex_count ) * m_vertices.stride;
+		const vk::DeviceSize index_size  = static_cast< vk::DeviceSize >( _index_count ) * m_indices.stride;
+
+		if( !vertex_size && !index_size )
+			return allocation;
+
+		cUploadManager_vulkan* upload_manager = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getUploadManager();
+
+		upload_manager->uploadBuffer( m_vertices.buffer.buffer.get(), static_cast< vk::DeviceSize >( allocation.vertices.offset ) * m_vertices.stride, _vertices, vertex_size );
+		upload_manager->uploadBuffer( m_indices.buffer.buffer.get(), static_cast< vk::DeviceSize >( allocation.indices.offset ) * m_indices.stride, _indices, index_size );
+
+		return allocation;
+	}
+
+	void cGeometryArena_vulkan::free( const sAllocation& _allocation )
+	{
+		ZoneScoped;
+
+		m_retired.push_back( { m_frame, _allocation } );
+	}
+
+	void cGeometryArena_vulkan::update( const uint64_t _frame )
+	{
+		ZoneScoped;
+
+		m_frame = _frame;
+
+		std::erase_if( m_retired,
+		               [ & ]( const sRetiredAllocation& _retired )
+		               {
+						   if( _retired.frame + m_frames_in_flight > m_frame )
+							   return false;
+
+						   releaseRange( m_vertices, _retired.allocation.vertices );
+						   releaseRange( m_indices, _retired.allocation.indices );
+						   return true;
+					   } );
+
+		std::erase_if( m_retired_buffers, [ & ]( const sRetiredBuffer& _retired ) { return _retired.frame + m_frames_in_flight <= m_frame; } );
+	}
+
+	uint32_t cGeometryArena_vulkan::allocateRange( sHeap& _heap, const uint32_t _count )
+	{
+		if( !_count )
+			return 0;
+
+		auto it = std::ranges::find_if( _heap.free_ranges, [ & ]( const sRange& _range ) { return _range.count >= _count; } );
+		if( it == _heap.free_ranges.end() )
+		{
+			grow( _heap, _count );
+			it = std::ranges::find_if( _heap.free_ranges, [ & ]( const sRange& _range ) { return _range.count >= _count; } );
+		}
+
+		const uint32_t offset = it->offset;
+
+		it->offset += _count;
+		it->count  -= _count;
+		if( !it->count )
+			_heap.free_ranges.erase( it );
+
+		_heap.used += _count;
+		return offset;
+	}
+
+	void cGeometryArena_vulkan::releaseRange( sHeap& _heap, const sRange& _range )
+	{
+		if( !_range.count )
+			return;
+
+		_heap.used -= _range.count;
+
+		auto it = std::ranges::lower_bound( _heap.free_ranges, _range.offset, {}, &sRange::offset );
+		it      = _heap.free_ranges.insert( it, _range );
+
+		const auto next = it + 1;
+		if( next != _heap.free_ranges.end() && it->offset + it->count == next->offset )
+		{
+			it->count += next->count;
+			_heap.free_ranges.erase( next );
+		}
+
+		if( it != _heap.free_ranges.begin() )
+		{
+			const auto previous = it - 1;
+			if( previous->offset + previous->count == it->offset )
+			{
+				previous->count += it->count;
+				_heap.free_ranges.erase( it );
+			}
+		}
+	}
+
+	void cGeometryArena_vulkan::grow( sHeap& _heap, const uint32_t _count )
+	{
+		ZoneScoped;
+
+		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+
+		uint32_t capacity = std::max( _heap.capacity, _heap.initial_capacity );
+		while( capacity - _heap.capacity < _count )
+			capacity *= 2;
+
+		sAllocatedBuffer_vulkan buffer = helper::util::createBuffer( static_cast< vk::DeviceSize >( capacity ) * _heap.stride,
+		                                                             _heap.usage | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
+		                                                             vma::MemoryUsage::eGpuOnly );
+
+		if( _heap.capacity )
+		{
+			renderer->getUploadManager()->flush();
+
+			if( renderer->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
+				DF_LOG_ERROR( "Failed to wait for device idle" );
+
+			renderer->immediateSubmit(
+				[ & ]( const vk::CommandBuffer _command_buffer )
+				{
+					renderer->getUploadManager()->acquire( _command_buffer );
+
+					const vk::BufferCopy copy( 0, 0, static_cast< vk::DeviceSize >( _heap.capacity ) * _heap.stride );
+					_command_buffer.copyBuffer( _heap.buffer.buffer.get(), buffer.buffer.get(), 1, &copy );
+				} );
+		}
+
+		DF_LOG_MESSAGE( "Grew geometry arena from {} to {} elements", _heap.capacity, capacity );
+
+		const sRange range{ _heap.capacity, capacity - _heap.capacity };
+
+		if( _heap.capacity )
+			m_retired_buffers.push_back( { m_frame, std::move( _heap.buffer ) } );
+
+		_heap.buffer   = std::move( buffer );
+		_heap.used    += range.count;
+		_heap.capacity = capacity;
+
+		releaseRange( _heap, range );
+	}
+}
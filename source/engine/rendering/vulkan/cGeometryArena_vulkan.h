@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include <vector>
+
+#include "engine/misc/Misc.h"
+#include "misc/Types_vulkan.h"
+
+namespace df::vulkan
+{
+	class cGeometryArena_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cGeometryArena_vulkan )
+
+		struct sRange
+		{
+			uint32_t offset;
+			uint32_t count;
+		};
+
+		struct sAllocation
+		{
+			sRange vertices;
+			sRange indices;
+		};
+
+		cGeometryArena_vulkan( uint32_t _frames_in_flight, uint32_t _vertex_stride, uint32_t _vertex_capacity = 1024 * 1024, uint32_t _index_capacity = 4 * 1024 * 1024 );
+		~cGeometryArena_vulkan() = default;
+
+		sAllocation allocate( const void* _vertices, uint32_t _vertex_count, const uint32_t* _indices, uint32_t _index_count );
+		void        free( const sAllocation& _allocation );
+
+		void update( uint64_t _frame );
+
+		const vk::Buffer& getVertexBuffer() const { return m_vertices.buffer.buffer.get(); }
+		const vk::Buffer& getIndexBuffer() const { return m_indices.buffer.buffer.get(); }
+
+		uint32_t getUsedVertices() const { return m_vertices.used; }
+		uint32_t getUsedIndices() const { return m_indices.used; }
+
+	private:
+		struct sHeap
+		{
+			sAllocatedBuffer_vulkan buffer;
+			vk::BufferUsageFlags    usage;
+			uint32_t                stride;
+			uint32_t                capacity;
+			uint32_t                initial_capacity;
+			uint32_t                used;
+			std::vector< sRange >   free_ranges;
+		};
+
+		struct sRetiredAllocation
+		{
+			uint64_t    frame;
+			sAllocation allocation;
+		};
+
+		struct sRetiredBuffer
+		{
+			uint64_t                frame;
+			sAllocatedBuffer_vulkan buffer;
+		};
+
+		uint32_t    allocateRange( sHeap& _heap, uint32_t _count );
+		static void releaseRange( sHeap& _heap, const sRange& _range );
+		void        grow( sHeap& _heap, uint32_t _count );
+
+		sHeap                             m_vertices;
+		sHeap                             m_indices;
+		std::vector< sRetiredAllocation > m_retired;
+		std::vector< sRetiredBuffer >     m_retired_buffers;
+
+		uint32_t m_frames_in_flight;
+		uint64_t m_frame;
+	};
+}
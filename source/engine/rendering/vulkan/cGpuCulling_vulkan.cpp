@@ -0,0 +1,642 @@
+﻿#include "cGpuCulling_vulkan.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <glm/geometric.hpp>
+#include <tracy/Tracy.hpp>
+
+#include "assets/cMesh_vulkan.h"
+#include "assets/cTexture_vulkan.h"
+#include "cBindlessTextures_vulkan.h"
+#include "cGeometryArena_vulkan.h"
+#include "cRenderer_vulkan.h"
+#include "descriptor/sDescriptorLayoutBuilder_vulkan.h"
+#include "descriptor/sDescriptorWriter_vulkan.h"
+#include "engine/log/Log.h"
+#include "engine/managers/cRenderCallbackManager.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
+#include "engine/rendering/cRenderer.h"
+#include "misc/Helper_vulkan.h"
+#include "pipeline/cPipelineCache_vulkan.h"
+#include "pipeline/cPipeline_vulkan.h"
+
+namespace df::vulkan
+{
+	namespace
+	{
+		void memoryBarrier( const vk::CommandBuffer&      _command_buffer,
+		                    const vk::PipelineStageFlags2 _source_stage,
+		                    const vk::AccessFlags2        _source_access,
+		                    const vk::PipelineStageFlags2 _destination_stage,
+		                    const vk::AccessFlags2        _destination_access )
+		{
+			const vk::MemoryBarrier2 memory_barrier( _source_stage, _source_access, _destination_stage, _destination_access );
+			const vk::DependencyInfo info( vk::DependencyFlags(), 1, &memory_barrier, 0, nullptr, 0, nullptr );
+			_command_buffer.pipelineBarrier2( info );
+		}
+
+		void depthBarrier( const vk::CommandBuffer&      _command_buffer,
+		                   const vk::Image&              _image,
+		                   const vk::PipelineStageFlags2 _source_stage,
+		                   const vk::AccessFlags2        _source_access,
+		                   const vk::PipelineStageFlags2 _destination_stage,
+		                   const vk::AccessFlags2        _destination_access,
+		                   const vk::ImageLayout         _current_layout,
+		                   const vk::ImageLayout         _new_layout )
+		{
+			const vk::ImageMemoryBarrier2 image_barrier( _source_stage,
+			                                             _source_access,
+			                                             _destination_stage,
+			                                             _destination_access,
+			                                             _current_layout,
+			                                             _new_layout,
+			                                             vk::QueueFamilyIgnored,
+			                                             vk::QueueFamilyIgnored,
+			                                             _image,
+			                                             helper::init::imageSubresourceRange( vk::ImageAspectFlagBits::eDepth ) );
+
+			const vk::DependencyInfo info( vk::DependencyFlags(), 0, nullptr, 0, nullptr, 1, &image_barrier );
+			_command_buffer.pipelineBarrier2( info );
+		}
+
+		uint32_t getBindlessIndex( const cMesh_vulkan* _mesh, const aiTextureType _type )
+		{
+			const auto it = _mesh->getTextures().find( _type );
+			if( it == _mesh->getTextures().end() || !it->second )
+				return cBindlessTextures_vulkan::s_invalid;
+
+			return reinterpret_cast< const cTexture_vulkan* >( it->second )->getBindlessIndex();
+		}
+	}
+
+	cGpuCulling_vulkan::cGpuCulling_vulkan( const uint32_t _frames_in_flight, const uint32_t _capacity )
+		: m_pyramid_camera( nullptr )
+		, m_render_callback( nullptr )
+		, m_culled_camera( nullptr )
+		, m_occlusion( false )
+		, m_capacity( _capacity )
+		, m_count( 0 )
+		, m_draw_count( 0 )
+		, m_texture_version( 0 )
+		, m_frames_in_flight( _frames_in_flight )
+		, m_frame_index( 0 )
+		, m_stats{}
+	{
+		ZoneScoped;
+	}
+
+	cGpuCulling_vulkan::~cGpuCulling_vulkan()
+	{
+		ZoneScoped;
+
+		destroyDepthPyramid();
+
+		if( m_pyramid_placeholder.image )
+			helper::util::destroyImage( m_pyramid_placeholder );
+	}
+
+	void cGpuCulling_vulkan::set( const uint32_t _slot, const cMesh_vulkan* _mesh )
+	{
+		ZoneScoped;
+
+		const glm::mat4 world = _mesh->transform->getWorld();
+		const float     scale = std::max( { length( glm::vec3( world[ 0 ] ) ), length( glm::vec3( world[ 1 ] ) ), length( glm::vec3( world[ 2 ] ) ) } );
+
+		const sDraw draw{
+			.sphere        = glm::vec4( glm::vec3( world * glm::vec4( _mesh->getBounds().getCenter(), 1 ) ), _mesh->getBounds().getRadius() * scale ),
+			.index_count   = _mesh->geometry.indices.count,
+			.first_index   = _mesh->geometry.indices.offset,
+			.vertex_offset = static_cast< int32_t >( _mesh->geometry.vertices.offset ),
+			.padding       = 0,
+		};
+		const sRenderQueue_vulkan::sObject object{
+			.world_matrix     = world,
+			.color_texture    = getBindlessIndex( _mesh, aiTextureType_DIFFUSE ),
+			.normal_texture   = getBindlessIndex( _mesh, aiTextureType_NORMALS ),
+			.specular_texture = getBindlessIndex( _mesh, aiTextureType_SPECULAR ),
+			.padding          = 0,
+		};
+
+		set( _slot, draw, object );
+		m_meshes[ _slot ] = _mesh;
+	}
+
+	void cGpuCulling_vulkan::set( const uint32_t _slot, const sDraw& _draw, const sRenderQueue_vulkan::sObject& _object )
+	{
+		ZoneScoped;
+
+		if( _slot >= m_meshes.size() )
+		{
+			m_meshes.resize( _slot + 1, nullptr );
+			m_draws.resize( _slot + 1, {} );
+			m_objects.resize( _slot + 1, {} );
+		}
+
+		// The cull shader skips draws without indices, so they don't count as draws either.
+		if( !m_draws[ _slot ].index_count && _draw.index_count )
+			m_stats.draws++;
+		else if( m_draws[ _slot ].index_count && !_draw.index_count )
+			m_stats.draws--;
+
+		m_meshes[ _slot ]  = nullptr;
+		m_draws[ _slot ]   = _draw;
+		m_objects[ _slot ] = _object;
+
+		m_count = std::max( m_count, _slot + 1 );
+
+		for( sFrame& frame: m_frames )
+			frame.dirty.push_back( _slot );
+	}
+
+	void cGpuCulling_vulkan::remove( const uint32_t _slot )
+	{
+		ZoneScoped;
+
+		if( _slot >= m_draws.size() || !m_draws[ _slot ].index_count )
+			return;
+
+		m_stats.draws--;
+
+		m_meshes[ _slot ] = nullptr;
+		m_draws[ _slot ]  = {};
+
+		for( sFrame& frame: m_frames )
+			frame.dirty.push_back( _slot );
+	}
+
+	void cGpuCulling_vulkan::update( const uint64_t _frame )
+	{
+		ZoneScoped;
+
+		m_frame_index   = static_cast< uint32_t >( _frame % m_frames_in_flight );
+		m_culled_camera = nullptr;
+
+		const uint32_t capacity = m_capacity;
+		while( m_capacity < m_count )
+			m_capacity *= 2;
+
+		if( m_frames.empty() )
+		{
+			createResources();
+			return;
+		}
+
+		if( m_capacity == capacity )
+			return;
+
+		if( reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to wait for device idle" );
+
+		createFrames();
+		DF_LOG_MESSAGE( "Grew GPU culling from {} to {} draws", capacity, m_capacity );
+	}
+
+	void cGpuCulling_vulkan::cull( const vk::CommandBuffer& _command_buffer, const cCamera* _camera )
+	{
+		ZoneScoped;
+
+		m_culled_camera = nullptr;
+		if( !_camera || _camera->type != cCamera::ePerspective || !m_count || !m_render_callback || m_frames.empty() )
+			return;
+
+		if( m_texture_version != cTexture_vulkan::getLatestVersion() )
+			refreshTextures();
+
+		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		sFrame&                 frame    = m_frames[ m_frame_index ];
+
+		flush( frame );
+
+		m_draw_count         = std::min( m_count, m_capacity );
+		const bool occlusion = m_occlusion && m_pyramid.image && m_pyramid_camera == _camera;
+
+		// The slot's previous submission has completed, so its set can be rewritten before it is bound.
+		sDescriptorWriter_vulkan writer;
+		writer.writeImage( 3,
+		                   occlusion ? m_pyramid.image_view.get() : m_pyramid_placeholder.image_view.get(),
+		                   renderer->getNearestSampler(),
+		                   occlusion ? vk::ImageLayout::eGeneral : vk::ImageLayout::eShaderReadOnlyOptimal,
+		                   vk::DescriptorType::eCombinedImageSampler );
+		writer.updateSet( frame.cull_set );
+
+		const sCullConstants constants{
+			.view_projection = _camera->view_projection,
+			.pyramid_size    = glm::vec2( m_pyramid.extent.width, m_pyramid.extent.height ),
+			.draw_count      = m_draw_count,
+			.occlusion       = occlusion,
+		};
+
+		memoryBarrier( _command_buffer,
+		               vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eShaderStorageWrite,
+		               vk::PipelineStageFlagBits2::eTransfer | vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eShaderSampledRead | vk::AccessFlagBits2::eShaderStorageWrite );
+
+		_command_buffer.fillBuffer( frame.visibility.buffer.get(), 0, sizeof( uint32_t ), 0 );
+
+		memoryBarrier( _command_buffer,
+		               vk::PipelineStageFlagBits2::eTransfer,
+		               vk::AccessFlagBits2::eTransferWrite,
+		               vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite );
+
+		_command_buffer.bindPipeline( vk::PipelineBindPoint::eCompute, m_cull_pipeline.get() );
+		_command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eCompute, m_cull_pipeline_layout.get(), 0, 1, &frame.cull_set, 0, nullptr );
+		_command_buffer.pushConstants( m_cull_pipeline_layout.get(), vk::ShaderStageFlagBits::eCompute, 0, sizeof( constants ), &constants );
+		_command_buffer.dispatch( ( m_draw_count + 63 ) / 64, 1, 1 );
+
+		// The host read happens when this slot comes around again, after its fence has been waited on.
+		memoryBarrier( _command_buffer,
+		               vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eShaderStorageWrite,
+		               vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eHost,
+		               vk::AccessFlagBits2::eIndirectCommandRead | vk::AccessFlagBits2::eHostRead );
+
+		m_culled_camera = _camera;
+	}
+
+	bool cGpuCulling_vulkan::render( const cCamera* _camera )
+	{
+		ZoneScoped;
+
+		if( !m_culled_camera || m_culled_camera != _camera )
+			return false;
+
+		// This frame's cull hasn't been submitted yet, so the slot still holds the results from frames_in_flight frames ago.
+		readVisibility();
+
+		cRenderCallbackManager::render< cPipeline_vulkan >( m_render_callback, static_cast< const cGpuCulling_vulkan* >( this ) );
+		return true;
+	}
+
+	void cGpuCulling_vulkan::readVisibility()
+	{
+		ZoneScoped;
+
+		const vma::Allocator& memory_allocator = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getMemoryAllocator();
+		const sFrame&         frame            = m_frames[ m_frame_index ];
+
+		if( memory_allocator.invalidateAllocation( frame.visibility.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess )
+			DF_LOG_WARNING( "Failed to invalidate culling results" );
+
+		const uint32_t* visibility = static_cast< const uint32_t* >( memory_allocator.getAllocationInfo( frame.visibility.allocation.get() ).pMappedData );
+
+		m_stats.delayed_visible = std::min( visibility[ 0 ], m_capacity );
+		for( uint32_t i = 1; i <= m_stats.delayed_visible; ++i )
+		{
+			if( visibility[ i ] < m_meshes.size() && m_meshes[ visibility[ i ] ] )
+				m_meshes[ visibility[ i ] ]->requestTextureMips();
+		}
+	}
+
+	void cGpuCulling_vulkan::draw( const cPipeline_vulkan* _pipeline ) const
+	{
+		ZoneScoped;
+
+		cRenderer_vulkan*            renderer       = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		sFrameData_vulkan&           frame_data     = renderer->getCurrentFrame();
+		const cGeometryArena_vulkan* geometry_arena = renderer->getGeometryArena();
+		const vk::CommandBuffer&     command_buffer = frame_data.command_buffer.get();
+		const sFrame&                frame          = m_frames[ m_frame_index ];
+
+		const std::array descriptor_sets = { frame_data.vertex_scene_descriptor_set, renderer->getBindlessTextures()->getSet(), frame.object_set };
+		const uint32_t   scene_offset    = renderer->getVertexSceneOffset( m_culled_camera );
+
+		constexpr vk::DeviceSize vertex_offset = 0;
+
+		command_buffer.bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline );
+		renderer->setViewportScissor();
+
+		command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
+		                                   _pipeline->layout,
+		                                   0,
+		                                   static_cast< uint32_t >( descriptor_sets.size() ),
+		                                   descriptor_sets.data(),
+		                                   1,
+		                                   &scene_offset );
+
+		command_buffer.bindVertexBuffers( 0, 1, &geometry_arena->getVertexBuffer(), &vertex_offset );
+		command_buffer.bindIndexBuffer( geometry_arena->getIndexBuffer(), 0, vk::IndexType::eUint32 );
+
+		command_buffer.drawIndexedIndirectCount( frame.commands.buffer.get(),
+		                                         0,
+		                                         frame.visibility.buffer.get(),
+		                                         0,
+		                                         std::min( m_draw_count, renderer->getMaxIndirectDraws() ),
+		                                         static_cast< uint32_t >( sizeof( vk::DrawIndexedIndirectCommand ) ) );
+	}
+
+	void cGpuCulling_vulkan::buildDepthPyramid( const vk::CommandBuffer& _command_buffer, const sAllocatedImage_vulkan& _depth_image )
+	{
+		ZoneScoped;
+
+		if( !m_occlusion || !m_culled_camera )
+			return;
+
+		if( !m_pyramid.image )
+			createDepthPyramid( _depth_image.extent );
+
+		cRenderer_vulkan*  renderer   = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		sFrameData_vulkan& frame_data = renderer->getCurrentFrame();
+
+		depthBarrier( _command_buffer,
+		              _depth_image.image.get(),
+		              vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+		              vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+		              vk::PipelineStageFlagBits2::eComputeShader,
+		              vk::AccessFlagBits2::eShaderSampledRead,
+		              vk::ImageLayout::eDepthAttachmentOptimal,
+		              vk::ImageLayout::eShaderReadOnlyOptimal );
+
+		memoryBarrier( _command_buffer,
+		               vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eShaderStorageWrite,
+		               vk::PipelineStageFlagBits2::eComputeShader,
+		               vk::AccessFlagBits2::eShaderStorageWrite );
+
+		_command_buffer.bindPipeline( vk::PipelineBindPoint::eCompute, m_pyramid_pipeline.get() );
+
+		glm::uvec2 source_size( _depth_image.extent.width, _depth_image.extent.height );
+		for( uint32_t i = 0; i < m_pyramid_mips.size(); ++i )
+		{
+			const sPyramidConstants constants{
+				.source_size      = source_size,
+				.destination_size = glm::uvec2( std::max( m_pyramid.extent.width >> i, 1u ), std::max( m_pyramid.extent.height >> i, 1u ) ),
+			};
+
+			const vk::DescriptorSet descriptor_set = frame_data.descriptors.allocate( m_pyramid_layout.get() );
+
+			sDescriptorWriter_vulkan writer;
+			writer.writeImage( 0,
+			                   i ? m_pyramid_mips[ i - 1 ].get() : _depth_image.image_view.get(),
+			                   renderer->getNearestSampler(),
+			                   i ? vk::ImageLayout::eGeneral : vk::ImageLayout::eShaderReadOnlyOptimal,
+			                   vk::DescriptorType::eCombinedImageSampler );
+			writer.writeImage( 1, m_pyramid_mips[ i ].get(), nullptr, vk::ImageLayout::eGeneral, vk::DescriptorType::eStorageImage );
+			writer.updateSet( descriptor_set );
+
+			_command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eCompute, m_pyramid_pipeline_layout.get(), 0, 1, &descriptor_set, 0, nullptr );
+			_command_buffer.pushConstants( m_pyramid_pipeline_layout.get(), vk::ShaderStageFlagBits::eCompute, 0, sizeof( constants ), &constants );
+			_command_buffer.dispatch( ( constants.destination_size.x + 7 ) / 8, ( constants.destination_size.y + 7 ) / 8, 1 );
+
+			memoryBarrier( _command_buffer,
+			               vk::PipelineStageFlagBits2::eComputeShader,
+			               vk::AccessFlagBits2::eShaderStorageWrite,
+			               vk::PipelineStageFlagBits2::eComputeShader,
+			               vk::AccessFlagBits2::eShaderSampledRead );
+
+			source_size = constants.destination_size;
+		}
+
+		depthBarrier( _command_buffer,
+		              _depth_image.image.get(),
+		              vk::PipelineStageFlagBits2::eComputeShader,
+		              vk::AccessFlagBits2::eNone,
+		              vk::PipelineStageFlagBits2::eEarlyFragmentTests | vk::PipelineStageFlagBits2::eLateFragmentTests,
+		              vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+		              vk::ImageLayout::eShaderReadOnlyOptimal,
+		              vk::ImageLayout::eDepthAttachmentOptimal );
+
+		m_pyramid_camera = m_culled_camera;
+	}
+
+	void cGpuCulling_vulkan::destroyDepthPyramid()
+	{
+		ZoneScoped;
+
+		m_pyramid_mips.clear();
+		m_pyramid_camera = nullptr;
+
+		if( m_pyramid.image )
+			helper::util::destroyImage( m_pyramid );
+	}
+
+	void cGpuCulling_vulkan::setOcclusionCulling( const bool _enabled )
+	{
+		ZoneScoped;
+
+		if( m_occlusion == _enabled )
+			return;
+
+		m_occlusion = _enabled;
+		if( !m_occlusion )
+		{
+			if( reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
+				DF_LOG_ERROR( "Failed to wait for device idle" );
+
+			destroyDepthPyramid();
+		}
+
+		DF_LOG_MESSAGE( "{} occlusion culling", m_occlusion ? "Enabled" : "Disabled" );
+	}
+
+	bool cGpuCulling_vulkan::isSupported( const vk::PhysicalDevice& _physical_device )
+	{
+		ZoneScoped;
+
+		const vk::StructureChain features = _physical_device.getFeatures2< vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features >();
+
+		return features.get< vk::PhysicalDeviceVulkan12Features >().drawIndirectCount;
+	}
+
+	void cGpuCulling_vulkan::createResources()
+	{
+		ZoneScoped;
+
+		const cRenderer_vulkan* renderer       = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		const vk::Device&       logical_device = renderer->getLogicalDevice();
+
+		sDescriptorLayoutBuilder_vulkan layout_builder;
+		layout_builder.addBinding( 0, vk::DescriptorType::eStorageBuffer );
+		layout_builder.addBinding( 1, vk::DescriptorType::eStorageBuffer );
+		layout_builder.addBinding( 2, vk::DescriptorType::eStorageBuffer );
+		layout_builder.addBinding( 3, vk::DescriptorType::eCombinedImageSampler );
+		m_cull_layout = layout_builder.build( logical_device, vk::ShaderStageFlagBits::eCompute );
+
+		layout_builder.clear();
+		layout_builder.addBinding( 0, vk::DescriptorType::eCombinedImageSampler );
+		layout_builder.addBinding( 1, vk::DescriptorType::eStorageImage );
+		m_pyramid_layout = layout_builder.build( logical_device, vk::ShaderStageFlagBits::eCompute );
+
+		const vk::PushConstantRange        cull_range( vk::ShaderStageFlagBits::eCompute, 0, static_cast< uint32_t >( sizeof( sCullConstants ) ) );
+		const vk::PipelineLayoutCreateInfo cull_layout_create_info( vk::PipelineLayoutCreateFlags(), 1, &m_cull_layout.get(), 1, &cull_range );
+		m_cull_pipeline_layout = logical_device.createPipelineLayoutUnique( cull_layout_create_info ).value;
+		m_cull_pipeline        = createComputePipeline( "default_cull.comp", m_cull_pipeline_layout.get() );
+
+		const vk::PushConstantRange        pyramid_range( vk::ShaderStageFlagBits::eCompute, 0, static_cast< uint32_t >( sizeof( sPyramidConstants ) ) );
+		const vk::PipelineLayoutCreateInfo pyramid_layout_create_info( vk::PipelineLayoutCreateFlags(), 1, &m_pyramid_layout.get(), 1, &pyramid_range );
+		m_pyramid_pipeline_layout = logical_device.createPipelineLayoutUnique( pyramid_layout_create_info ).value;
+		m_pyramid_pipeline        = createComputePipeline( "default_depth_pyramid.comp", m_pyramid_pipeline_layout.get() );
+
+		constexpr float far_depth = 1;
+		m_pyramid_placeholder     = helper::util::createImage( &far_depth, vk::Extent3D( 1, 1, 1 ), vk::Format::eR32Sfloat, vk::ImageUsageFlagBits::eSampled );
+
+		const std::vector pool_sizes = {
+			vk::DescriptorPoolSize( vk::DescriptorType::eStorageBuffer, 4 * m_frames_in_flight ),
+			vk::DescriptorPoolSize( vk::DescriptorType::eCombinedImageSampler, m_frames_in_flight ),
+		};
+
+		const vk::DescriptorPoolCreateInfo pool_create_info( vk::DescriptorPoolCreateFlags(), 2 * m_frames_in_flight, pool_sizes );
+		m_descriptor_pool = logical_device.createDescriptorPoolUnique( pool_create_info ).value;
+
+		m_frames.resize( m_frames_in_flight );
+
+		// Each slot keeps its sets, the buffers only change when the capacity grows.
+		const std::array layouts = { m_cull_layout.get(), renderer->getObjectLayout() };
+		for( sFrame& frame: m_frames )
+		{
+			const std::vector< vk::DescriptorSet > descriptor_sets = logical_device.allocateDescriptorSets( vk::DescriptorSetAllocateInfo( m_descriptor_pool.get(), layouts ) ).value;
+
+			frame.cull_set   = descriptor_sets[ 0 ];
+			frame.object_set = descriptor_sets[ 1 ];
+		}
+
+		createFrames();
+
+		DF_LOG_MESSAGE( "Created GPU culling with {} draw slots", m_capacity );
+	}
+
+	void cGpuCulling_vulkan::createFrames()
+	{
+		ZoneScoped;
+
+		const vma::Allocator& memory_allocator = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getMemoryAllocator();
+
+		for( sFrame& frame: m_frames )
+		{
+			frame.draws      = helper::util::createBuffer( sizeof( sDraw ) * m_capacity, vk::BufferUsageFlagBits::eStorageBuffer, vma::MemoryUsage::eCpuToGpu );
+			frame.objects    = helper::util::createBuffer( sizeof( sRenderQueue_vulkan::sObject ) * m_capacity, vk::BufferUsageFlagBits::eStorageBuffer, vma::MemoryUsage::eCpuToGpu );
+			frame.commands   = helper::util::createBuffer( sizeof( vk::DrawIndexedIndirectCommand ) * m_capacity,
+			                                               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+			                                               vma::MemoryUsage::eGpuOnly );
+			frame.visibility = helper::util::createBuffer( sizeof( uint32_t ) * ( m_capacity + 1 ),
+			                                               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer
+			                                                   | vk::BufferUsageFlagBits::eTransferDst,
+			                                               vma::MemoryUsage::eGpuToCpu );
+
+			void* draws      = memory_allocator.getAllocationInfo( frame.draws.allocation.get() ).pMappedData;
+			void* objects    = memory_allocator.getAllocationInfo( frame.objects.allocation.get() ).pMappedData;
+			void* visibility = memory_allocator.getAllocationInfo( frame.visibility.allocation.get() ).pMappedData;
+
+			std::memcpy( draws, m_draws.data(), sizeof( sDraw ) * m_draws.size() );
+			std::memcpy( objects, m_objects.data(), sizeof( sRenderQueue_vulkan::sObject ) * m_objects.size() );
+			std::memset( visibility, 0, sizeof( uint32_t ) * ( m_capacity + 1 ) );
+
+			if( memory_allocator.flushAllocation( frame.draws.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess
+			    || memory_allocator.flushAllocation( frame.objects.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess )
+				DF_LOG_WARNING( "Failed to flush culling draws" );
+
+			sDescriptorWriter_vulkan writer;
+			writer.writeBuffer( 0, frame.draws.buffer.get(), sizeof( sDraw ) * m_capacity, 0, vk::DescriptorType::eStorageBuffer );
+			writer.writeBuffer( 1, frame.commands.buffer.get(), sizeof( vk::DrawIndexedIndirectCommand ) * m_capacity, 0, vk::DescriptorType::eStorageBuffer );
+			writer.writeBuffer( 2, frame.visibility.buffer.get(), sizeof( uint32_t ) * ( m_capacity + 1 ), 0, vk::DescriptorType::eStorageBuffer );
+			writer.updateSet( frame.cull_set );
+
+			writer.clear();
+			writer.writeBuffer( 0, frame.objects.buffer.get(), sizeof( sRenderQueue_vulkan::sObject ) * m_capacity, 0, vk::DescriptorType::eStorageBuffer );
+			writer.updateSet( frame.object_set );
+
+			frame.dirty.clear();
+		}
+	}
+
+	void cGpuCulling_vulkan::createDepthPyramid( const vk::Extent3D& _extent )
+	{
+		ZoneScoped;
+
+		const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+
+		const vk::Extent3D extent( std::bit_floor( _extent.width ), std::bit_floor( _extent.height ), 1 );
+		const uint32_t     mip_count = std::bit_width( std::max( extent.width, extent.height ) );
+
+		m_pyramid = helper::util::createImage( extent, vk::Format::eR32Sfloat, vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled, true );
+
+		for( uint32_t i = 0; i < mip_count; ++i )
+		{
+			vk::ImageViewCreateInfo image_view_create_info = helper::init::imageViewCreateInfo( m_pyramid.format, m_pyramid.image.get(), vk::ImageAspectFlagBits::eColor );
+			image_view_create_info.subresourceRange.baseMipLevel = i;
+
+			m_pyramid_mips.push_back( renderer->getLogicalDevice().createImageViewUnique( image_view_create_info ).value );
+		}
+
+		renderer->immediateSubmit( [ & ]( const vk::CommandBuffer _command_buffer )
+		                           { helper::util::transitionImage( _command_buffer, m_pyramid.image.get(), vk::ImageLayout::eUndefined, vk::ImageLayout::eGeneral ); } );
+
+		DF_LOG_MESSAGE( "Created depth pyramid [{}, {}] with {} mips", extent.width, extent.height, mip_count );
+	}
+
+	void cGpuCulling_vulkan::flush( sFrame& _frame )
+	{
+		ZoneScoped;
+
+		if( _frame.dirty.empty() )
+			return;
+
+		const vma::Allocator& memory_allocator = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getMemoryAllocator();
+
+		sDraw*                       draws   = static_cast< sDraw* >( memory_allocator.getAllocationInfo( _frame.draws.allocation.get() ).pMappedData );
+		sRenderQueue_vulkan::sObject* objects = static_cast< sRenderQueue_vulkan::sObject* >( memory_allocator.getAllocationInfo( _frame.objects.allocation.get() ).pMappedData );
+
+		for( const uint32_t slot: _frame.dirty )
+		{
+			if( slot >= m_capacity )
+				continue;
+
+			draws[ slot ]   = m_draws[ slot ];
+			objects[ slot ] = m_objects[ slot ];
+		}
+
+		_frame.dirty.clear();
+
+		if( memory_allocator.flushAllocation( _frame.draws.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess
+		    || memory_allocator.flushAllocation( _frame.objects.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess )
+			DF_LOG_WARNING( "Failed to flush culling draws" );
+	}
+
+	void cGpuCulling_vulkan::refreshTextures()
+	{
+		ZoneScoped;
+
+		m_texture_version = cTexture_vulkan::getLatestVersion();
+
+		for( uint32_t slot = 0; slot < m_meshes.size(); ++slot )
+		{
+			const cMesh_vulkan* mesh = m_meshes[ slot ];
+			if( !mesh )
+				continue;
+
+			sRenderQueue_vulkan::sObject& object   = m_objects[ slot ];
+			const uint32_t                color    = getBindlessIndex( mesh, aiTextureType_DIFFUSE );
+			const uint32_t                normal   = getBindlessIndex( mesh, aiTextureType_NORMALS );
+			const uint32_t                specular = getBindlessIndex( mesh, aiTextureType_SPECULAR );
+
+			if( object.color_texture == color && object.normal_texture == normal && object.specular_texture == specular )
+				continue;
+
+			object.color_texture    = color;
+			object.normal_texture   = normal;
+			object.specular_texture = specular;
+
+			for( sFrame& frame: m_frames )
+				frame.dirty.push_back( slot );
+		}
+	}
+
+	vk::UniquePipeline cGpuCulling_vulkan::createComputePipeline( const std::string& _shader, const vk::PipelineLayout& _layout )
+	{
+		ZoneScoped;
+
+		const cRenderer_vulkan* renderer       = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		const vk::Device&       logical_device = renderer->getLogicalDevice();
+
+		const vk::ShaderModule              module = helper::util::createShaderModule( _shader );
+		const vk::ComputePipelineCreateInfo create_info( vk::PipelineCreateFlags(), helper::init::pipelineShaderStageCreateInfo( vk::ShaderStageFlagBits::eCompute, module ), _layout );
+
+		vk::UniquePipeline pipeline = logical_device.createComputePipelineUnique( renderer->getPipelineCache()->getCache(), create_info ).value;
+		logical_device.destroyShaderModule( module );
+
+		DF_LOG_MESSAGE( "Created compute pipeline: {}", _shader );
+		return pipeline;
+	}
+}
@@ -0,0 +1,133 @@
+﻿#pragma once
+
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+#include "engine/misc/Misc.h"
+#include "misc/Types_vulkan.h"
+
+namespace df
+{
+	struct iRenderCallback;
+}
+
+namespace df::vulkan
+{
+	class cMesh_vulkan;
+	class cPipeline_vulkan;
+
+	class cGpuCulling_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cGpuCulling_vulkan )
+
+		struct sDraw
+		{
+			glm::vec4 sphere;
+			uint32_t  index_count;
+			uint32_t  first_index;
+			int32_t   vertex_offset;
+			uint32_t  padding;
+		};
+
+		struct sStats
+		{
+			uint32_t draws;
+			uint32_t delayed_visible;
+		};
+
+		explicit cGpuCulling_vulkan( uint32_t _frames_in_flight, uint32_t _capacity = 16 * 1024 );
+		~cGpuCulling_vulkan();
+
+		void set( uint32_t _slot, const cMesh_vulkan* _mesh );
+		void set( uint32_t _slot, const sDraw& _draw, const sRenderQueue_vulkan::sObject& _object );
+		void remove( uint32_t _slot );
+
+		void update( uint64_t _frame );
+
+		void cull( const vk::CommandBuffer& _command_buffer, const cCamera* _camera );
+		bool render( const cCamera* _camera );
+		void draw( const cPipeline_vulkan* _pipeline ) const;
+
+		// Reads the visible count of the current slot into the stats, its last cull has to have completed.
+		void readVisibility();
+
+		void buildDepthPyramid( const vk::CommandBuffer& _command_buffer, const sAllocatedImage_vulkan& _depth_image );
+		void destroyDepthPyramid();
+
+		void setRenderCallback( iRenderCallback* _render_callback ) { m_render_callback = _render_callback; }
+		void setOcclusionCulling( bool _enabled );
+		bool getOcclusionCulling() const { return m_occlusion; }
+
+		const sStats& getStats() const { return m_stats; }
+
+		static bool isSupported( const vk::PhysicalDevice& _physical_device );
+
+	private:
+		struct sFrame
+		{
+			sAllocatedBuffer_vulkan draws;
+			sAllocatedBuffer_vulkan objects;
+			sAllocatedBuffer_vulkan commands;
+			sAllocatedBuffer_vulkan visibility;
+			vk::DescriptorSet       cull_set;
+			vk::DescriptorSet       object_set;
+			std::vector< uint32_t > dirty;
+		};
+
+		struct sCullConstants
+		{
+			glm::mat4 view_projection;
+			glm::vec2 pyramid_size;
+			uint32_t  draw_count;
+			uint32_t  occlusion;
+		};
+
+		struct sPyramidConstants
+		{
+			glm::uvec2 source_size;
+			glm::uvec2 destination_size;
+		};
+
+		void createResources();
+		void createFrames();
+		void createDepthPyramid( const vk::Extent3D& _extent );
+		void flush( sFrame& _frame );
+		void refreshTextures();
+
+		static vk::UniquePipeline createComputePipeline( const std::string& _shader, const vk::PipelineLayout& _layout );
+
+		std::vector< sFrame >                       m_frames;
+		std::vector< const cMesh_vulkan* >          m_meshes;
+		std::vector< sDraw >                        m_draws;
+		std::vector< sRenderQueue_vulkan::sObject > m_objects;
+
+		vk::UniqueDescriptorPool      m_descriptor_pool;
+		vk::UniqueDescriptorSetLayout m_cull_layout;
+		vk::UniquePipelineLayout      m_cull_pipeline_layout;
+		vk::UniquePipeline            m_cull_pipeline;
+
+		vk::UniqueDescriptorSetLayout      m_pyramid_layout;
+		vk::UniquePipelineLayout           m_pyramid_pipeline_layout;
+		vk::UniquePipeline                 m_pyramid_pipeline;
+		sAllocatedImage_vulkan             m_pyramid;
+		std::vector< vk::UniqueImageView > m_pyramid_mips;
+		sAllocatedImage_vulkan             m_pyramid_placeholder;
+		const cCamera*                     m_pyramid_camera;
+
+		iRenderCallback* m_render_callback;
+		const cCamera*   m_culled_camera;
+		bool             m_occlusion;
+
+		uint32_t m_capacity;
+		uint32_t m_count;
+		uint32_t m_draw_count;
+		uint32_t m_texture_version;
+		uint32_t m_frames_in_flight;
+		uint32_t m_frame_index;
+
+		sStats m_stats;
+	};
+}
@@ -1,4 +1,4 @@
-#include "cRenderer_vulkan.h"
+﻿#include "cRenderer_vulkan.h"
 
 #include "engine/rendering/cRenderer.h"
 
@@ -14,17 +14,35 @@ VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
 #include <imgui_impl_vulkan.h>
 #include <vulkan/vulkan_to_string.hpp>
 
+#include "cBindlessTextures_vulkan.h"
+#include "cGeometryArena_vulkan.h"
+#include "cGpuCulling_vulkan.h"
+#include "cTextureStreamer_vulkan.h"
+#include "cUploadManager_vulkan.h"
 #include "descriptor/sDescriptorLayoutBuilder_vulkan.h"
+#include "descriptor/sDescriptorWriter_vulkan.h"
 #include "engine/managers/assets/cCameraManager.h"
+#include "engine/managers/assets/cModelManager.h"
 #include "engine/managers/cEventManager.h"
+#include "engine/managers/cJobManager.h"
+#include "engine/rendering/assets/iMesh.h"
 #include "misc/Helper_vulkan.h"
+#include "pipeline/cPipelineCache_vulkan.h"
 
 namespace df::vulkan
 {
 	cRenderer_vulkan::cRenderer_vulkan( const std::string& _window_name )
-		: m_frames_in_flight( 3 )
+		: m_pipeline_cache( nullptr )
+		, m_upload_manager( nullptr )
+		, m_texture_streamer( nullptr )
+		, m_geometry_arena( nullptr )
+		, m_bindless_textures( nullptr )
+		, m_gpu_culling( nullptr )
+		, m_max_indirect_draws( 0 )
+		, m_frames_in_flight( 3 )
 		, m_frame_number( 0 )
 		, m_frame_datas( m_frames_in_flight )
+		, m_render_queue_stats{}
 	{
 		ZoneScoped;
 
@@ -36,7 +54,7 @@ namespace df::vulkan
 		if( !m_window )
 			DF_LOG_ERROR( "Failed to create window" );
 		else
-			DF_LOG_MESSAGE( fmt::format( "Created window [{}, {}]", m_window_size.x, m_window_size.y ) );
+			DF_LOG_MESSAGE( "Created window [{}, {}]", m_window_size.x, m_window_size.y );
 
 		glfwSetWindowUserPointer( m_window, this );
 		glfwSetFramebufferSizeCallback( m_window, framebufferSizeCallback );
@@ -46,8 +64,14 @@ namespace df::vulkan
 		uint32_t     extension_count;
 		const char** required_extensions = glfwGetRequiredInstanceExtensions( &extension_count );
 
-		const std::vector instance_layer_names     = { "VK_LAYER_KHRONOS_validation" };
-		std::vector       instance_extension_names = { vk::EXTDebugUtilsExtensionName };
+		std::vector< const char* > instance_layer_names;
+		std::vector                instance_extension_names = { vk::EXTDebugUtilsExtensionName };
+
+		const std::vector< vk::LayerProperties > layer_properties = vk::enumerateInstanceLayerProperties().value;
+		if( std::ranges::any_of( layer_properties, []( const vk::LayerProperties& _layer ) { return std::string_view( _layer.layerName.data() ) == "VK_LAYER_KHRONOS_validation"; } ) )
+			instance_layer_names.push_back( "VK_LAYER_KHRONOS_validation" );
+		else
+			DF_LOG_WARNING( "Validation layer isn't available" );
 
 		for( uint32_t i = 0; i < extension_count; ++i )
 			instance_extension_names.push_back( required_extensions[ i ] );
@@ -81,38 +105,98 @@ namespace df::vulkan
 		                              []( vk::QueueFamilyProperties const& _properties ) { return _properties.queueFlags & vk::QueueFlagBits::eGraphics; } );
 
 		m_graphics_queue_family = static_cast< uint32_t >( std::distance( queue_family_properties.begin(), it ) );
+		m_transfer_queue_family = cUploadManager_vulkan::findTransferQueueFamily( queue_family_properties, m_graphics_queue_family );
 
 		std::vector device_extension_names = { vk::KHRSwapchainExtensionName };
 #ifdef PROFILING
 		device_extension_names.push_back( vk::KHRCalibratedTimestampsExtensionName );
 #endif
 
-		vk::PhysicalDeviceSynchronization2Features    synchronization2_features( true );
-		vk::PhysicalDeviceBufferDeviceAddressFeatures buffer_device_address_features( true, false, false, &synchronization2_features );
-		vk::PhysicalDeviceDynamicRenderingFeatures    dynamic_rendering_features( true, &buffer_device_address_features );
+		bool bindless = false;
+#ifdef DF_BINDLESS_TEXTURES
+		bindless = cBindlessTextures_vulkan::isSupported( m_physical_device );
+#endif
+
+		const vk::PhysicalDeviceFeatures supported_features = m_physical_device.getFeatures();
+		const bool                       draw_indirect      = supported_features.multiDrawIndirect && supported_features.drawIndirectFirstInstance;
+
+		m_max_indirect_draws = draw_indirect ? m_physical_device.getProperties().limits.maxDrawIndirectCount : 0;
+
+		const bool gpu_culling = bindless && draw_indirect && cGpuCulling_vulkan::isSupported( m_physical_device );
+
+		vk::PhysicalDeviceFeatures device_features;
+		device_features.setMultiDrawIndirect( draw_indirect ).setDrawIndirectFirstInstance( draw_indirect );
+
+		vk::PhysicalDeviceVulkan12Features vulkan12_features;
+		vulkan12_features.setBufferDeviceAddress( true ).setDrawIndirectCount( gpu_culling ).setTimelineSemaphore( true );
+
+		if( bindless )
+		{
+			vulkan12_features.setShaderSampledImageArrayNonUniformIndexing( true )
+				.setDescriptorBindingSampledImageUpdateAfterBind( true )
+				.setDescriptorBindingUpdateUnusedWhilePending( true )
+				.setDescriptorBindingPartiallyBound( true )
+				.setRuntimeDescriptorArray( true );
+		}
+
+		vk::PhysicalDeviceSynchronization2Features synchronization2_features( true, &vulkan12_features );
+		vk::PhysicalDeviceDynamicRenderingFeatures dynamic_rendering_features( true, &synchronization2_features );
+
+		constexpr float                          queue_priority = 0;
+		std::vector< vk::DeviceQueueCreateInfo > device_queue_create_infos{
+			vk::DeviceQueueCreateInfo( vk::DeviceQueueCreateFlags(), m_graphics_queue_family, 1, &queue_priority )
+		};
+		if( m_transfer_queue_family != m_graphics_queue_family )
+			device_queue_create_infos.emplace_back( vk::DeviceQueueCreateFlags(), m_transfer_queue_family, 1, &queue_priority );
 
-		constexpr float           queue_priority = 0;
-		vk::DeviceQueueCreateInfo device_queue_create_info( vk::DeviceQueueCreateFlags(), m_graphics_queue_family, 1, &queue_priority );
 		m_logical_device = m_physical_device
 		                       .createDeviceUnique(
-								   vk::DeviceCreateInfo( vk::DeviceCreateFlags(), device_queue_create_info, {}, device_extension_names, {}, &dynamic_rendering_features ) )
+								   vk::DeviceCreateInfo( vk::DeviceCreateFlags(), device_queue_create_infos, {}, device_extension_names, &device_features, &dynamic_rendering_features ) )
 		                       .value;
 		m_graphics_queue = m_logical_device->getQueue( m_graphics_queue_family, 0 );
+		m_transfer_queue = m_logical_device->getQueue( m_transfer_queue_family, 0 );
 
 		VULKAN_HPP_DEFAULT_DISPATCHER.init( m_logical_device.get() );
 
 		createMemoryAllocator();
+		m_pipeline_cache   = new cPipelineCache_vulkan( m_physical_device, m_logical_device.get() );
+		m_upload_manager   = new cUploadManager_vulkan( m_logical_device.get(), memory_allocator.get(), m_graphics_queue_family, m_transfer_queue, m_transfer_queue_family );
+		m_texture_streamer = new cTextureStreamer_vulkan( m_frames_in_flight );
+		m_geometry_arena   = new cGeometryArena_vulkan( m_frames_in_flight, static_cast< uint32_t >( sizeof( iMesh::sVertex ) ) );
 		createSwapchain( m_window_size.x, m_window_size.y );
 		createFrameDatas();
 		createSubmitContext();
 
 		sDescriptorLayoutBuilder_vulkan layout_builder;
-		layout_builder.addBinding( 0, vk::DescriptorType::eUniformBuffer );
+		layout_builder.addBinding( 0, vk::DescriptorType::eUniformBufferDynamic );
 		m_vertex_scene_uniform_layout = layout_builder.build( m_logical_device.get(), vk::ShaderStageFlagBits::eVertex );
 
+		layout_builder.clear();
+		layout_builder.addBinding( 0, vk::DescriptorType::eStorageBuffer );
+		m_object_layout = layout_builder.build( m_logical_device.get(), vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment );
+
+		if( !m_max_indirect_draws )
+			DF_LOG_MESSAGE( "Multi draw indirect isn't supported, issuing draws directly" );
+
+		std::vector< sDescriptorAllocator_vulkan::sPoolSizeRatio > static_sizes{
+			{vk::DescriptorType::eCombinedImageSampler, 3},
+		};
+
+		m_static_descriptors.create( m_logical_device.get(), 1000, static_sizes );
+
 		m_sampler_linear  = m_logical_device->createSamplerUnique( vk::SamplerCreateInfo( vk::SamplerCreateFlags(), vk::Filter::eLinear, vk::Filter::eLinear ) ).value;
 		m_sampler_nearest = m_logical_device->createSamplerUnique( vk::SamplerCreateInfo( vk::SamplerCreateFlags(), vk::Filter::eNearest, vk::Filter::eNearest ) ).value;
 
+		if( bindless )
+			m_bindless_textures = new cBindlessTextures_vulkan( m_physical_device, m_logical_device.get(), m_sampler_nearest.get(), m_frames_in_flight );
+		else
+			DF_LOG_MESSAGE( "Bindless textures are disabled or descriptor indexing isn't supported, using per-asset texture descriptor sets" );
+
+		if( gpu_culling )
+			m_gpu_culling = new cGpuCulling_vulkan( m_frames_in_flight );
+		else
+			DF_LOG_MESSAGE( "Draw indirect count isn't supported, culling meshes on the CPU" );
+
 		DF_LOG_MESSAGE( "Initialized renderer" );
 	}
 
@@ -131,11 +215,21 @@ namespace df::vulkan
 			ImGui::DestroyContext();
 		}
 
+		delete m_gpu_culling;
+		delete m_bindless_textures;
+
 		m_sampler_nearest.reset();
 		m_sampler_linear.reset();
 
+		m_static_descriptors.destroy();
+		m_object_layout.reset();
 		m_vertex_scene_uniform_layout.reset();
 
+		delete m_geometry_arena;
+		delete m_texture_streamer;
+		delete m_upload_manager;
+		delete m_pipeline_cache;
+
 		TracyVkDestroy( m_submit_context.tracy_context );
 		m_submit_context.command_buffer.reset();
 		m_submit_context.command_pool.reset();
@@ -147,13 +241,13 @@ namespace df::vulkan
 
 			frame_data.descriptors.destroy();
 
-			helper::util::destroyBuffer( frame_data.vertex_scene_uniform_buffer_2d );
-			helper::util::destroyBuffer( frame_data.vertex_scene_uniform_buffer_3d );
+			frame_data.uniform_allocator.destroy();
 
 			frame_data.render_fence.reset();
 			frame_data.render_semaphore.reset();
 			frame_data.swapchain_semaphore.reset();
 
+			frame_data.worker_commands.clear();
 			frame_data.command_buffer.reset();
 			frame_data.command_pool.reset();
 		}
@@ -195,6 +289,32 @@ namespace df::vulkan
 		if( result != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to wait for fences" );
 
+		frame_data.uniform_allocator.clear();
+		frame_data.vertex_scene_offsets.clear();
+		frame_data.render_queue.reset();
+		frame_data.vertex_scene_descriptor_set = frame_data.descriptors.allocate( m_vertex_scene_uniform_layout.get() );
+
+		sDescriptorWriter_vulkan writer_scene;
+		writer_scene.writeBuffer( 0,
+		                          frame_data.uniform_allocator.getBuffer(),
+		                          sizeof( sVertexSceneUniforms_vulkan ),
+		                          0,
+		                          vk::DescriptorType::eUniformBufferDynamic );
+		writer_scene.updateSet( frame_data.vertex_scene_descriptor_set );
+
+		frame_data.object_descriptor_set = frame_data.descriptors.allocate( m_object_layout.get() );
+
+		sDescriptorWriter_vulkan writer_object;
+		writer_object.writeBuffer( 0, frame_data.uniform_allocator.getBuffer(), vk::WholeSize, 0, vk::DescriptorType::eStorageBuffer );
+		writer_object.updateSet( frame_data.object_descriptor_set );
+
+		m_texture_streamer->update( m_frame_number );
+		m_geometry_arena->update( m_frame_number );
+		if( m_bindless_textures )
+			m_bindless_textures->update( m_frame_number );
+		if( m_gpu_culling )
+			m_gpu_culling->update( m_frame_number );
+
 		uint32_t swapchain_image_index;
 		result = m_logical_device->acquireNextImageKHR( m_swapchain.get(),
 		                                                std::numeric_limits< uint64_t >::max(),
@@ -220,6 +340,12 @@ namespace df::vulkan
 
 		m_logical_device->resetCommandPool( frame_data.command_pool.get() );
 
+		for( sWorkerCommands_vulkan& worker_commands: frame_data.worker_commands )
+		{
+			m_logical_device->resetCommandPool( worker_commands.command_pool.get() );
+			worker_commands.used = 0;
+		}
+
 		const vk::CommandBufferBeginInfo command_buffer_begin_info = helper::init::commandBufferBeginInfo();
 
 		if( command_buffer->begin( &command_buffer_begin_info ) != vk::Result::eSuccess )
@@ -228,6 +354,9 @@ namespace df::vulkan
 			return;
 		}
 
+		const uint64_t upload_value = m_upload_manager->acquire( command_buffer.get() );
+		m_texture_streamer->record( command_buffer.get() );
+
 		{
 			TracyVkZone( frame_data.tracy_context, command_buffer.get(), __FUNCTION__ );
 
@@ -238,6 +367,9 @@ namespace df::vulkan
 			else
 			{
 				cEventManager::invoke( event::render_3d );
+				if( m_gpu_culling )
+					m_gpu_culling->buildDepthPyramid( command_buffer.get(), m_depth_image );
+
 				cEventManager::invoke( event::render_2d );
 			}
 
@@ -271,17 +403,27 @@ namespace df::vulkan
 			                               vk::ImageLayout::ePresentSrcKHR );
 		}
 
+		m_render_queue_stats = frame_data.render_queue.getStats();
+		TracyPlot( "State changes saved", static_cast< int64_t >( m_render_queue_stats.state_changes_saved ) );
+		if( m_gpu_culling )
+			TracyPlot( "GPU visible draws (delayed)", static_cast< int64_t >( m_gpu_culling->getStats().delayed_visible ) );
+
 		TracyVkCollect( frame_data.tracy_context, command_buffer.get() );
 
 		if( command_buffer->end() != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to end command buffer" );
 
-		const vk::CommandBufferSubmitInfo command_buffer_submit_info   = helper::init::commandBufferSubmitInfo( command_buffer.get() );
-		const vk::SemaphoreSubmitInfo     wait_semaphore_submit_info   = helper::init::semaphoreSubmitInfo( vk::PipelineStageFlagBits2::eColorAttachmentOutput,
-                                                                                                      frame_data.swapchain_semaphore.get() );
-		const vk::SemaphoreSubmitInfo     signal_semaphore_submit_info = helper::init::semaphoreSubmitInfo( vk::PipelineStageFlagBits2::eAllGraphics,
-                                                                                                        frame_data.render_semaphore.get() );
-		const vk::SubmitInfo2             submit_info = helper::init::submitInfo( &command_buffer_submit_info, &signal_semaphore_submit_info, &wait_semaphore_submit_info );
+		frame_data.uniform_allocator.flush();
+
+		std::vector< vk::SemaphoreSubmitInfo > wait_semaphore_submit_infos{
+			helper::init::semaphoreSubmitInfo( vk::PipelineStageFlagBits2::eColorAttachmentOutput, frame_data.swapchain_semaphore.get() )
+		};
+		if( upload_value )
+			wait_semaphore_submit_infos.emplace_back( m_upload_manager->getSemaphore(), upload_value, vk::PipelineStageFlagBits2::eAllCommands, 0 );
+
+		const std::vector     command_buffer_submit_infos   = { helper::init::commandBufferSubmitInfo( command_buffer.get() ) };
+		const std::vector     signal_semaphore_submit_infos = { helper::init::semaphoreSubmitInfo( vk::PipelineStageFlagBits2::eAllGraphics, frame_data.render_semaphore.get() ) };
+		const vk::SubmitInfo2 submit_info                   = helper::init::submitInfo( command_buffer_submit_infos, signal_semaphore_submit_infos, wait_semaphore_submit_infos );
 
 		if( m_graphics_queue.submit2( 1, &submit_info, frame_data.render_fence.get() ) != vk::Result::eSuccess )
 		{
@@ -324,20 +466,131 @@ namespace df::vulkan
 		                                                                                   depth ? &clear_depth_stencil_value : nullptr,
 		                                                                                   vk::ImageLayout::eDepthAttachmentOptimal );
 
-		const vk::RenderingInfo rendering_info = helper::init::renderingInfo( m_render_extent, &color_attachment, &depth_attachment );
-		command_buffer->beginRendering( &rendering_info );
+		beginRenderingScope( command_buffer.get(), { color_attachment }, { m_render_image.format }, depth_attachment );
 	}
 
 	void cRenderer_vulkan::endRendering()
 	{
 		ZoneScoped;
-		const sFrameData_vulkan& frame_data = getCurrentFrame();
+		sFrameData_vulkan& frame_data = getCurrentFrame();
 		TracyVkZone( frame_data.tracy_context, frame_data.command_buffer.get(), __FUNCTION__ );
 
+		constexpr uint32_t draws_per_range = 1024;
+
 		const vk::UniqueCommandBuffer& command_buffer = frame_data.command_buffer;
+		const uint32_t                 ranges         = std::min( static_cast< uint32_t >( frame_data.worker_commands.size() ),
+		                                                          frame_data.render_queue.getDrawCount() / draws_per_range );
+
+		if( ranges > 1 )
+		{
+			command_buffer->endRendering();
+			recordParallel( frame_data, ranges );
+		}
+		else
+			frame_data.render_queue.flush( command_buffer.get(), m_render_extent, frame_data.uniform_allocator, m_max_indirect_draws );
+
 		command_buffer->endRendering();
 	}
 
+	void cRenderer_vulkan::beginRenderingScope( const vk::CommandBuffer&                   _command_buffer,
+	                                            std::vector< vk::RenderingAttachmentInfo > _color_attachments,
+	                                            std::vector< vk::Format >                  _color_formats,
+	                                            const vk::RenderingAttachmentInfo&         _depth_attachment )
+	{
+		ZoneScoped;
+
+		m_color_attachments = std::move( _color_attachments );
+		m_color_formats     = std::move( _color_formats );
+		m_depth_attachment  = _depth_attachment;
+
+		const vk::RenderingInfo rendering_info = helper::init::renderingInfo( m_render_extent, m_color_attachments, &m_depth_attachment );
+
+		cullMeshes( _command_buffer );
+		_command_buffer.beginRendering( &rendering_info );
+	}
+
+	void cRenderer_vulkan::recordParallel( sFrameData_vulkan& _frame_data, const uint32_t _ranges )
+	{
+		ZoneScoped;
+
+		for( vk::RenderingAttachmentInfo& color_attachment: m_color_attachments )
+			color_attachment.loadOp = vk::AttachmentLoadOp::eLoad;
+
+		m_depth_attachment.loadOp = vk::AttachmentLoadOp::eLoad;
+
+		std::vector< vk::CommandBuffer > command_buffers;
+		for( uint32_t i = 0; i < _ranges; ++i )
+			command_buffers.push_back( beginSecondary( _frame_data.worker_commands[ i ] ) );
+
+		_frame_data.render_queue.flush( command_buffers, m_render_extent, _frame_data.uniform_allocator, m_max_indirect_draws );
+
+		for( const vk::CommandBuffer& command_buffer: command_buffers )
+		{
+			if( command_buffer.end() != vk::Result::eSuccess )
+				DF_LOG_ERROR( "Failed to end secondary command buffer" );
+		}
+
+		const vk::PipelineStageFlags2 attachment_stages = vk::PipelineStageFlagBits2::eColorAttachmentOutput | vk::PipelineStageFlagBits2::eEarlyFragmentTests
+		                                                | vk::PipelineStageFlagBits2::eLateFragmentTests;
+
+		const vk::MemoryBarrier2 memory_barrier( attachment_stages,
+		                                         vk::AccessFlagBits2::eColorAttachmentWrite | vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+		                                         attachment_stages,
+		                                         vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite
+		                                             | vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite );
+		const vk::DependencyInfo dependency_info( vk::DependencyFlags(), 1, &memory_barrier, 0, nullptr, 0, nullptr );
+
+		vk::RenderingInfo rendering_info = helper::init::renderingInfo( m_render_extent, m_color_attachments, &m_depth_attachment );
+		rendering_info.flags             = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
+
+		const vk::CommandBuffer& command_buffer = _frame_data.command_buffer.get();
+		command_buffer.pipelineBarrier2( dependency_info );
+		command_buffer.beginRendering( &rendering_info );
+		command_buffer.executeCommands( static_cast< uint32_t >( command_buffers.size() ), command_buffers.data() );
+	}
+
+	vk::CommandBuffer cRenderer_vulkan::beginSecondary( sWorkerCommands_vulkan& _worker_commands ) const
+	{
+		ZoneScoped;
+
+		if( _worker_commands.used == _worker_commands.command_buffers.size() )
+		{
+			const vk::CommandBufferAllocateInfo allocate_info( _worker_commands.command_pool.get(), vk::CommandBufferLevel::eSecondary, 1 );
+			_worker_commands.command_buffers.push_back( std::move( m_logical_device->allocateCommandBuffersUnique( allocate_info ).value.front() ) );
+		}
+
+		const vk::CommandBuffer command_buffer = _worker_commands.command_buffers[ _worker_commands.used++ ].get();
+
+		const vk::CommandBufferInheritanceRenderingInfo rendering_info( vk::RenderingFlags(),
+		                                                                0,
+		                                                                static_cast< uint32_t >( m_color_formats.size() ),
+		                                                                m_color_formats.data(),
+		                                                                m_depth_image.format,
+		                                                                vk::Format::eUndefined,
+		                                                                vk::SampleCountFlagBits::e1 );
+		const vk::CommandBufferInheritanceInfo inheritance_info( nullptr, 0, nullptr, false, vk::QueryControlFlags(), vk::QueryPipelineStatisticFlags(), &rendering_info );
+
+		vk::CommandBufferBeginInfo begin_info = helper::init::commandBufferBeginInfo( vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+		                                                                              | vk::CommandBufferUsageFlagBits::eRenderPassContinue );
+		begin_info.pInheritanceInfo           = &inheritance_info;
+
+		if( command_buffer.begin( &begin_info ) != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to begin secondary command buffer" );
+
+		return command_buffer;
+	}
+
+	void cRenderer_vulkan::cullMeshes( const vk::CommandBuffer& _command_buffer ) const
+	{
+		ZoneScoped;
+
+		if( !m_gpu_culling )
+			return;
+
+		cModelManager::refitBounds();
+		m_gpu_culling->cull( _command_buffer, cCameraManager::getInstance()->current );
+	}
+
 	void cRenderer_vulkan::immediateSubmit( const std::function< void( vk::CommandBuffer ) >& _function ) const
 	{
 		ZoneScoped;
@@ -381,6 +634,29 @@ namespace df::vulkan
 			DF_LOG_ERROR( "Failed to wait for fences" );
 	}
 
+	uint32_t cRenderer_vulkan::getVertexSceneOffset( const cCamera* _camera )
+	{
+		ZoneScoped;
+
+		sFrameData_vulkan& frame_data = getCurrentFrame();
+		for( const auto& [ camera, offset ]: frame_data.vertex_scene_offsets )
+		{
+			if( camera == _camera )
+				return offset;
+		}
+
+		const sVertexSceneUniforms_vulkan vertex_scene_uniforms{
+			.view_projection = _camera->view_projection,
+		};
+
+		const sFrameAllocator_vulkan::sAllocation allocation = frame_data.uniform_allocator.push( vertex_scene_uniforms );
+		if( !allocation.isValid() )
+			return 0;
+
+		frame_data.vertex_scene_offsets.emplace_back( _camera, allocation.offset );
+		return allocation.offset;
+	}
+
 	void cRenderer_vulkan::setViewport()
 	{
 		const vk::Viewport viewport( 0, 0, static_cast< float >( m_render_extent.width ), static_cast< float >( m_render_extent.height ), 0, 1 );
@@ -441,6 +717,7 @@ namespace df::vulkan
 			.MinImageCount               = 3,
 			.ImageCount                  = 3,
 			.MSAASamples                 = static_cast< VkSampleCountFlagBits >( vk::SampleCountFlagBits::e1 ),
+			.PipelineCache               = m_pipeline_cache->getCache(),
 			.UseDynamicRendering         = true,
 			.PipelineRenderingCreateInfo = {
 				.sType					 = static_cast< VkStructureType >( vk::StructureType::ePipelineRenderingCreateInfo ),
@@ -510,7 +787,7 @@ namespace df::vulkan
 			.format = vk::Format::eR16G16B16A16Sfloat,
 		};
 
-		constexpr vk::ImageUsageFlags depth_usage_flags       = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eTransferDst;
+		constexpr vk::ImageUsageFlags depth_usage_flags       = vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
 		const vk::ImageCreateInfo     depth_image_create_info = helper::init::imageCreateInfo( m_depth_image.format, depth_usage_flags, m_depth_image.extent );
 
 		constexpr vk::ImageUsageFlags render_usage_flags = vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eStorage
@@ -542,9 +819,11 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
-		const vk::CommandPoolCreateInfo command_pool_create_info = helper::init::commandPoolCreateInfo( m_graphics_queue_family );
-		const vk::SemaphoreCreateInfo   semaphore_create_info    = helper::init::semaphoreCreateInfo();
-		const vk::FenceCreateInfo       fence_create_info        = helper::init::fenceCreateInfo();
+		const vk::CommandPoolCreateInfo command_pool_create_info        = helper::init::commandPoolCreateInfo( m_graphics_queue_family );
+		const vk::CommandPoolCreateInfo worker_command_pool_create_info = helper::init::commandPoolCreateInfo( m_graphics_queue_family,
+		                                                                                                       vk::CommandPoolCreateFlagBits::eTransient );
+		const vk::SemaphoreCreateInfo   semaphore_create_info           = helper::init::semaphoreCreateInfo();
+		const vk::FenceCreateInfo       fence_create_info               = helper::init::fenceCreateInfo();
 
 		for( sFrameData_vulkan& frame_data: m_frame_datas )
 		{
@@ -553,23 +832,27 @@ namespace df::vulkan
 			vk::CommandBufferAllocateInfo command_buffer_allocate_info = helper::init::commandBufferAllocateInfo( frame_data.command_pool.get() );
 			frame_data.command_buffer.swap( m_logical_device->allocateCommandBuffersUnique( command_buffer_allocate_info ).value.front() );
 
+			frame_data.worker_commands.resize( cJobManager::getThreadCount() + 1 );
+			for( sWorkerCommands_vulkan& worker_commands: frame_data.worker_commands )
+			{
+				worker_commands.command_pool = m_logical_device->createCommandPoolUnique( worker_command_pool_create_info ).value;
+				worker_commands.used         = 0;
+			}
+
 			frame_data.swapchain_semaphore = m_logical_device->createSemaphoreUnique( semaphore_create_info ).value;
 			frame_data.render_semaphore    = m_logical_device->createSemaphoreUnique( semaphore_create_info ).value;
 			frame_data.render_fence        = m_logical_device->createFenceUnique( fence_create_info ).value;
 
-			frame_data.vertex_scene_uniform_buffer_3d = helper::util::createBuffer( sizeof( sVertexSceneUniforms_vulkan ),
-			                                                                        vk::BufferUsageFlagBits::eUniformBuffer,
-			                                                                        vma::MemoryUsage::eCpuToGpu,
-			                                                                        memory_allocator.get() );
-			frame_data.vertex_scene_uniform_buffer_2d = helper::util::createBuffer( sizeof( sVertexSceneUniforms_vulkan ),
-			                                                                        vk::BufferUsageFlagBits::eUniformBuffer,
-			                                                                        vma::MemoryUsage::eCpuToGpu,
-			                                                                        memory_allocator.get() );
+			frame_data.uniform_allocator.create( memory_allocator.get(),
+			                                     4 * 1024 * 1024,
+			                                     m_physical_device.getProperties().limits.minUniformBufferOffsetAlignment,
+			                                     vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer );
 
 			std::vector< sDescriptorAllocator_vulkan::sPoolSizeRatio > frame_sizes{
 				{vk::DescriptorType::eStorageImage,          3},
 				{ vk::DescriptorType::eStorageBuffer,        3},
 				{ vk::DescriptorType::eUniformBuffer,        3},
+				{ vk::DescriptorType::eUniformBufferDynamic, 1},
 				{ vk::DescriptorType::eCombinedImageSampler, 3},
 			};
 
@@ -641,6 +924,9 @@ namespace df::vulkan
 		if( m_logical_device->waitIdle() != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to wait for device idle" );
 
+		if( m_gpu_culling )
+			m_gpu_culling->destroyDepthPyramid();
+
 		m_window_size.x = width;
 		m_window_size.y = height;
 
@@ -659,7 +945,7 @@ namespace df::vulkan
 
 		cEventManager::invoke( event::on_window_resize, width, height );
 		m_window_resized = false;
-		DF_LOG_MESSAGE( fmt::format( "Resized window [{}, {}]", m_window_size.x, m_window_size.y ) );
+		DF_LOG_MESSAGE( "Resized window [{}, {}]", m_window_size.x, m_window_size.y );
 	}
 
 	void cRenderer_vulkan::framebufferSizeCallback( GLFWwindow* _window, int /*_width*/, int /*_height*/ )
@@ -688,48 +974,58 @@ namespace df::vulkan
 
 		if( _message_severity >= static_cast< VkDebugUtilsMessageTypeFlagsEXT >( vk::DebugUtilsMessageSeverityFlagBitsEXT::eError ) )
 		{
-			DF_LOG_ERROR( fmt::format( "Vulkan, "
-			                           "Type: {}, "
-			                           "Severity: Error, "
-			                           "Message: {}",
-			                           type,
-			                           _callback_data->pMessage ) );
+			DF_LOG( df::log::eError,
+			        df::log::eRendering,
+			        "Vulkan, "
+			        "Type: {}, "
+			        "Severity: Error, "
+			        "Message: {}",
+			        type,
+			        _callback_data->pMessage );
 		}
 		else if( _message_severity >= static_cast< VkDebugUtilsMessageTypeFlagsEXT >( vk::DebugUtilsMessageSeverityFlagBitsEXT::eWarning ) )
 		{
-			DF_LOG_WARNING( fmt::format( "Vulkan, "
-			                             "Type: {}, "
-			                             "Severity: Warning, "
-			                             "Message: {}",
-			                             type,
-			                             _callback_data->pMessage ) );
+			DF_LOG( df::log::eWarning,
+			        df::log::eRendering,
+			        "Vulkan, "
+			        "Type: {}, "
+			        "Severity: Warning, "
+			        "Message: {}",
+			        type,
+			        _callback_data->pMessage );
 		}
 		else if( _message_severity >= static_cast< VkDebugUtilsMessageTypeFlagsEXT >( vk::DebugUtilsMessageSeverityFlagBitsEXT::eInfo ) )
 		{
-			DF_LOG_MESSAGE( fmt::format( "Vulkan, "
-			                             "Type: {}, "
-			                             "Severity: Info, "
-			                             "Message: {}",
-			                             type,
-			                             _callback_data->pMessage ) );
+			DF_LOG( df::log::eMessage,
+			        df::log::eRendering,
+			        "Vulkan, "
+			        "Type: {}, "
+			        "Severity: Info, "
+			        "Message: {}",
+			        type,
+			        _callback_data->pMessage );
 		}
 		else if( _message_severity >= static_cast< VkDebugUtilsMessageTypeFlagsEXT >( vk::DebugUtilsMessageSeverityFlagBitsEXT::eVerbose ) )
 		{
-			DF_LOG_MESSAGE( fmt::format( "Vulkan, "
-			                             "Type: {}, "
-			                             "Severity: Verbose, "
-			                             "Message: {}",
-			                             type,
-			                             _callback_data->pMessage ) );
+			DF_LOG( df::log::eMessage,
+			        df::log::eRendering,
+			        "Vulkan, "
+			        "Type: {}, "
+			        "Severity: Verbose, "
+			        "Message: {}",
+			        type,
+			        _callback_data->pMessage );
 		}
 		else
 		{
-			DF_LOG_MESSAGE( fmt::format( "Vulkan, "
-			                             "Type: {}, "
-			                             "Severity: None, "
-			                             "Message: {}",
-			                             type,
-			                             _callback_data->pMessage ) );
+			DF_LOG( df::log::eMessage,
+			        df::log::eRendering,
+			        "Vulkan, "
+			        "Type: {}, "
+			        "Severity: None, "
+			        "Message: {}",
+			        type,
+			        _callback_data->pMessage );
 		}
 
 		return false;
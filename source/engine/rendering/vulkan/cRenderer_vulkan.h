@@ -12,7 +12,13 @@
 
 namespace df::vulkan
 {
+	class cBindlessTextures_vulkan;
 	class cDeferredRenderer_vulkan;
+	class cGeometryArena_vulkan;
+	class cGpuCulling_vulkan;
+	class cPipelineCache_vulkan;
+	class cTextureStreamer_vulkan;
+	class cUploadManager_vulkan;
 
 	class cRenderer_vulkan : public iRenderer
 	{
@@ -39,6 +45,7 @@ namespace df::vulkan
 		vk::Format   getRenderColorFormat() const { return m_render_image.format; }
 		vk::Format   getRenderDepthFormat() const { return m_depth_image.format; }
 
+		uint32_t           getFramesInFlight() const { return m_frames_in_flight; }
 		uint32_t           getCurrentFrameIndex() const { return m_frame_number % m_frames_in_flight; }
 		sFrameData_vulkan& getCurrentFrame() { return m_frame_datas[ getCurrentFrameIndex() ]; }
 
@@ -47,10 +54,25 @@ namespace df::vulkan
 		const vma::Allocator&     getMemoryAllocator() const { return memory_allocator.get(); }
 
 		const vk::DescriptorSetLayout& getVertexSceneUniformLayout() const { return m_vertex_scene_uniform_layout.get(); }
+		uint32_t                       getVertexSceneOffset( const cCamera* _camera );
+		const vk::DescriptorSetLayout& getObjectLayout() const { return m_object_layout.get(); }
+
+		sDescriptorAllocator_vulkan& getStaticDescriptors() { return m_static_descriptors; }
 
 		const vk::Sampler& getLinearSampler() const { return m_sampler_linear.get(); }
 		const vk::Sampler& getNearestSampler() const { return m_sampler_nearest.get(); }
 
+		cPipelineCache_vulkan*    getPipelineCache() const { return m_pipeline_cache; }
+		cUploadManager_vulkan*    getUploadManager() const { return m_upload_manager; }
+		cTextureStreamer_vulkan*  getTextureStreamer() const { return m_texture_streamer; }
+		cGeometryArena_vulkan*    getGeometryArena() const { return m_geometry_arena; }
+		cBindlessTextures_vulkan* getBindlessTextures() const { return m_bindless_textures; }
+		cGpuCulling_vulkan*       getGpuCulling() const { return m_gpu_culling; }
+
+		uint32_t getMaxIndirectDraws() const { return m_max_indirect_draws; }
+
+		const sRenderQueue_vulkan::sStats& getRenderQueueStats() const { return m_render_queue_stats; }
+
 	protected:
 		virtual void renderDeferred( const vk::CommandBuffer& /*_command_buffer*/ ) {}
 
@@ -59,6 +81,16 @@ namespace df::vulkan
 		void createMemoryAllocator();
 		void createSubmitContext();
 
+		void cullMeshes( const vk::CommandBuffer& _command_buffer ) const;
+
+		void beginRenderingScope( const vk::CommandBuffer&                   _command_buffer,
+		                          std::vector< vk::RenderingAttachmentInfo > _color_attachments,
+		                          std::vector< vk::Format >                  _color_formats,
+		                          const vk::RenderingAttachmentInfo&         _depth_attachment );
+		void recordParallel( sFrameData_vulkan& _frame_data, uint32_t _ranges );
+
+		vk::CommandBuffer beginSecondary( sWorkerCommands_vulkan& _worker_commands ) const;
+
 		void resize();
 
 		static void framebufferSizeCallback( GLFWwindow* _window, int _width, int _height );
@@ -72,6 +104,8 @@ namespace df::vulkan
 
 		vk::Queue m_graphics_queue;
 		uint32_t  m_graphics_queue_family;
+		vk::Queue m_transfer_queue;
+		uint32_t  m_transfer_queue_family;
 
 		vk::UniqueSurfaceKHR m_surface;
 
@@ -79,6 +113,10 @@ namespace df::vulkan
 		sAllocatedImage_vulkan m_render_image;
 		vk::Extent2D           m_render_extent;
 
+		std::vector< vk::RenderingAttachmentInfo > m_color_attachments;
+		std::vector< vk::Format >                  m_color_formats;
+		vk::RenderingAttachmentInfo                m_depth_attachment;
+
 		vk::UniqueSwapchainKHR             m_swapchain;
 		std::vector< vk::Image >           m_swapchain_images;
 		std::vector< vk::UniqueImageView > m_swapchain_image_views;
@@ -90,13 +128,24 @@ namespace df::vulkan
 		vma::UniqueAllocator memory_allocator;
 
 		vk::UniqueDescriptorSetLayout m_vertex_scene_uniform_layout;
+		vk::UniqueDescriptorSetLayout m_object_layout;
+		sDescriptorAllocator_vulkan   m_static_descriptors;
 
 		vk::UniqueSampler m_sampler_linear;
 		vk::UniqueSampler m_sampler_nearest;
 
+		cPipelineCache_vulkan*    m_pipeline_cache;
+		cUploadManager_vulkan*    m_upload_manager;
+		cTextureStreamer_vulkan*  m_texture_streamer;
+		cGeometryArena_vulkan*    m_geometry_arena;
+		cBindlessTextures_vulkan* m_bindless_textures;
+		cGpuCulling_vulkan*       m_gpu_culling;
+		uint32_t                  m_max_indirect_draws;
+
 		uint32_t                         m_frames_in_flight;
 		uint32_t                         m_frame_number;
 		std::vector< sFrameData_vulkan > m_frame_datas;
+		sRenderQueue_vulkan::sStats      m_render_queue_stats;
 
 		sSubmitContext_vulkan m_submit_context;
 
@@ -0,0 +1,344 @@
+﻿#include "cTextureStreamer_vulkan.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <tracy/Tracy.hpp>
+
+#include "assets/cTexture_vulkan.h"
+#include "cRenderer_vulkan.h"
+#include "cUploadManager_vulkan.h"
+#include "engine/log/Log.h"
+#include "engine/rendering/cRenderer.h"
+#include "misc/Helper_vulkan.h"
+
+namespace df::vulkan
+{
+	cTextureStreamer_vulkan::cTextureStreamer_vulkan( const uint32_t _frames_in_flight, const size_t _budget, const uint32_t _base_resolution )
+		: m_budget( _budget )
+		, m_cache_budget( 64 * 1024 * 1024 )
+		, m_resident_size( 0 )
+		, m_retired_size( 0 )
+		, m_base_resolution( _base_resolution )
+		, m_max_uploads_per_frame( 4 )
+		, m_frames_in_flight( _frames_in_flight )
+		, m_frame( 0 )
+	{
+		ZoneScoped;
+
+		DF_LOG_MESSAGE( "Created texture streamer with a budget of {} MiB", m_budget / ( 1024 * 1024 ) );
+	}
+
+	cTextureStreamer_vulkan::~cTextureStreamer_vulkan()
+	{
+		ZoneScoped;
+
+		releaseRetired( true );
+	}
+
+	void cTextureStreamer_vulkan::registerTexture( cTexture_vulkan* _texture )
+	{
+		ZoneScoped;
+
+		if( std::ranges::find( m_textures, _texture ) != m_textures.end() )
+			return;
+
+		m_textures.push_back( _texture );
+		m_resident_size += _texture->getResidentSize();
+	}
+
+	void cTextureStreamer_vulkan::unregisterTexture( cTexture_vulkan* _texture )
+	{
+		ZoneScoped;
+
+		std::erase_if( m_copies, [ _texture ]( const sCopy& _copy ) { return _copy.texture == _texture; } );
+
+		if( std::erase( m_textures, _texture ) )
+			m_resident_size -= _texture->getResidentSize();
+	}
+
+	void cTextureStreamer_vulkan::update( const uint64_t _frame )
+	{
+		ZoneScoped;
+
+		m_frame = _frame;
+		releaseRetired( false );
+
+		for( cTexture_vulkan* texture: m_textures )
+		{
+			const size_t expected = texture->getResidentSize();
+			if( texture->finishStreaming() )
+				m_resident_size = m_resident_size - expected + texture->getResidentSize();
+		}
+
+		trimCache();
+
+		// Retired images still hold memory, so they count against the budget, but evicting more for them would only free the same bytes twice.
+		if( m_resident_size - m_retired_size > m_budget )
+			evict( m_resident_size - m_retired_size - m_budget, nullptr );
+
+		std::vector< cTexture_vulkan* > upgrades;
+		for( cTexture_vulkan* texture: m_textures )
+		{
+			if( !texture->isStreaming() && texture->m_requested_mip < texture->m_resident_mip )
+				upgrades.push_back( texture );
+		}
+
+		std::ranges::sort( upgrades,
+		                   []( const cTexture_vulkan* _a, const cTexture_vulkan* _b )
+		                   { return _a->m_resident_mip - _a->m_requested_mip > _b->m_resident_mip - _b->m_requested_mip; } );
+
+		uint32_t uploads = 0;
+		for( cTexture_vulkan* texture: upgrades )
+		{
+			if( uploads >= m_max_uploads_per_frame )
+				break;
+
+			const size_t current = texture->getResidentSize();
+			const size_t cost    = texture->getMipChainSize( texture->m_requested_mip ) - current;
+
+			if( m_resident_size + cost > m_budget )
+			{
+				if( m_resident_size - m_retired_size + cost > m_budget )
+					evict( m_resident_size - m_retired_size + cost - m_budget, texture );
+
+				continue;
+			}
+
+			if( !texture->stream( texture->m_requested_mip ) )
+				continue;
+
+			m_resident_size += texture->getResidentSize() - current;
+			++uploads;
+		}
+
+		for( cTexture_vulkan* texture: m_textures )
+			texture->m_requested_mip = texture->getMipCount() - 1;
+	}
+
+	void cTextureStreamer_vulkan::record( const vk::CommandBuffer& _command_buffer )
+	{
+		ZoneScoped;
+
+		if( m_copies.empty() )
+			return;
+
+		const vk::ImageSubresourceRange range = helper::init::imageSubresourceRange( vk::ImageAspectFlagBits::eColor );
+
+		std::vector< vk::ImageMemoryBarrier2 > barriers;
+		for( const sCopy& copy: m_copies )
+		{
+			barriers.emplace_back( vk::PipelineStageFlagBits2::eAllCommands,
+			                       vk::AccessFlagBits2::eMemoryWrite,
+			                       vk::PipelineStageFlagBits2::eTransfer,
+			                       vk::AccessFlagBits2::eTransferRead,
+			                       vk::ImageLayout::eShaderReadOnlyOptimal,
+			                       vk::ImageLayout::eTransferSrcOptimal,
+			                       vk::QueueFamilyIgnored,
+			                       vk::QueueFamilyIgnored,
+			                       copy.source,
+			                       range );
+			barriers.emplace_back( vk::PipelineStageFlagBits2::eNone,
+			                       vk::AccessFlagBits2::eNone,
+			                       vk::PipelineStageFlagBits2::eTransfer,
+			                       vk::AccessFlagBits2::eTransferWrite,
+			                       vk::ImageLayout::eUndefined,
+			                       vk::ImageLayout::eTransferDstOptimal,
+			                       vk::QueueFamilyIgnored,
+			                       vk::QueueFamilyIgnored,
+			                       copy.destination,
+			                       range );
+
+			// A texture downgraded twice in a frame copies from the image its first copy wrote, so each copy is ordered after the previous one.
+			_command_buffer.pipelineBarrier2( vk::DependencyInfo( vk::DependencyFlags(), 0, nullptr, 0, nullptr, static_cast< uint32_t >( barriers.size() ), barriers.data() ) );
+			barriers.clear();
+
+			std::vector< vk::ImageCopy > regions;
+			for( uint32_t i = 0; i < copy.mip_count; ++i )
+			{
+				const vk::Extent3D extent( std::max( copy.extent.width >> i, 1u ), std::max( copy.extent.height >> i, 1u ), 1 );
+				regions.emplace_back( vk::ImageSubresourceLayers( vk::ImageAspectFlagBits::eColor, copy.source_mip + i, 0, 1 ),
+				                      vk::Offset3D(),
+				                      vk::ImageSubresourceLayers( vk::ImageAspectFlagBits::eColor, i, 0, 1 ),
+				                      vk::Offset3D(),
+				                      extent );
+			}
+
+			_command_buffer.copyImage( copy.source,
+			                           vk::ImageLayout::eTransferSrcOptimal,
+			                           copy.destination,
+			                           vk::ImageLayout::eTransferDstOptimal,
+			                           static_cast< uint32_t >( regions.size() ),
+			                           regions.data() );
+
+			barriers.emplace_back( vk::PipelineStageFlagBits2::eTransfer,
+			                       vk::AccessFlagBits2::eTransferRead,
+			                       vk::PipelineStageFlagBits2::eAllCommands,
+			                       vk::AccessFlagBits2::eShaderSampledRead,
+			                       vk::ImageLayout::eTransferSrcOptimal,
+			                       vk::ImageLayout::eShaderReadOnlyOptimal,
+			                       vk::QueueFamilyIgnored,
+			                       vk::QueueFamilyIgnored,
+			                       copy.source,
+			                       range );
+			barriers.emplace_back( vk::PipelineStageFlagBits2::eTransfer,
+			                       vk::AccessFlagBits2::eTransferWrite,
+			                       vk::PipelineStageFlagBits2::eAllCommands,
+			                       vk::AccessFlagBits2::eShaderSampledRead | vk::AccessFlagBits2::eTransferRead,
+			                       vk::ImageLayout::eTransferDstOptimal,
+			                       vk::ImageLayout::eShaderReadOnlyOptimal,
+			                       vk::QueueFamilyIgnored,
+			                       vk::QueueFamilyIgnored,
+			                       copy.destination,
+			                       range );
+
+			_command_buffer.pipelineBarrier2( vk::DependencyInfo( vk::DependencyFlags(), 0, nullptr, 0, nullptr, static_cast< uint32_t >( barriers.size() ), barriers.data() ) );
+			barriers.clear();
+		}
+
+		m_copies.clear();
+	}
+
+	void cTextureStreamer_vulkan::retire( sAllocatedImage_vulkan& _image, const cTexture_vulkan* _texture )
+	{
+		ZoneScoped;
+
+		if( !_image.image )
+			return;
+
+		cUploadManager_vulkan* upload_manager = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getUploadManager();
+		upload_manager->discard( _image.image.get() );
+
+		size_t size = 0;
+		if( _texture && std::ranges::find( m_textures, _texture ) != m_textures.end() )
+			size = _texture->getMipChainSize( _texture->m_resident_mip );
+
+		m_resident_size += size;
+		m_retired_size  += size;
+		m_retired.push_back( { m_frame, upload_manager->getSubmittedValue(), size, std::move( _image ) } );
+	}
+
+	void cTextureStreamer_vulkan::copyMips( cTexture_vulkan* _texture, sAllocatedImage_vulkan& _source, const vk::Image& _destination, const uint32_t _mip )
+	{
+		ZoneScoped;
+
+		m_copies.push_back( {
+			.texture     = _texture,
+			.source      = _source.image.get(),
+			.destination = _destination,
+			.source_mip  = _mip - _texture->m_resident_mip,
+			.mip_count   = _texture->getMipCount() - _mip,
+			.extent      = _texture->m_mip_extents[ _mip ],
+		} );
+
+		// The source is read on the graphics queue this frame, so its pending upload has to be submitted and acquired rather than discarded.
+		cUploadManager_vulkan* upload_manager = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getUploadManager();
+		upload_manager->flush();
+
+		const size_t size = _texture->getMipChainSize( _texture->m_resident_mip );
+
+		m_resident_size += size;
+		m_retired_size  += size;
+		m_retired.push_back( { m_frame, upload_manager->getSubmittedValue(), size, std::move( _source ) } );
+	}
+
+	uint32_t cTextureStreamer_vulkan::getInitialMip( const cTexture_vulkan* _texture ) const
+	{
+		ZoneScoped;
+
+		const uint32_t mip_count = _texture->getMipCount();
+		for( uint32_t i = 0; i < mip_count; ++i )
+		{
+			const vk::Extent3D& extent = _texture->m_mip_extents[ i ];
+			if( std::max( extent.width, extent.height ) <= m_base_resolution )
+				return i;
+		}
+
+		return mip_count - 1;
+	}
+
+	void cTextureStreamer_vulkan::evict( const size_t _size, const cTexture_vulkan* _exclude )
+	{
+		ZoneScoped;
+
+		std::vector< cTexture_vulkan* > candidates;
+		for( cTexture_vulkan* texture: m_textures )
+		{
+			if( texture != _exclude && !texture->isStreaming() && texture->m_resident_mip < texture->getMipCount() - 1 )
+				candidates.push_back( texture );
+		}
+
+		std::ranges::sort( candidates, []( const cTexture_vulkan* _a, const cTexture_vulkan* _b ) { return _a->m_last_used_frame < _b->m_last_used_frame; } );
+
+		size_t freed = 0;
+		for( cTexture_vulkan* texture: candidates )
+		{
+			if( freed >= _size )
+				break;
+
+			const bool     in_use = texture->m_last_used_frame + 1 >= m_frame;
+			const uint32_t target = in_use ? texture->m_requested_mip : getInitialMip( texture );
+
+			if( target <= texture->m_resident_mip )
+				continue;
+
+			const size_t current = texture->getResidentSize();
+			if( !texture->stream( target ) )
+				continue;
+
+			freed           += current - texture->getResidentSize();
+			m_resident_size -= current - texture->getResidentSize();
+		}
+	}
+
+	void cTextureStreamer_vulkan::releaseRetired( const bool _force )
+	{
+		ZoneScoped;
+
+		const uint64_t completed_upload = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getUploadManager()->getCompletedValue();
+
+		std::erase_if( m_retired,
+		               [ & ]( sRetiredImage& _retired )
+		               {
+						   if( !_force && ( _retired.frame + m_frames_in_flight > m_frame || _retired.upload_value > completed_upload ) )
+							   return false;
+
+						   helper::util::destroyImage( _retired.image );
+						   m_resident_size -= _retired.size;
+						   m_retired_size  -= _retired.size;
+						   return true;
+					   } );
+	}
+
+	void cTextureStreamer_vulkan::trimCache()
+	{
+		ZoneScoped;
+
+		size_t size = 0;
+		for( const cTexture_vulkan* texture: m_textures )
+		{
+			if( !texture->m_cached_mips.empty() )
+				size += texture->getMipChainSize( texture->m_cached_mip );
+		}
+
+		if( size <= m_cache_budget )
+			return;
+
+		std::vector< cTexture_vulkan* > cached;
+		for( cTexture_vulkan* texture: m_textures )
+		{
+			if( !texture->m_cached_mips.empty() )
+				cached.push_back( texture );
+		}
+
+		std::ranges::sort( cached, []( const cTexture_vulkan* _a, const cTexture_vulkan* _b ) { return _a->m_last_used_frame < _b->m_last_used_frame; } );
+
+		for( cTexture_vulkan* texture: cached )
+		{
+			if( size <= m_cache_budget )
+				break;
+
+			size -= texture->getMipChainSize( texture->m_cached_mip );
+			texture->m_cached_mips = {};
+		}
+	}
+}
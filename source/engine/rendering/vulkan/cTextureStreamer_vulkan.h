@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include <vector>
+
+#include "engine/misc/Misc.h"
+#include "misc/Types_vulkan.h"
+
+namespace df::vulkan
+{
+	class cTexture_vulkan;
+
+	class cTextureStreamer_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cTextureStreamer_vulkan )
+
+		explicit cTextureStreamer_vulkan( uint32_t _frames_in_flight, size_t _budget = 256 * 1024 * 1024, uint32_t _base_resolution = 64 );
+		~cTextureStreamer_vulkan();
+
+		void registerTexture( cTexture_vulkan* _texture );
+		void unregisterTexture( cTexture_vulkan* _texture );
+
+		void update( uint64_t _frame );
+		void record( const vk::CommandBuffer& _command_buffer );
+		void retire( sAllocatedImage_vulkan& _image, const cTexture_vulkan* _texture = nullptr );
+		void copyMips( cTexture_vulkan* _texture, sAllocatedImage_vulkan& _source, const vk::Image& _destination, uint32_t _mip );
+
+		uint32_t getInitialMip( const cTexture_vulkan* _texture ) const;
+
+		void     setBudget( const size_t _budget ) { m_budget = _budget; }
+		size_t   getBudget() const { return m_budget; }
+		size_t   getResidentSize() const { return m_resident_size; }
+		uint64_t getFrame() const { return m_frame; }
+
+		void setMaxUploadsPerFrame( const uint32_t _uploads ) { m_max_uploads_per_frame = _uploads; }
+		void setCacheBudget( const size_t _budget ) { m_cache_budget = _budget; }
+
+	private:
+		struct sRetiredImage
+		{
+			uint64_t               frame;
+			uint64_t               upload_value;
+			size_t                 size;
+			sAllocatedImage_vulkan image;
+		};
+
+		struct sCopy
+		{
+			const cTexture_vulkan* texture;
+			vk::Image              source;
+			vk::Image              destination;
+			uint32_t               source_mip;
+			uint32_t               mip_count;
+			vk::Extent3D           extent;
+		};
+
+		void evict( size_t _size, const cTexture_vulkan* _exclude );
+		void releaseRetired( bool _force );
+		void trimCache();
+
+		std::vector< cTexture_vulkan* > m_textures;
+		std::vector< sRetiredImage >    m_retired;
+		std::vector< sCopy >            m_copies;
+
+		size_t   m_budget;
+		size_t   m_cache_budget;
+		size_t   m_resident_size;
+		size_t   m_retired_size;
+		uint32_t m_base_resolution;
+		uint32_t m_max_uploads_per_frame;
+		uint32_t m_frames_in_flight;
+		uint64_t m_frame;
+	};
+}
@@ -0,0 +1,365 @@
+﻿#include "cUploadManager_vulkan.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+#include "misc/Helper_vulkan.h"
+
+namespace df::vulkan
+{
+	namespace
+	{
+		constexpr vk::AccessFlags2 s_buffer_read_access = vk::AccessFlagBits2::eVertexAttributeRead | vk::AccessFlagBits2::eIndexRead | vk::AccessFlagBits2::eShaderStorageRead
+		                                                | vk::AccessFlagBits2::eTransferRead;
+	}
+
+	cUploadManager_vulkan::cUploadManager_vulkan( const vk::Device&     _logical_device,
+	                                              const vma::Allocator& _memory_allocator,
+	                                              const uint32_t        _graphics_queue_family,
+	                                              const vk::Queue&      _transfer_queue,
+	                                              const uint32_t        _transfer_queue_family,
+	                                              const vk::DeviceSize  _staging_size )
+		: m_logical_device( _logical_device )
+		, m_memory_allocator( _memory_allocator )
+		, m_transfer_queue( _transfer_queue )
+		, m_graphics_queue_family( _graphics_queue_family )
+		, m_transfer_queue_family( _transfer_queue_family )
+		, m_staging_data( nullptr )
+		, m_staging_size( _staging_size )
+		, m_head( 0 )
+		, m_used( 0 )
+		, m_batch{}
+		, m_recording( false )
+		, m_value( 0 )
+		, m_acquired_value( 0 )
+	{
+		ZoneScoped;
+
+		const vk::BufferCreateInfo      buffer_create_info( vk::BufferCreateFlags(), m_staging_size, vk::BufferUsageFlagBits::eTransferSrc );
+		const vma::AllocationCreateInfo allocation_create_info( vma::AllocationCreateFlagBits::eMapped | vma::AllocationCreateFlagBits::eHostAccessSequentialWrite,
+		                                                        vma::MemoryUsage::eCpuToGpu );
+
+		std::pair< vma::UniqueBuffer, vma::UniqueAllocation > value = m_memory_allocator.createBufferUnique( buffer_create_info, allocation_create_info ).value;
+		m_staging_buffer.swap( value.first );
+		m_staging_allocation.swap( value.second );
+		m_staging_data = static_cast< std::byte* >( m_memory_allocator.getAllocationInfo( m_staging_allocation.get() ).pMappedData );
+
+		m_command_pool = m_logical_device.createCommandPoolUnique( helper::init::commandPoolCreateInfo( m_transfer_queue_family ) ).value;
+
+		const vk::SemaphoreTypeCreateInfo semaphore_type_create_info( vk::SemaphoreType::eTimeline, 0 );
+		const vk::SemaphoreCreateInfo     semaphore_create_info( vk::SemaphoreCreateFlags(), &semaphore_type_create_info );
+		m_semaphore = m_logical_device.createSemaphoreUnique( semaphore_create_info ).value;
+
+		DF_LOG_MESSAGE( "Created upload manager with a {} MB staging ring on the {} queue", m_staging_size / ( 1024 * 1024 ), isDedicated() ? "transfer" : "graphics" );
+	}
+
+	cUploadManager_vulkan::~cUploadManager_vulkan()
+	{
+		ZoneScoped;
+
+		flush();
+		wait( m_value );
+		reclaim();
+	}
+
+	void cUploadManager_vulkan::uploadBuffer( const vk::Buffer& _buffer, const vk::DeviceSize _offset, const void* _data, const vk::DeviceSize _size )
+	{
+		ZoneScoped;
+
+		if( !_size )
+			return;
+
+		const sStaging staging = allocate( _size );
+		std::memcpy( staging.data, _data, _size );
+
+		const vk::BufferCopy copy( staging.offset, _offset, _size );
+		m_batch.command_buffer.copyBuffer( staging.buffer, _buffer, 1, &copy );
+
+		m_buffer_releases.emplace_back( vk::PipelineStageFlagBits2::eTransfer,
+		                                vk::AccessFlagBits2::eTransferWrite,
+		                                vk::PipelineStageFlagBits2::eNone,
+		                                vk::AccessFlagBits2::eNone,
+		                                m_transfer_queue_family,
+		                                m_graphics_queue_family,
+		                                _buffer,
+		                                _offset,
+		                                _size );
+	}
+
+	void cUploadManager_vulkan::uploadImage( const vk::Image& _image, const std::vector< std::span< const unsigned char > >& _mips, const vk::Extent3D& _extent )
+	{
+		ZoneScoped;
+
+		vk::DeviceSize size = 0;
+		for( const std::span< const unsigned char >& mip: _mips )
+			size += mip.size();
+
+		const sStaging staging = allocate( size );
+
+		std::vector< vk::BufferImageCopy > regions;
+		regions.reserve( _mips.size() );
+
+		vk::DeviceSize offset = 0;
+		for( uint32_t i = 0; i < _mips.size(); ++i )
+		{
+			std::memcpy( staging.data + offset, _mips[ i ].data(), _mips[ i ].size() );
+
+			const vk::Extent3D extent( std::max( _extent.width >> i, 1u ), std::max( _extent.height >> i, 1u ), std::max( _extent.depth >> i, 1u ) );
+			regions.emplace_back( staging.offset + offset, 0, 0, vk::ImageSubresourceLayers( vk::ImageAspectFlagBits::eColor, i, 0, 1 ), vk::Offset3D(), extent );
+
+			offset += _mips[ i ].size();
+		}
+
+		helper::util::transitionImage( m_batch.command_buffer, _image, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal );
+		m_batch.command_buffer.copyBufferToImage( staging.buffer, _image, vk::ImageLayout::eTransferDstOptimal, static_cast< uint32_t >( regions.size() ), regions.data() );
+
+		const bool dedicated = isDedicated();
+
+		m_image_releases.emplace_back( vk::PipelineStageFlagBits2::eTransfer,
+		                               vk::AccessFlagBits2::eTransferWrite,
+		                               dedicated ? vk::PipelineStageFlagBits2::eNone : vk::PipelineStageFlagBits2::eAllCommands,
+		                               dedicated ? vk::AccessFlagBits2::eNone : vk::AccessFlagBits2::eShaderSampledRead,
+		                               vk::ImageLayout::eTransferDstOptimal,
+		                               vk::ImageLayout::eShaderReadOnlyOptimal,
+		                               dedicated ? m_transfer_queue_family : vk::QueueFamilyIgnored,
+		                               dedicated ? m_graphics_queue_family : vk::QueueFamilyIgnored,
+		                               _image,
+		                               helper::init::imageSubresourceRange( vk::ImageAspectFlagBits::eColor ) );
+	}
+
+	void cUploadManager_vulkan::flush()
+	{
+		ZoneScoped;
+
+		if( !m_recording )
+			return;
+
+		if( isDedicated() )
+		{
+			const vk::DependencyInfo info( vk::DependencyFlags(),
+			                               0,
+			                               nullptr,
+			                               static_cast< uint32_t >( m_buffer_releases.size() ),
+			                               m_buffer_releases.data(),
+			                               static_cast< uint32_t >( m_image_releases.size() ),
+			                               m_image_releases.data() );
+			m_batch.command_buffer.pipelineBarrier2( info );
+
+			for( vk::BufferMemoryBarrier2 barrier: m_buffer_releases )
+			{
+				barrier.setSrcStageMask( vk::PipelineStageFlagBits2::eNone ).setSrcAccessMask( vk::AccessFlagBits2::eNone );
+				barrier.setDstStageMask( vk::PipelineStageFlagBits2::eAllCommands ).setDstAccessMask( s_buffer_read_access );
+				m_buffer_acquires.push_back( barrier );
+			}
+
+			for( vk::ImageMemoryBarrier2 barrier: m_image_releases )
+			{
+				barrier.setSrcStageMask( vk::PipelineStageFlagBits2::eNone ).setSrcAccessMask( vk::AccessFlagBits2::eNone );
+				barrier.setDstStageMask( vk::PipelineStageFlagBits2::eAllCommands ).setDstAccessMask( vk::AccessFlagBits2::eShaderSampledRead );
+				m_image_acquires.push_back( barrier );
+			}
+		}
+		else
+		{
+			const vk::MemoryBarrier2 memory_barrier( vk::PipelineStageFlagBits2::eTransfer,
+			                                         vk::AccessFlagBits2::eTransferWrite,
+			                                         vk::PipelineStageFlagBits2::eAllCommands,
+			                                         s_buffer_read_access );
+
+			const vk::DependencyInfo info( vk::DependencyFlags(), 1, &memory_barrier, 0, nullptr, static_cast< uint32_t >( m_image_releases.size() ), m_image_releases.data() );
+			m_batch.command_buffer.pipelineBarrier2( info );
+		}
+
+		m_buffer_releases.clear();
+		m_image_releases.clear();
+
+		if( m_batch.command_buffer.end() != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to end upload command buffer" );
+
+		m_batch.value = ++m_value;
+
+		const vk::CommandBufferSubmitInfo command_buffer_submit_info = helper::init::commandBufferSubmitInfo( m_batch.command_buffer );
+		const vk::SemaphoreSubmitInfo     signal_semaphore_submit_info( m_semaphore.get(), m_value, vk::PipelineStageFlagBits2::eAllCommands, 0 );
+		const vk::SubmitInfo2             submit_info = helper::init::submitInfo( &command_buffer_submit_info, &signal_semaphore_submit_info );
+
+		if( m_transfer_queue.submit2( 1, &submit_info, nullptr ) != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to submit uploads" );
+
+		m_in_flight.push_back( std::move( m_batch ) );
+		m_batch     = {};
+		m_recording = false;
+	}
+
+	uint64_t cUploadManager_vulkan::acquire( const vk::CommandBuffer& _command_buffer )
+	{
+		ZoneScoped;
+
+		flush();
+		reclaim();
+
+		if( !m_buffer_acquires.empty() || !m_image_acquires.empty() )
+		{
+			const vk::DependencyInfo info( vk::DependencyFlags(),
+			                               0,
+			                               nullptr,
+			                               static_cast< uint32_t >( m_buffer_acquires.size() ),
+			                               m_buffer_acquires.data(),
+			                               static_cast< uint32_t >( m_image_acquires.size() ),
+			                               m_image_acquires.data() );
+			_command_buffer.pipelineBarrier2( info );
+
+			m_buffer_acquires.clear();
+			m_image_acquires.clear();
+		}
+
+		if( m_acquired_value == m_value )
+			return 0;
+
+		m_acquired_value = m_value;
+		return m_value;
+	}
+
+	void cUploadManager_vulkan::wait( const uint64_t _value )
+	{
+		ZoneScoped;
+
+		if( getCompletedValue() >= _value )
+			return;
+
+		const vk::SemaphoreWaitInfo wait_info( vk::SemaphoreWaitFlags(), 1, &m_semaphore.get(), &_value );
+		if( m_logical_device.waitSemaphores( wait_info, std::numeric_limits< uint64_t >::max() ) != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to wait for uploads" );
+	}
+
+	void cUploadManager_vulkan::discard( const vk::Buffer& _buffer )
+	{
+		ZoneScoped;
+
+		const auto matches = [ & ]( const vk::BufferMemoryBarrier2& _barrier ) { return _barrier.buffer == _buffer; };
+
+		std::erase_if( m_buffer_acquires, matches );
+		if( std::erase_if( m_buffer_releases, matches ) )
+			flush();
+	}
+
+	void cUploadManager_vulkan::discard( const vk::Image& _image )
+	{
+		ZoneScoped;
+
+		const auto matches = [ & ]( const vk::ImageMemoryBarrier2& _barrier ) { return _barrier.image == _image; };
+
+		std::erase_if( m_image_acquires, matches );
+		if( std::erase_if( m_image_releases, matches ) )
+			flush();
+	}
+
+	uint64_t cUploadManager_vulkan::getCompletedValue() const
+	{
+		return m_logical_device.getSemaphoreCounterValue( m_semaphore.get() ).value;
+	}
+
+	uint32_t cUploadManager_vulkan::findTransferQueueFamily( const std::vector< vk::QueueFamilyProperties >& _queue_family_properties, const uint32_t _graphics_queue_family )
+	{
+		ZoneScoped;
+
+		uint32_t fallback = _graphics_queue_family;
+		for( uint32_t i = 0; i < _queue_family_properties.size(); ++i )
+		{
+			const vk::QueueFlags flags = _queue_family_properties[ i ].queueFlags;
+			if( !( flags & vk::QueueFlagBits::eTransfer ) || flags & vk::QueueFlagBits::eGraphics )
+				continue;
+
+			if( !( flags & vk::QueueFlagBits::eCompute ) )
+				return i;
+
+			if( fallback == _graphics_queue_family )
+				fallback = i;
+		}
+
+		return fallback;
+	}
+
+	cUploadManager_vulkan::sStaging cUploadManager_vulkan::allocate( const vk::DeviceSize _size )
+	{
+		ZoneScoped;
+
+		constexpr vk::DeviceSize alignment = 16;
+
+		if( !m_recording )
+			begin();
+
+		if( _size > m_staging_size )
+		{
+			DF_LOG_WARNING( "Upload of {} bytes doesn't fit the staging ring, using a temporary buffer", _size );
+
+			const sAllocatedBuffer_vulkan& buffer = m_batch.buffers.emplace_back(
+				helper::util::createBuffer( _size, vk::BufferUsageFlagBits::eTransferSrc, vma::MemoryUsage::eCpuOnly, m_memory_allocator ) );
+
+			return { buffer.buffer.get(), 0, static_cast< std::byte* >( m_memory_allocator.getAllocationInfo( buffer.allocation.get() ).pMappedData ) };
+		}
+
+		while( true )
+		{
+			reclaim();
+
+			vk::DeviceSize offset = ( m_head + alignment - 1 ) & ~( alignment - 1 );
+			if( offset + _size > m_staging_size )
+				offset = 0;
+
+			const vk::DeviceSize consumed = ( offset >= m_head ? offset - m_head : m_staging_size - m_head ) + _size;
+			if( m_used + consumed <= m_staging_size )
+			{
+				if( !m_recording )
+					begin();
+
+				m_head        = offset + _size;
+				m_used       += consumed;
+				m_batch.size += consumed;
+				return { m_staging_buffer.get(), offset, m_staging_data + offset };
+			}
+
+			DF_LOG_WARNING( "Staging ring is full, waiting for uploads to finish" );
+
+			flush();
+			wait( m_in_flight.front().value );
+		}
+	}
+
+	void cUploadManager_vulkan::begin()
+	{
+		ZoneScoped;
+
+		if( m_free_command_buffers.empty() )
+		{
+			const vk::CommandBufferAllocateInfo allocate_info = helper::init::commandBufferAllocateInfo( m_command_pool.get() );
+			m_free_command_buffers.push_back( m_logical_device.allocateCommandBuffers( allocate_info ).value.front() );
+		}
+
+		m_batch.command_buffer = m_free_command_buffers.back();
+		m_free_command_buffers.pop_back();
+
+		const vk::CommandBufferBeginInfo begin_info = helper::init::commandBufferBeginInfo();
+		if( m_batch.command_buffer.begin( &begin_info ) != vk::Result::eSuccess )
+			DF_LOG_ERROR( "Failed to begin upload command buffer" );
+
+		m_recording = true;
+	}
+
+	void cUploadManager_vulkan::reclaim()
+	{
+		const uint64_t completed = getCompletedValue();
+
+		while( !m_in_flight.empty() && m_in_flight.front().value <= completed )
+		{
+			m_used -= m_in_flight.front().size;
+			m_free_command_buffers.push_back( m_in_flight.front().command_buffer );
+			m_in_flight.pop_front();
+		}
+
+		if( !m_used )
+			m_head = 0;
+	}
+}
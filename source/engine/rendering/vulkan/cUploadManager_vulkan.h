@@ -0,0 +1,89 @@
+﻿#pragma once
+
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "engine/misc/Misc.h"
+#include "misc/Types_vulkan.h"
+
+namespace df::vulkan
+{
+	class cUploadManager_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cUploadManager_vulkan )
+
+		cUploadManager_vulkan( const vk::Device&     _logical_device,
+		                       const vma::Allocator& _memory_allocator,
+		                       uint32_t              _graphics_queue_family,
+		                       const vk::Queue&      _transfer_queue,
+		                       uint32_t              _transfer_queue_family,
+		                       vk::DeviceSize        _staging_size = 64 * 1024 * 1024 );
+		~cUploadManager_vulkan();
+
+		void uploadBuffer( const vk::Buffer& _buffer, vk::DeviceSize _offset, const void* _data, vk::DeviceSize _size );
+		void uploadImage( const vk::Image& _image, const std::vector< std::span< const unsigned char > >& _mips, const vk::Extent3D& _extent );
+
+		void     flush();
+		uint64_t acquire( const vk::CommandBuffer& _command_buffer );
+		void     wait( uint64_t _value );
+		void     discard( const vk::Buffer& _buffer );
+		void     discard( const vk::Image& _image );
+
+		const vk::Semaphore& getSemaphore() const { return m_semaphore.get(); }
+		uint64_t             getSubmittedValue() const { return m_value; }
+		uint64_t             getCompletedValue() const;
+		bool                 isDedicated() const { return m_graphics_queue_family != m_transfer_queue_family; }
+
+		static uint32_t findTransferQueueFamily( const std::vector< vk::QueueFamilyProperties >& _queue_family_properties, uint32_t _graphics_queue_family );
+
+	private:
+		struct sBatch
+		{
+			vk::CommandBuffer                      command_buffer;
+			uint64_t                               value;
+			vk::DeviceSize                         size;
+			std::vector< sAllocatedBuffer_vulkan > buffers;
+		};
+
+		struct sStaging
+		{
+			vk::Buffer     buffer;
+			vk::DeviceSize offset;
+			std::byte*     data;
+		};
+
+		sStaging allocate( vk::DeviceSize _size );
+		void     begin();
+		void     reclaim();
+
+		vk::Device     m_logical_device;
+		vma::Allocator m_memory_allocator;
+		vk::Queue      m_transfer_queue;
+		uint32_t       m_graphics_queue_family;
+		uint32_t       m_transfer_queue_family;
+
+		vma::UniqueBuffer     m_staging_buffer;
+		vma::UniqueAllocation m_staging_allocation;
+		std::byte*            m_staging_data;
+		vk::DeviceSize        m_staging_size;
+		vk::DeviceSize        m_head;
+		vk::DeviceSize        m_used;
+
+		vk::UniqueCommandPool            m_command_pool;
+		std::vector< vk::CommandBuffer > m_free_command_buffers;
+		vk::UniqueSemaphore              m_semaphore;
+
+		sBatch                                  m_batch;
+		bool                                    m_recording;
+		std::deque< sBatch >                    m_in_flight;
+		std::vector< vk::BufferMemoryBarrier2 > m_buffer_releases;
+		std::vector< vk::ImageMemoryBarrier2 >  m_image_releases;
+		std::vector< vk::BufferMemoryBarrier2 > m_buffer_acquires;
+		std::vector< vk::ImageMemoryBarrier2 >  m_image_acquires;
+
+		uint64_t m_value;
+		uint64_t m_acquired_value;
+	};
+}
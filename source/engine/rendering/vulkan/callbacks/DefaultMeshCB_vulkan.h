@@ -1,77 +1,61 @@
 ﻿#pragma once
 
+#include <glm/geometric.hpp>
 #include <tracy/Tracy.hpp>
 
 #include "engine/managers/assets/cCameraManager.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
 #include "engine/rendering/vulkan/assets/cMesh_vulkan.h"
 #include "engine/rendering/vulkan/assets/cTexture_vulkan.h"
+#include "engine/rendering/vulkan/cBindlessTextures_vulkan.h"
+#include "engine/rendering/vulkan/cGeometryArena_vulkan.h"
+#include "engine/rendering/vulkan/cGpuCulling_vulkan.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
-#include "engine/rendering/vulkan/descriptor/sDescriptorWriter_vulkan.h"
 #include "engine/rendering/vulkan/pipeline/cPipeline_vulkan.h"
 
 namespace df::vulkan::render_callback
 {
-	inline void defaultMeshAmbient( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
+	inline float getMeshDepth( const cMesh_vulkan* _mesh, const cCamera* _camera )
 	{
-		ZoneScoped;
-		cRenderer_vulkan*  renderer   = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
-		sFrameData_vulkan& frame_data = renderer->getCurrentFrame();
-		TracyVkZone( frame_data.tracy_context, frame_data.command_buffer.get(), __FUNCTION__ );
-
-		const vk::UniqueCommandBuffer& command_buffer = frame_data.command_buffer;
-		const cCamera*                 camera         = cCameraManager::getInstance()->current;
-
-		const sAllocatedBuffer_vulkan& vertex_scene_buffer = camera->type == cCamera::ePerspective ? frame_data.vertex_scene_uniform_buffer_3d
-		                                                                                           : frame_data.vertex_scene_uniform_buffer_2d;
-
-		const sVertexSceneUniforms_vulkan vertex_scene_uniforms{
-			.view_projection = camera->view_projection,
-		};
+		const glm::vec3 center = _mesh->transform->getWorld() * glm::vec4( _mesh->getBounds().getCenter(), 1 );
+		return length( center - glm::vec3( _camera->transform->getWorld()[ 3 ] ) );
+	}
 
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( vertex_scene_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, &vertex_scene_uniforms, sizeof( vertex_scene_uniforms ) );
-		renderer->getMemoryAllocator().unmapMemory( vertex_scene_buffer.allocation.get() );
-
-		std::vector< vk::DescriptorSet > descriptor_sets;
-		descriptor_sets.push_back( frame_data.descriptors.allocate( renderer->getVertexSceneUniformLayout() ) );
-
-		sDescriptorWriter_vulkan writer_scene;
-		writer_scene.writeBuffer( 0, vertex_scene_buffer.buffer.get(), sizeof( vertex_scene_uniforms ), 0, vk::DescriptorType::eUniformBuffer );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		writer_scene.clear();
-		descriptor_sets.push_back( frame_data.descriptors.allocate( _mesh->getTextureLayout() ) );
-		writer_scene.writeImage( 0,
-		                         reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) )->getImage().image_view.get(),
-		                         renderer->getNearestSampler(),
-		                         vk::ImageLayout::eShaderReadOnlyOptimal,
-		                         vk::DescriptorType::eCombinedImageSampler );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline.get() );
-		command_buffer->bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
-		                                    _pipeline->layout.get(),
-		                                    0,
-		                                    static_cast< uint32_t >( descriptor_sets.size() ),
-		                                    descriptor_sets.data(),
-		                                    0,
-		                                    nullptr );
-
-		const cMesh_vulkan::sPushConstants push_constants{
-			.world_matrix = _mesh->transform->world,
+	inline sRenderQueue_vulkan::sDraw createMeshDraw( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh, const vk::DescriptorSet& _texture_set )
+	{
+		cRenderer_vulkan*            renderer       = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		sFrameData_vulkan&           frame_data     = renderer->getCurrentFrame();
+		const cGeometryArena_vulkan* geometry_arena = renderer->getGeometryArena();
+
+		return {
+			.pipeline        = _pipeline->pipeline,
+			.layout          = _pipeline->layout,
+			.descriptor_sets = { frame_data.vertex_scene_descriptor_set, _texture_set, frame_data.object_descriptor_set },
+			.scene_offset    = renderer->getVertexSceneOffset( cCameraManager::getInstance()->current ),
+			.vertex_buffer   = geometry_arena->getVertexBuffer(),
+			.index_buffer    = geometry_arena->getIndexBuffer(),
+			.index_count     = _mesh->geometry.indices.count,
+			.first_index     = _mesh->geometry.indices.offset,
+			.vertex_offset   = static_cast< int32_t >( _mesh->geometry.vertices.offset ),
+			.object          = { .world_matrix = _mesh->transform->getWorld() },
 		};
+	}
 
-		command_buffer->pushConstants( _pipeline->layout.get(), vk::ShaderStageFlagBits::eVertex, 0, sizeof( push_constants ), &push_constants );
-
-		renderer->setViewportScissor();
+	inline void defaultMeshAmbient( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
+	{
+		ZoneScoped;
+		sRenderQueue_vulkan& render_queue = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getCurrentFrame().render_queue;
 
-		const vk::Buffer         vertex_buffers[] = { _mesh->vertex_buffer.buffer.get() };
-		constexpr vk::DeviceSize offsets[]        = { 0 };
-		command_buffer->bindVertexBuffers( 0, 1, vertex_buffers, offsets );
+		const cTexture_vulkan* const textures[] = {
+			reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) ),
+		};
 
-		command_buffer->bindIndexBuffer( _mesh->index_buffer.buffer.get(), 0, vk::IndexType::eUint32 );
+		const sRenderQueue_vulkan::sDraw draw = createMeshDraw( _pipeline, _mesh, _mesh->getTextureSet( _mesh->getTextureLayout(), textures ) );
 
-		command_buffer->drawIndexed( static_cast< uint32_t >( _mesh->getIndices().size() ), 1, 0, 0, 0 );
+		render_queue.submit( sRenderQueue_vulkan::eOpaque,
+		                     render_queue.getMaterialId( draw.descriptor_sets[ 1 ] ),
+		                     getMeshDepth( _mesh, cCameraManager::getInstance()->current ),
+		                     draw );
 	}
 
 	inline void defaultMesh( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
@@ -87,73 +71,71 @@ namespace df::vulkan::render_callback
 	inline void defaultMeshDeferred( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
 	{
 		ZoneScoped;
-		cRenderer_vulkan*  renderer   = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
-		sFrameData_vulkan& frame_data = renderer->getCurrentFrame();
-		TracyVkZone( frame_data.tracy_context, frame_data.command_buffer.get(), __FUNCTION__ );
+		sRenderQueue_vulkan& render_queue = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getCurrentFrame().render_queue;
 
-		const vk::UniqueCommandBuffer& command_buffer = frame_data.command_buffer;
-		const cCamera*                 camera         = cCameraManager::getInstance()->current;
+		const cTexture_vulkan* const textures[] = {
+			reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) ),
+			reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_NORMALS ) ),
+			reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_SPECULAR ) ),
+		};
 
-		const sAllocatedBuffer_vulkan& vertex_scene_buffer = camera->type == cCamera::ePerspective ? frame_data.vertex_scene_uniform_buffer_3d
-		                                                                                           : frame_data.vertex_scene_uniform_buffer_2d;
+		const sRenderQueue_vulkan::sDraw draw = createMeshDraw( _pipeline, _mesh, _mesh->getTextureSet( _mesh->getTextureLayout(), textures ) );
 
-		const sVertexSceneUniforms_vulkan vertex_scene_uniforms{
-			.view_projection = camera->view_projection,
-		};
+		render_queue.submit( sRenderQueue_vulkan::eOpaque,
+		                     render_queue.getMaterialId( draw.descriptor_sets[ 1 ] ),
+		                     getMeshDepth( _mesh, cCameraManager::getInstance()->current ),
+		                     draw );
+	}
 
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( vertex_scene_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, &vertex_scene_uniforms, sizeof( vertex_scene_uniforms ) );
-		renderer->getMemoryAllocator().unmapMemory( vertex_scene_buffer.allocation.get() );
-
-		std::vector< vk::DescriptorSet > descriptor_sets;
-		descriptor_sets.push_back( frame_data.descriptors.allocate( renderer->getVertexSceneUniformLayout() ) );
-
-		sDescriptorWriter_vulkan writer_scene;
-		writer_scene.writeBuffer( 0, vertex_scene_buffer.buffer.get(), sizeof( vertex_scene_uniforms ), 0, vk::DescriptorType::eUniformBuffer );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		writer_scene.clear();
-		descriptor_sets.push_back( frame_data.descriptors.allocate( _mesh->getTextureLayout() ) );
-		writer_scene.writeImage( 0,
-		                         reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) )->getImage().image_view.get(),
-		                         renderer->getNearestSampler(),
-		                         vk::ImageLayout::eShaderReadOnlyOptimal,
-		                         vk::DescriptorType::eCombinedImageSampler );
-		writer_scene.writeImage( 1,
-		                         reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_NORMALS ) )->getImage().image_view.get(),
-		                         renderer->getNearestSampler(),
-		                         vk::ImageLayout::eShaderReadOnlyOptimal,
-		                         vk::DescriptorType::eCombinedImageSampler );
-		writer_scene.writeImage( 2,
-		                         reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_SPECULAR ) )->getImage().image_view.get(),
-		                         renderer->getNearestSampler(),
-		                         vk::ImageLayout::eShaderReadOnlyOptimal,
-		                         vk::DescriptorType::eCombinedImageSampler );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline.get() );
-		command_buffer->bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
-		                                    _pipeline->layout.get(),
-		                                    0,
-		                                    static_cast< uint32_t >( descriptor_sets.size() ),
-		                                    descriptor_sets.data(),
-		                                    0,
-		                                    nullptr );
-
-		const cMesh_vulkan::sPushConstants push_constants{
-			.world_matrix = _mesh->transform->world,
-		};
+	inline void defaultMeshSubmitBindless( const cPipeline_vulkan* _pipeline,
+	                                       const cMesh_vulkan*     _mesh,
+	                                       const cTexture_vulkan*  _color,
+	                                       const cTexture_vulkan*  _normal,
+	                                       const cTexture_vulkan*  _specular )
+	{
+		cRenderer_vulkan*    renderer     = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
+		sRenderQueue_vulkan& render_queue = renderer->getCurrentFrame().render_queue;
 
-		command_buffer->pushConstants( _pipeline->layout.get(), vk::ShaderStageFlagBits::eVertex, 0, sizeof( push_constants ), &push_constants );
+		sRenderQueue_vulkan::sDraw draw = createMeshDraw( _pipeline, _mesh, renderer->getBindlessTextures()->getSet() );
+		draw.object.color_texture       = _color->getBindlessIndex();
+		draw.object.normal_texture      = _normal ? _normal->getBindlessIndex() : cBindlessTextures_vulkan::s_invalid;
+		draw.object.specular_texture    = _specular ? _specular->getBindlessIndex() : cBindlessTextures_vulkan::s_invalid;
 
-		renderer->setViewportScissor();
+		render_queue.submit( sRenderQueue_vulkan::eOpaque, draw.object.color_texture, getMeshDepth( _mesh, cCameraManager::getInstance()->current ), draw );
+	}
 
-		const vk::Buffer         vertex_buffers[] = { _mesh->vertex_buffer.buffer.get() };
-		constexpr vk::DeviceSize offsets[]        = { 0 };
-		command_buffer->bindVertexBuffers( 0, 1, vertex_buffers, offsets );
+	inline void defaultMeshAmbientBindless( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
+	{
+		ZoneScoped;
+
+		defaultMeshSubmitBindless( _pipeline, _mesh, reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) ), nullptr, nullptr );
+	}
+
+	inline void defaultMeshBindless( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
+	{
+		ZoneScoped;
 
-		command_buffer->bindIndexBuffer( _mesh->index_buffer.buffer.get(), 0, vk::IndexType::eUint32 );
+		const std::string_view name( _pipeline->getName() );
+
+		if( name.find( "ambient" ) != std::string::npos )
+			defaultMeshAmbientBindless( _pipeline, _mesh );
+	}
+
+	inline void defaultMeshDeferredBindless( const cPipeline_vulkan* _pipeline, const cMesh_vulkan* _mesh )
+	{
+		ZoneScoped;
+
+		defaultMeshSubmitBindless( _pipeline,
+		                           _mesh,
+		                           reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_DIFFUSE ) ),
+		                           reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_NORMALS ) ),
+		                           reinterpret_cast< cTexture_vulkan* >( _mesh->getTextures().at( aiTextureType_SPECULAR ) ) );
+	}
+
+	inline void defaultMeshGpuCulled( const cPipeline_vulkan* _pipeline, const cGpuCulling_vulkan* _gpu_culling )
+	{
+		ZoneScoped;
 
-		command_buffer->drawIndexed( static_cast< uint32_t >( _mesh->getIndices().size() ), 1, 0, 0, 0 );
+		_gpu_culling->draw( _pipeline );
 	}
 }
@@ -24,48 +24,32 @@ namespace df::vulkan::render_callback
 		const vk::UniqueCommandBuffer& command_buffer = frame_data.command_buffer;
 		const cCamera*                 camera         = cCameraManager::getInstance()->current;
 
-		const sAllocatedBuffer_vulkan& vertex_scene_buffer = camera->type == cCamera::ePerspective ? frame_data.vertex_scene_uniform_buffer_3d
-		                                                                                           : frame_data.vertex_scene_uniform_buffer_2d;
+		const uint32_t vertex_scene_offset = renderer->getVertexSceneOffset( camera );
 
-		const sVertexSceneUniforms_vulkan vertex_scene_uniforms{
-			.view_projection = camera->view_projection,
+		const cTexture_vulkan* const textures[] = {
+			reinterpret_cast< cTexture_vulkan* >( _quad->texture ),
 		};
 
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( vertex_scene_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, &vertex_scene_uniforms, sizeof( vertex_scene_uniforms ) );
-		renderer->getMemoryAllocator().unmapMemory( vertex_scene_buffer.allocation.get() );
-
-		std::vector< vk::DescriptorSet > descriptor_sets;
-		descriptor_sets.push_back( frame_data.descriptors.allocate( renderer->getVertexSceneUniformLayout() ) );
+		const vk::DescriptorSet descriptor_sets[] = {
+			frame_data.vertex_scene_descriptor_set,
+			_quad->getTextureSet( _quad->getTextureLayout(), textures ),
+		};
 
-		sDescriptorWriter_vulkan writer_scene;
-		writer_scene.writeBuffer( 0, vertex_scene_buffer.buffer.get(), sizeof( vertex_scene_uniforms ), 0, vk::DescriptorType::eUniformBuffer );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		writer_scene.clear();
-		descriptor_sets.push_back( frame_data.descriptors.allocate( _quad->getTextureLayout() ) );
-		writer_scene.writeImage( 0,
-		                         reinterpret_cast< cTexture_vulkan* >( _quad->texture )->getImage().image_view.get(),
-		                         renderer->getNearestSampler(),
-		                         vk::ImageLayout::eShaderReadOnlyOptimal,
-		                         vk::DescriptorType::eCombinedImageSampler );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline.get() );
+		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline );
 		command_buffer->bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
-		                                    _pipeline->layout.get(),
-		                                    0,
-		                                    static_cast< uint32_t >( descriptor_sets.size() ),
-		                                    descriptor_sets.data(),
+		                                    _pipeline->layout,
 		                                    0,
-		                                    nullptr );
+		                                    static_cast< uint32_t >( std::size( descriptor_sets ) ),
+		                                    descriptor_sets,
+		                                    1,
+		                                    &vertex_scene_offset );
 
 		const cQuad_vulkan::sPushConstants push_constants{
-			.world_matrix = _quad->transform->world,
+			.world_matrix = _quad->transform->getWorld(),
 			.color        = _quad->color,
 		};
 
-		command_buffer->pushConstants( _pipeline->layout.get(),
+		command_buffer->pushConstants( _pipeline->layout,
 		                               vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
 		                               0,
 		                               sizeof( push_constants ),
@@ -94,26 +78,14 @@ namespace df::vulkan::render_callback
 		const vk::UniqueCommandBuffer&               command_buffer     = frame_data.command_buffer;
 		const cCamera*                               camera             = cCameraManager::getInstance()->current;
 
-		const sAllocatedBuffer_vulkan& vertex_scene_buffer = camera->type == cCamera::ePerspective ? frame_data.vertex_scene_uniform_buffer_3d
-		                                                                                           : frame_data.vertex_scene_uniform_buffer_2d;
+		const uint32_t vertex_scene_offset = renderer->getVertexSceneOffset( camera );
 
-		const sVertexSceneUniforms_vulkan vertex_scene_uniforms{
-			.view_projection = camera->view_projection,
+		const vk::DescriptorSet descriptor_sets[] = {
+			frame_data.vertex_scene_descriptor_set,
+			frame_data.descriptors.allocate( renderer->getTextureLayout() ),
 		};
 
-		void* data_dst = renderer->getMemoryAllocator().mapMemory( vertex_scene_buffer.allocation.get() ).value;
-		std::memcpy( data_dst, &vertex_scene_uniforms, sizeof( vertex_scene_uniforms ) );
-		renderer->getMemoryAllocator().unmapMemory( vertex_scene_buffer.allocation.get() );
-
-		std::vector< vk::DescriptorSet > descriptor_sets;
-		descriptor_sets.push_back( frame_data.descriptors.allocate( renderer->getVertexSceneUniformLayout() ) );
-
 		sDescriptorWriter_vulkan writer_scene;
-		writer_scene.writeBuffer( 0, vertex_scene_buffer.buffer.get(), sizeof( vertex_scene_uniforms ), 0, vk::DescriptorType::eUniformBuffer );
-		writer_scene.updateSet( descriptor_sets.back() );
-
-		writer_scene.clear();
-		descriptor_sets.push_back( frame_data.descriptors.allocate( renderer->getTextureLayout() ) );
 		for( size_t i = 0; i < framebuffer_images.size(); ++i )
 		{
 			writer_scene.writeImage( static_cast< uint32_t >( i ),
@@ -122,22 +94,22 @@ namespace df::vulkan::render_callback
 			                         vk::ImageLayout::eShaderReadOnlyOptimal,
 			                         vk::DescriptorType::eCombinedImageSampler );
 		}
-		writer_scene.updateSet( descriptor_sets.back() );
+		writer_scene.updateSet( descriptor_sets[ 1 ] );
 
-		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline.get() );
+		command_buffer->bindPipeline( vk::PipelineBindPoint::eGraphics, _pipeline->pipeline );
 		command_buffer->bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
-		                                    _pipeline->layout.get(),
-		                                    0,
-		                                    static_cast< uint32_t >( descriptor_sets.size() ),
-		                                    descriptor_sets.data(),
+		                                    _pipeline->layout,
 		                                    0,
-		                                    nullptr );
+		                                    static_cast< uint32_t >( std::size( descriptor_sets ) ),
+		                                    descriptor_sets,
+		                                    1,
+		                                    &vertex_scene_offset );
 
 		const cDeferredRenderer_vulkan::sPushConstants push_constants{
-			.world_matrix = _quad->transform->world,
+			.world_matrix = _quad->transform->getWorld(),
 		};
 
-		command_buffer->pushConstants( _pipeline->layout.get(), vk::ShaderStageFlagBits::eVertex, 0, sizeof( push_constants ), &push_constants );
+		command_buffer->pushConstants( _pipeline->layout, vk::ShaderStageFlagBits::eVertex, 0, sizeof( push_constants ), &push_constants );
 
 		renderer->setViewportScissor();
 
@@ -58,6 +58,14 @@ namespace df::vulkan
 	{
 		ZoneScoped;
 
+		m_sets.push_back( allocateUnique( _layout ) );
+		return m_sets.back().get();
+	}
+
+	vk::UniqueDescriptorSet sDescriptorAllocator_vulkan::allocateUnique( const vk::DescriptorSetLayout& _layout )
+	{
+		ZoneScoped;
+
 		vk::DescriptorPool pool = getPool();
 
 		vk::DescriptorSetAllocateInfo allocate_info( pool, 1, &_layout );
@@ -81,8 +89,10 @@ namespace df::vulkan
 			}
 		}
 
-		m_sets.push_back( std::move( descriptor_sets.front() ) );
-		return m_sets.back().get();
+		if( descriptor_sets.empty() )
+			return {};
+
+		return std::move( descriptor_sets.front() );
 	}
 
 	vk::DescriptorPool sDescriptorAllocator_vulkan::getPool()
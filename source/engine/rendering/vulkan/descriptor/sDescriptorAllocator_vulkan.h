@@ -21,7 +21,8 @@ namespace df::vulkan
 		void destroy();
 		void clear();
 
-		vk::DescriptorSet& allocate( const vk::DescriptorSetLayout& _layout );
+		vk::DescriptorSet&      allocate( const vk::DescriptorSetLayout& _layout );
+		vk::UniqueDescriptorSet allocateUnique( const vk::DescriptorSetLayout& _layout );
 
 	protected:
 		vk::DescriptorPool       getPool();
@@ -2,11 +2,13 @@
 
 #include <tracy/Tracy.hpp>
 
+#include "engine/log/Log.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
 
 namespace df::vulkan
 {
+	std::unordered_map< VkDescriptorSetLayout, std::string > sDescriptorLayoutBuilder_vulkan::s_layouts = {};
 
 	vk::UniqueDescriptorSetLayout sDescriptorLayoutBuilder_vulkan::build( const vk::ShaderStageFlags _shader_stages )
 	{
@@ -25,6 +27,51 @@ namespace df::vulkan
 
 		const vk::DescriptorSetLayoutCreateInfo create_info( vk::DescriptorSetLayoutCreateFlags(), static_cast< uint32_t >( bindings.size() ), bindings.data() );
 
-		return _logical_device.createDescriptorSetLayoutUnique( create_info ).value;
+		vk::UniqueDescriptorSetLayout layout = _logical_device.createDescriptorSetLayoutUnique( create_info ).value;
+		registerLayout( layout.get(), create_info );
+
+		return layout;
+	}
+
+	void sDescriptorLayoutBuilder_vulkan::registerLayout( const vk::DescriptorSetLayout _layout, const vk::DescriptorSetLayoutCreateInfo& _create_info )
+	{
+		ZoneScoped;
+
+		std::string key;
+		const auto  add = [ &key ]( const auto& _value ) { key.append( reinterpret_cast< const char* >( &_value ), sizeof( _value ) ); };
+
+		add( _create_info.flags );
+		for( uint32_t i = 0; i < _create_info.bindingCount; ++i )
+		{
+			const vk::DescriptorSetLayoutBinding& binding = _create_info.pBindings[ i ];
+			add( binding.binding );
+			add( binding.descriptorType );
+			add( binding.descriptorCount );
+			add( binding.stageFlags );
+		}
+
+		for( const vk::BaseInStructure* next = static_cast< const vk::BaseInStructure* >( _create_info.pNext ); next; next = next->pNext )
+		{
+			if( next->sType != vk::StructureType::eDescriptorSetLayoutBindingFlagsCreateInfo )
+				continue;
+
+			const vk::DescriptorSetLayoutBindingFlagsCreateInfo* binding_flags = reinterpret_cast< const vk::DescriptorSetLayoutBindingFlagsCreateInfo* >( next );
+			for( uint32_t i = 0; i < binding_flags->bindingCount; ++i )
+				add( binding_flags->pBindingFlags[ i ] );
+		}
+
+		s_layouts[ _layout ] = std::move( key );
+	}
+
+	std::string sDescriptorLayoutBuilder_vulkan::getKey( const vk::DescriptorSetLayout _layout )
+	{
+		ZoneScoped;
+
+		if( const auto it = s_layouts.find( _layout ); it != s_layouts.end() )
+			return it->second;
+
+		DF_LOG_WARNING( "Descriptor layout wasn't registered, keying pipelines by its handle" );
+		const VkDescriptorSetLayout handle = _layout;
+		return std::string( reinterpret_cast< const char* >( &handle ), sizeof( handle ) );
 	}
 }
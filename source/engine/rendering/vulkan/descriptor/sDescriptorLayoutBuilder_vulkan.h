@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan_shared.hpp>
 
@@ -13,5 +15,12 @@ namespace df::vulkan
 		void                          clear() { bindings.clear(); }
 		vk::UniqueDescriptorSetLayout build( vk::ShaderStageFlags _shader_stages );
 		vk::UniqueDescriptorSetLayout build( const vk::Device& _logical_device, vk::ShaderStageFlags _shader_stages );
+
+		static void        registerLayout( vk::DescriptorSetLayout _layout, const vk::DescriptorSetLayoutCreateInfo& _create_info );
+		static std::string getKey( vk::DescriptorSetLayout _layout );
+
+	private:
+		// Keyed by handle but overwritten on every creation, so a recycled handle never keeps the contents of a destroyed layout.
+		static std::unordered_map< VkDescriptorSetLayout, std::string > s_layouts;
 	};
 }
@@ -9,6 +9,7 @@
 #include "engine/log/Log.h"
 #include "engine/rendering/cRenderer.h"
 #include "engine/rendering/vulkan/cRenderer_vulkan.h"
+#include "engine/rendering/vulkan/cUploadManager_vulkan.h"
 
 namespace df::vulkan::helper
 {
@@ -253,30 +254,29 @@ namespace df::vulkan::helper
 			_command_buffer.blitImage2( blit_info );
 		}
 
-		vk::ShaderModule createShaderModule( const std::string& _name )
+		vk::ShaderModule createShaderModule( const std::string& _name, std::vector< uint32_t >* _code )
 		{
 			ZoneScoped;
 
 			const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
 
-			std::vector< char > shader;
-			vk::ShaderModule    module = nullptr;
+			vk::ShaderModule module = nullptr;
 
-			std::fstream shader_file = filesystem::open( fmt::format( "binaries/shaders/vulkan/{}.spv", _name ), std::ios::in | std::ios::ate | std::ios::binary );
-			if( !shader_file.is_open() )
+			const cMappedFile shader = filesystem::mapFile( fmt::format( "binaries/shaders/vulkan/{}.spv", _name ) );
+			if( !shader.getSize() )
 			{
-				DF_LOG_ERROR( fmt::format( "Failed to load shader: {}", _name ) );
+				DF_LOG_ERROR( "Failed to load shader: {}", _name );
 				return module;
 			}
 
-			shader.resize( shader_file.tellg() );
-			shader_file.seekg( 0 );
-			shader_file.read( shader.data(), static_cast< long long >( shader.size() ) );
-
-			const vk::ShaderModuleCreateInfo create_info( vk::ShaderModuleCreateFlags(), shader.size(), reinterpret_cast< const uint32_t* >( shader.data() ) );
+			const uint32_t*                  code = reinterpret_cast< const uint32_t* >( shader.getData().data() );
+			const vk::ShaderModuleCreateInfo create_info( vk::ShaderModuleCreateFlags(), shader.getSize(), code );
 
 			module = renderer->getLogicalDevice().createShaderModule( create_info ).value;
-			DF_LOG_MESSAGE( fmt::format( "Successfully loaded shader and created shader module: {}", _name ) );
+			if( _code )
+				_code->assign( code, code + shader.getSize() / sizeof( uint32_t ) );
+
+			DF_LOG_MESSAGE( "Successfully loaded shader and created shader module: {}", _name );
 			return module;
 		}
 
@@ -393,12 +393,7 @@ namespace df::vulkan::helper
 
 			const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
 
-			const uint32_t          data_size = _size.depth * _size.width * _size.height * 4;
-			sAllocatedBuffer_vulkan buffer    = createBuffer( data_size, vk::BufferUsageFlagBits::eTransferSrc, vma::MemoryUsage::eCpuToGpu );
-
-			void* data_dst = renderer->getMemoryAllocator().mapMemory( buffer.allocation.get() ).value;
-			std::memcpy( data_dst, _data, data_size );
-			renderer->getMemoryAllocator().unmapMemory( buffer.allocation.get() );
+			const uint32_t data_size = _size.depth * _size.width * _size.height * 4;
 
 			sAllocatedImage_vulkan image = createImage( _size,
 			                                            _format,
@@ -406,17 +401,28 @@ namespace df::vulkan::helper
 			                                            _mipmapped,
 			                                            _mipmaps );
 
-			renderer->immediateSubmit(
-				[ & ]( const vk::CommandBuffer _command_buffer )
-				{
-					transitionImage( _command_buffer, image.image.get(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal );
+			const std::vector mips = { std::span( static_cast< const unsigned char* >( _data ), data_size ) };
+			renderer->getUploadManager()->uploadImage( image.image.get(), mips, _size );
+
+			return image;
+		}
 
-					const vk::BufferImageCopy region( 0, 0, 0, vk::ImageSubresourceLayers( vk::ImageAspectFlagBits::eColor, 0, 0, 1 ), vk::Offset3D(), _size );
+		sAllocatedImage_vulkan createImage( const std::vector< std::span< const unsigned char > >& _mips,
+		                                    const vk::Extent3D                                     _size,
+		                                    const vk::Format                                       _format,
+		                                    const vk::ImageUsageFlags                              _usage )
+		{
+			ZoneScoped;
+
+			const cRenderer_vulkan* renderer = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
 
-					_command_buffer.copyBufferToImage( buffer.buffer.get(), image.image.get(), vk::ImageLayout::eTransferDstOptimal, 1, &region );
+			sAllocatedImage_vulkan image = createImage( _size,
+			                                            _format,
+			                                            _usage | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc,
+			                                            true,
+			                                            static_cast< unsigned >( _mips.size() ) );
 
-					transitionImage( _command_buffer, image.image.get(), vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal );
-				} );
+			renderer->getUploadManager()->uploadImage( image.image.get(), _mips, _size );
 
 			return image;
 		}
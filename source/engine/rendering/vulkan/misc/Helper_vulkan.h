@@ -1,6 +1,8 @@
 ﻿#pragma once
 
+#include <span>
 #include <string>
+#include <vector>
 #include <vk_mem_alloc.hpp>
 #include <vulkan/vulkan.hpp>
 #include <vulkan/vulkan_core.h>
@@ -59,7 +61,7 @@ namespace df::vulkan::helper
 		                       vk::Extent2D             _source_size,
 		                       vk::Extent2D             _destination_size );
 
-		vk::ShaderModule createShaderModule( const std::string& _name );
+		vk::ShaderModule createShaderModule( const std::string& _name, std::vector< uint32_t >* _code = nullptr );
 
 		void                    createBuffer( vk::DeviceSize _size, vk::BufferUsageFlags _usage_flags, vma::MemoryUsage _memory_usage, sAllocatedBuffer_vulkan& _buffer );
 		void                    createBuffer( vk::DeviceSize           _size,
@@ -74,6 +76,7 @@ namespace df::vulkan::helper
 
 		sAllocatedImage_vulkan createImage( vk::Extent3D _size, vk::Format _format, vk::ImageUsageFlags _usage, bool _mipmapped = false, unsigned _mipmaps = 0 );
 		sAllocatedImage_vulkan createImage( const void* _data, vk::Extent3D _size, vk::Format _format, vk::ImageUsageFlags _usage, bool _mipmapped = false, unsigned _mipmaps = 0 );
+		sAllocatedImage_vulkan createImage( const std::vector< std::span< const unsigned char > >& _mips, vk::Extent3D _size, vk::Format _format, vk::ImageUsageFlags _usage );
 		void                   destroyImage( sAllocatedImage_vulkan& _image );
 	}
 }
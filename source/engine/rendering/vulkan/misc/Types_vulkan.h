@@ -1,12 +1,20 @@
 ﻿#pragma once
 
 #include <glm/ext/matrix_float4x4.hpp>
+#include <vector>
 #include <vk_mem_alloc.hpp>
 #include <vulkan/vulkan.hpp>
 
 #include <tracy/TracyVulkan.hpp>
 
 #include "engine/rendering/vulkan/descriptor/sDescriptorAllocator_vulkan.h"
+#include "engine/rendering/vulkan/misc/sFrameAllocator_vulkan.h"
+#include "engine/rendering/vulkan/misc/sRenderQueue_vulkan.h"
+
+namespace df
+{
+	class cCamera;
+}
 
 namespace df::vulkan
 {
@@ -16,20 +24,33 @@ namespace df::vulkan
 		vma::UniqueAllocation allocation;
 	};
 
+	struct sWorkerCommands_vulkan
+	{
+		vk::UniqueCommandPool                  command_pool;
+		std::vector< vk::UniqueCommandBuffer > command_buffers;
+		uint32_t                               used;
+	};
+
 	struct sFrameData_vulkan
 	{
 		vk::UniqueCommandPool   command_pool;
 		vk::UniqueCommandBuffer command_buffer;
 
+		std::vector< sWorkerCommands_vulkan > worker_commands;
+
 		vk::UniqueSemaphore swapchain_semaphore;
 		vk::UniqueSemaphore render_semaphore;
 		vk::UniqueFence     render_fence;
 
-		// TODO: Create a real solution for this
-		sAllocatedBuffer_vulkan     vertex_scene_uniform_buffer_3d;
-		sAllocatedBuffer_vulkan     vertex_scene_uniform_buffer_2d;
+		sFrameAllocator_vulkan      uniform_allocator;
 		sDescriptorAllocator_vulkan descriptors;
 
+		vk::DescriptorSet                                    vertex_scene_descriptor_set;
+		std::vector< std::pair< const cCamera*, uint32_t > > vertex_scene_offsets;
+		vk::DescriptorSet                                    object_descriptor_set;
+
+		sRenderQueue_vulkan render_queue;
+
 		TracyVkCtx tracy_context;
 	};
 
@@ -0,0 +1,103 @@
+﻿#include "sFrameAllocator_vulkan.h"
+
+#include <algorithm>
+#include <bit>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+
+namespace df::vulkan
+{
+	sFrameAllocator_vulkan::sFrameAllocator_vulkan()
+		: m_data( nullptr )
+		, m_size( 0 )
+		, m_offset( 0 )
+		, m_requested( 0 )
+		, m_alignment( 1 )
+	{
+		ZoneScoped;
+	}
+
+	void sFrameAllocator_vulkan::create( const vma::Allocator&      _memory_allocator,
+	                                     const vk::DeviceSize       _size,
+	                                     const vk::DeviceSize       _alignment,
+	                                     const vk::BufferUsageFlags _usage_flags )
+	{
+		ZoneScoped;
+
+		m_memory_allocator = _memory_allocator;
+		m_usage_flags      = _usage_flags;
+		m_alignment        = std::max< vk::DeviceSize >( _alignment, 1 );
+
+		createBuffer( _size );
+	}
+
+	void sFrameAllocator_vulkan::destroy()
+	{
+		ZoneScoped;
+
+		m_data = nullptr;
+		m_allocation.reset();
+		m_buffer.reset();
+	}
+
+	void sFrameAllocator_vulkan::clear()
+	{
+		ZoneScoped;
+
+		if( m_requested > m_size )
+		{
+			const vk::DeviceSize size = std::bit_ceil( m_requested );
+			DF_LOG_WARNING( "Growing frame allocator from {} to {} bytes", m_size, size );
+
+			destroy();
+			createBuffer( size );
+		}
+
+		m_offset    = 0;
+		m_requested = 0;
+	}
+
+	void sFrameAllocator_vulkan::flush() const
+	{
+		ZoneScoped;
+
+		if( !m_offset )
+			return;
+
+		if( m_memory_allocator.flushAllocation( m_allocation.get(), 0, m_offset ) != vk::Result::eSuccess )
+			DF_LOG_WARNING( "Failed to flush frame allocator" );
+	}
+
+	sFrameAllocator_vulkan::sAllocation sFrameAllocator_vulkan::allocate( const vk::DeviceSize _size )
+	{
+		const vk::DeviceSize offset = ( m_requested + m_alignment - 1 ) & ~( m_alignment - 1 );
+		m_requested                 = offset + _size;
+
+		if( m_requested > m_size )
+		{
+			DF_LOG_ERROR( "Frame allocator is out of memory, {} of {} bytes requested", m_requested, m_size );
+			return { m_buffer.get(), 0, nullptr };
+		}
+
+		m_offset = m_requested;
+		return { m_buffer.get(), static_cast< uint32_t >( offset ), m_data + offset };
+	}
+
+	void sFrameAllocator_vulkan::createBuffer( const vk::DeviceSize _size )
+	{
+		ZoneScoped;
+
+		const vk::BufferCreateInfo      buffer_create_info( vk::BufferCreateFlags(), _size, m_usage_flags );
+		const vma::AllocationCreateInfo allocation_create_info( vma::AllocationCreateFlagBits::eMapped | vma::AllocationCreateFlagBits::eHostAccessSequentialWrite,
+		                                                        vma::MemoryUsage::eCpuToGpu );
+
+		std::pair< vma::UniqueBuffer, vma::UniqueAllocation > value = m_memory_allocator.createBufferUnique( buffer_create_info, allocation_create_info ).value;
+		m_buffer.swap( value.first );
+		m_allocation.swap( value.second );
+
+		m_data   = static_cast< std::byte* >( m_memory_allocator.getAllocationInfo( m_allocation.get() ).pMappedData );
+		m_size   = _size;
+		m_offset = 0;
+	}
+}
@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#include <cstring>
+#include <vk_mem_alloc.hpp>
+#include <vulkan/vulkan.hpp>
+
+namespace df::vulkan
+{
+	struct sFrameAllocator_vulkan
+	{
+		struct sAllocation
+		{
+			vk::Buffer buffer;
+			uint32_t   offset;
+			void*      data;
+
+			bool isValid() const { return data != nullptr; }
+		};
+
+		sFrameAllocator_vulkan();
+
+		void create( const vma::Allocator& _memory_allocator, vk::DeviceSize _size, vk::DeviceSize _alignment, vk::BufferUsageFlags _usage_flags );
+		void destroy();
+		void clear();
+		void flush() const;
+
+		sAllocation allocate( vk::DeviceSize _size );
+
+		template< typename T >
+		sAllocation push( const T& _data );
+
+		const vk::Buffer& getBuffer() const { return m_buffer.get(); }
+		vk::DeviceSize    getUsed() const { return m_offset; }
+
+	private:
+		void createBuffer( vk::DeviceSize _size );
+
+		vma::Allocator        m_memory_allocator;
+		vma::UniqueBuffer     m_buffer;
+		vma::UniqueAllocation m_allocation;
+
+		vk::BufferUsageFlags m_usage_flags;
+		std::byte*           m_data;
+		vk::DeviceSize       m_size;
+		vk::DeviceSize       m_offset;
+		vk::DeviceSize       m_requested;
+		vk::DeviceSize       m_alignment;
+	};
+
+	template< typename T >
+	sFrameAllocator_vulkan::sAllocation sFrameAllocator_vulkan::push( const T& _data )
+	{
+		const sAllocation allocation = allocate( sizeof( T ) );
+		if( allocation.isValid() )
+			std::memcpy( allocation.data, &_data, sizeof( T ) );
+
+		return allocation;
+	}
+}
@@ -0,0 +1,318 @@
+﻿#include "sRenderQueue_vulkan.h"
+
+#include <algorithm>
+#include <bit>
+#include <tracy/Tracy.hpp>
+#include <utility>
+
+#include "engine/log/Log.h"
+#include "engine/managers/cJobManager.h"
+
+namespace df::vulkan
+{
+	sRenderQueue_vulkan::sRenderQueue_vulkan()
+		: m_commands{}
+		, m_stats{}
+	{
+		ZoneScoped;
+	}
+
+	void sRenderQueue_vulkan::reset()
+	{
+		clear();
+
+		m_stats = {};
+	}
+
+	void sRenderQueue_vulkan::submit( const ePass _pass, const uint32_t _material, const float _depth, const sDraw& _draw )
+	{
+		const uint32_t pipeline = m_pipeline_ids.try_emplace( _draw.pipeline, static_cast< uint32_t >( m_pipeline_ids.size() ) ).first->second;
+
+		m_entries.push_back( { makeKey( _pass, pipeline, _material, _depth ), static_cast< uint32_t >( m_draws.size() ) } );
+		m_draws.push_back( _draw );
+	}
+
+	void sRenderQueue_vulkan::flush( const vk::CommandBuffer& _command_buffer, const vk::Extent2D& _extent, sFrameAllocator_vulkan& _allocator, const uint32_t _max_indirect_draws )
+	{
+		ZoneScoped;
+
+		if( m_entries.empty() )
+			return;
+
+		if( prepare( _allocator ) )
+			accumulate( record( _command_buffer, _extent, 0, static_cast< uint32_t >( m_entries.size() ), _max_indirect_draws ) );
+
+		clear();
+	}
+
+	void sRenderQueue_vulkan::flush( const std::vector< vk::CommandBuffer >& _command_buffers,
+	                                 const vk::Extent2D&                     _extent,
+	                                 sFrameAllocator_vulkan&                 _allocator,
+	                                 const uint32_t                          _max_indirect_draws )
+	{
+		ZoneScoped;
+
+		if( m_entries.empty() || _command_buffers.empty() )
+			return;
+
+		if( !prepare( _allocator ) )
+		{
+			clear();
+			return;
+		}
+
+		const uint64_t draws  = m_entries.size();
+		const uint32_t ranges = static_cast< uint32_t >( _command_buffers.size() );
+
+		std::vector< uint32_t > splits( ranges + 1 );
+		for( uint32_t range = 0; range <= ranges; ++range )
+			splits[ range ] = static_cast< uint32_t >( draws * range / ranges );
+
+		std::vector< sStats > stats( ranges );
+		cJobManager::parallelFor( ranges,
+		                          1,
+		                          [ & ]( const size_t _begin, const size_t _end )
+		                          {
+									  for( size_t i = _begin; i < _end; ++i )
+										  stats[ i ] = record( _command_buffers[ i ], _extent, splits[ i ], splits[ i + 1 ], _max_indirect_draws );
+								  } );
+
+		for( const sStats& range_stats: stats )
+			accumulate( range_stats );
+
+		clear();
+	}
+
+	bool sRenderQueue_vulkan::prepare( sFrameAllocator_vulkan& _allocator )
+	{
+		ZoneScoped;
+
+		sort();
+
+		constexpr uint32_t object_size  = sizeof( sObject );
+		constexpr uint32_t command_size = sizeof( vk::DrawIndexedIndirectCommand );
+
+		const uint32_t draws = static_cast< uint32_t >( m_entries.size() );
+
+		const sFrameAllocator_vulkan::sAllocation object_allocation = _allocator.allocate( static_cast< vk::DeviceSize >( draws + 1 ) * object_size );
+		m_commands                                                  = _allocator.allocate( static_cast< vk::DeviceSize >( draws ) * command_size );
+
+		if( !object_allocation.isValid() || !m_commands.isValid() )
+		{
+			DF_LOG_WARNING( "Skipped {} draws, frame allocator is full", draws );
+			return false;
+		}
+
+		const uint32_t                  first_object = ( object_allocation.offset + object_size - 1 ) / object_size;
+		sObject*                        objects      = reinterpret_cast< sObject* >( static_cast< std::byte* >( object_allocation.data ) + first_object * object_size - object_allocation.offset );
+		vk::DrawIndexedIndirectCommand* commands     = static_cast< vk::DrawIndexedIndirectCommand* >( m_commands.data );
+
+		m_batches.clear();
+
+		for( uint32_t first = 0; first < draws; )
+		{
+			const sDraw& draw = m_draws[ m_entries[ first ].index ];
+
+			uint32_t last = first;
+			for( ; last < draws; ++last )
+			{
+				const sDraw& batch_draw = m_draws[ m_entries[ last ].index ];
+				if( !isBatchable( draw, batch_draw ) )
+					break;
+
+				objects[ last ]  = batch_draw.object;
+				commands[ last ] = vk::DrawIndexedIndirectCommand( batch_draw.index_count, 1, batch_draw.first_index, batch_draw.vertex_offset, first_object + last );
+			}
+
+			m_batches.push_back( { first, last } );
+			first = last;
+		}
+
+		return true;
+	}
+
+	sRenderQueue_vulkan::sStats sRenderQueue_vulkan::record( const vk::CommandBuffer& _command_buffer,
+	                                                         const vk::Extent2D&      _extent,
+	                                                         const uint32_t           _first_draw,
+	                                                         const uint32_t           _last_draw,
+	                                                         const uint32_t           _max_indirect_draws ) const
+	{
+		ZoneScoped;
+
+		if( _first_draw >= _last_draw )
+			return {};
+
+		constexpr uint32_t draw_state_changes = 5;
+		constexpr uint32_t command_size       = sizeof( vk::DrawIndexedIndirectCommand );
+
+		const vk::DrawIndexedIndirectCommand* commands = static_cast< const vk::DrawIndexedIndirectCommand* >( m_commands.data );
+
+		const vk::Viewport viewport( 0, 0, static_cast< float >( _extent.width ), static_cast< float >( _extent.height ), 0, 1 );
+		const vk::Rect2D   scissor( vk::Offset2D(), _extent );
+		_command_buffer.setViewport( 0, 1, &viewport );
+		_command_buffer.setScissor( 0, 1, &scissor );
+
+		vk::Pipeline                       pipeline;
+		vk::PipelineLayout                 layout;
+		std::array< vk::DescriptorSet, 3 > descriptor_sets;
+		uint32_t                           scene_offset = 0;
+		vk::Buffer                         vertex_buffer;
+		vk::Buffer                         index_buffer;
+		uint32_t                           state_changes = 1;
+		uint32_t                           batches       = 0;
+
+		const auto first_batch = std::ranges::upper_bound( m_batches, _first_draw, {}, &sBatch::first ) - 1;
+
+		for( auto batch = first_batch; batch != m_batches.end() && batch->first < _last_draw; ++batch )
+		{
+			const uint32_t first = std::max( batch->first, _first_draw );
+			const uint32_t last  = std::min( batch->last, _last_draw );
+			const sDraw&   draw  = m_draws[ m_entries[ first ].index ];
+
+			if( draw.pipeline != pipeline )
+			{
+				_command_buffer.bindPipeline( vk::PipelineBindPoint::eGraphics, draw.pipeline );
+				pipeline = draw.pipeline;
+				++state_changes;
+			}
+
+			if( draw.layout != layout || draw.descriptor_sets[ 0 ] != descriptor_sets[ 0 ] || draw.descriptor_sets[ 2 ] != descriptor_sets[ 2 ]
+			    || draw.scene_offset != scene_offset )
+			{
+				_command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eGraphics,
+				                                    draw.layout,
+				                                    0,
+				                                    static_cast< uint32_t >( draw.descriptor_sets.size() ),
+				                                    draw.descriptor_sets.data(),
+				                                    1,
+				                                    &draw.scene_offset );
+
+				layout          = draw.layout;
+				descriptor_sets = draw.descriptor_sets;
+				scene_offset    = draw.scene_offset;
+				++state_changes;
+			}
+			else if( draw.descriptor_sets[ 1 ] != descriptor_sets[ 1 ] )
+			{
+				_command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eGraphics, draw.layout, 1, 1, &draw.descriptor_sets[ 1 ], 0, nullptr );
+				descriptor_sets[ 1 ] = draw.descriptor_sets[ 1 ];
+				++state_changes;
+			}
+
+			if( draw.vertex_buffer != vertex_buffer )
+			{
+				constexpr vk::DeviceSize offset = 0;
+				_command_buffer.bindVertexBuffers( 0, 1, &draw.vertex_buffer, &offset );
+				vertex_buffer = draw.vertex_buffer;
+				++state_changes;
+			}
+
+			if( draw.index_buffer != index_buffer )
+			{
+				_command_buffer.bindIndexBuffer( draw.index_buffer, 0, vk::IndexType::eUint32 );
+				index_buffer = draw.index_buffer;
+				++state_changes;
+			}
+
+			if( _max_indirect_draws )
+			{
+				for( uint32_t i = first; i < last; )
+				{
+					const uint32_t count = std::min( last - i, _max_indirect_draws );
+					_command_buffer.drawIndexedIndirect( m_commands.buffer, m_commands.offset + i * command_size, count, command_size );
+
+					i += count;
+					++batches;
+				}
+			}
+			else
+			{
+				for( uint32_t i = first; i < last; ++i )
+				{
+					const vk::DrawIndexedIndirectCommand& command = commands[ i ];
+					_command_buffer.drawIndexed( command.indexCount, command.instanceCount, command.firstIndex, command.vertexOffset, command.firstInstance );
+					++batches;
+				}
+			}
+		}
+
+		const uint32_t draws = _last_draw - _first_draw;
+
+		return {
+			.draws               = draws,
+			.batches             = batches,
+			.state_changes       = state_changes,
+			.state_changes_saved = draws * draw_state_changes - state_changes,
+		};
+	}
+
+	void sRenderQueue_vulkan::accumulate( const sStats& _stats )
+	{
+		m_stats.draws               += _stats.draws;
+		m_stats.batches             += _stats.batches;
+		m_stats.state_changes       += _stats.state_changes;
+		m_stats.state_changes_saved += _stats.state_changes_saved;
+	}
+
+	void sRenderQueue_vulkan::clear()
+	{
+		m_draws.clear();
+		m_entries.clear();
+		m_batches.clear();
+		m_pipeline_ids.clear();
+		m_material_ids.clear();
+	}
+
+	uint32_t sRenderQueue_vulkan::getMaterialId( const vk::DescriptorSet& _descriptor_set )
+	{
+		return m_material_ids.try_emplace( _descriptor_set, static_cast< uint32_t >( m_material_ids.size() ) ).first->second;
+	}
+
+	uint64_t sRenderQueue_vulkan::makeKey( const ePass _pass, const uint32_t _pipeline, const uint32_t _material, const float _depth )
+	{
+		constexpr uint64_t mask_12 = 0xFFF;
+		constexpr uint64_t mask_24 = 0xFFFFFF;
+
+		const uint64_t pass     = static_cast< uint64_t >( _pass ) << 60;
+		const uint64_t pipeline = _pipeline & mask_12;
+		const uint64_t material = _material & mask_24;
+		const uint64_t depth    = std::bit_cast< uint32_t >( std::max( _depth, 0.f ) ) >> 7;
+
+		if( _pass == eTransparent )
+			return pass | ( ~depth & mask_24 ) << 36 | pipeline << 24 | material;
+
+		return pass | pipeline << 48 | material << 24 | depth;
+	}
+
+	bool sRenderQueue_vulkan::isBatchable( const sDraw& _a, const sDraw& _b )
+	{
+		return _a.pipeline == _b.pipeline && _a.layout == _b.layout && _a.descriptor_sets == _b.descriptor_sets && _a.scene_offset == _b.scene_offset
+		    && _a.vertex_buffer == _b.vertex_buffer && _a.index_buffer == _b.index_buffer;
+	}
+
+	void sRenderQueue_vulkan::sort()
+	{
+		ZoneScoped;
+
+		m_scratch.resize( m_entries.size() );
+
+		for( uint32_t shift = 0; shift < 64; shift += 8 )
+		{
+			std::array< uint32_t, 256 > offsets{};
+			for( const sEntry& entry: m_entries )
+				++offsets[ ( entry.key >> shift ) & 0xFF ];
+
+			if( offsets[ ( m_entries.front().key >> shift ) & 0xFF ] == m_entries.size() )
+				continue;
+
+			uint32_t offset = 0;
+			for( uint32_t& count: offsets )
+				offset += std::exchange( count, offset );
+
+			for( const sEntry& entry: m_entries )
+				m_scratch[ offsets[ ( entry.key >> shift ) & 0xFF ]++ ] = entry;
+
+			m_entries.swap( m_scratch );
+		}
+	}
+}
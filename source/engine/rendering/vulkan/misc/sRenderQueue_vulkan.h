@@ -0,0 +1,101 @@
+﻿#pragma once
+
+#include <array>
+#include <glm/ext/matrix_float4x4.hpp>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+#include "sFrameAllocator_vulkan.h"
+
+namespace df::vulkan
+{
+	struct sRenderQueue_vulkan
+	{
+		enum ePass : uint8_t
+		{
+			eOpaque,
+			eTransparent,
+		};
+
+		struct sObject
+		{
+			glm::mat4 world_matrix;
+			uint32_t  color_texture;
+			uint32_t  normal_texture;
+			uint32_t  specular_texture;
+			uint32_t  padding;
+		};
+
+		struct sDraw
+		{
+			vk::Pipeline                       pipeline;
+			vk::PipelineLayout                 layout;
+			std::array< vk::DescriptorSet, 3 > descriptor_sets;
+			uint32_t                           scene_offset;
+
+			vk::Buffer vertex_buffer;
+			vk::Buffer index_buffer;
+			uint32_t   index_count;
+			uint32_t   first_index;
+			int32_t    vertex_offset;
+
+			sObject object;
+		};
+
+		struct sStats
+		{
+			uint32_t draws;
+			uint32_t batches;
+			uint32_t state_changes;
+			uint32_t state_changes_saved;
+		};
+
+		sRenderQueue_vulkan();
+
+		void reset();
+
+		void submit( ePass _pass, uint32_t _material, float _depth, const sDraw& _draw );
+		void flush( const vk::CommandBuffer& _command_buffer, const vk::Extent2D& _extent, sFrameAllocator_vulkan& _allocator, uint32_t _max_indirect_draws );
+		void flush( const std::vector< vk::CommandBuffer >& _command_buffers, const vk::Extent2D& _extent, sFrameAllocator_vulkan& _allocator, uint32_t _max_indirect_draws );
+
+		uint32_t getMaterialId( const vk::DescriptorSet& _descriptor_set );
+
+		uint32_t      getDrawCount() const { return static_cast< uint32_t >( m_entries.size() ); }
+		const sStats& getStats() const { return m_stats; }
+
+	private:
+		struct sEntry
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		struct sBatch
+		{
+			uint32_t first;
+			uint32_t last;
+		};
+
+		static uint64_t makeKey( ePass _pass, uint32_t _pipeline, uint32_t _material, float _depth );
+		static bool     isBatchable( const sDraw& _a, const sDraw& _b );
+
+		void   sort();
+		bool   prepare( sFrameAllocator_vulkan& _allocator );
+		sStats record( const vk::CommandBuffer& _command_buffer, const vk::Extent2D& _extent, uint32_t _first_draw, uint32_t _last_draw, uint32_t _max_indirect_draws ) const;
+		void   accumulate( const sStats& _stats );
+		void   clear();
+
+		std::vector< sDraw >  m_draws;
+		std::vector< sEntry > m_entries;
+		std::vector< sEntry > m_scratch;
+		std::vector< sBatch > m_batches;
+
+		sFrameAllocator_vulkan::sAllocation m_commands;
+
+		std::unordered_map< VkPipeline, uint32_t >      m_pipeline_ids;
+		std::unordered_map< VkDescriptorSet, uint32_t > m_material_ids;
+
+		sStats m_stats;
+	};
+}
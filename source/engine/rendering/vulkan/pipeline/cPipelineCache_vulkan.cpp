@@ -0,0 +1,122 @@
+﻿#include "cPipelineCache_vulkan.h"
+
+#include <cstdio>
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+#include "engine/filesystem/cFileSystem.h"
+#include "engine/log/Log.h"
+
+namespace df::vulkan
+{
+	cPipelineCache_vulkan::cPipelineCache_vulkan( const vk::PhysicalDevice& _physical_device, const vk::Device& _logical_device, std::string _path )
+		: m_logical_device( _logical_device )
+		, m_header{}
+		, m_path( std::move( _path ) )
+	{
+		ZoneScoped;
+
+		const vk::PhysicalDeviceProperties properties = _physical_device.getProperties();
+
+		std::memcpy( m_header.magic, s_magic, sizeof( m_header.magic ) );
+		std::memcpy( m_header.uuid, properties.pipelineCacheUUID.data(), sizeof( m_header.uuid ) );
+		m_header.version        = s_version;
+		m_header.vendor_id      = properties.vendorID;
+		m_header.device_id      = properties.deviceID;
+		m_header.driver_version = properties.driverVersion;
+
+		const cMappedFile file = cMappedFile::map( filesystem::getGameDirectory() + m_path );
+
+		sHeader header{};
+		if( file.getSize() >= sizeof( header ) )
+			std::memcpy( &header, file.getData().data(), sizeof( header ) );
+
+		vk::PipelineCacheCreateInfo create_info;
+		if( isCompatible( header ) && header.size == file.getSize() - sizeof( header ) )
+		{
+			create_info.setInitialDataSize( header.size ).setPInitialData( file.getData().data() + sizeof( header ) );
+			DF_LOG_MESSAGE( "Loaded pipeline cache: {}, {} bytes", m_path, header.size );
+		}
+		else if( file.isValid() )
+			DF_LOG_WARNING( "Pipeline cache doesn't match the device or driver, starting empty: {}", m_path );
+
+		m_cache = m_logical_device.createPipelineCacheUnique( create_info ).value;
+	}
+
+	cPipelineCache_vulkan::~cPipelineCache_vulkan()
+	{
+		ZoneScoped;
+
+		if( !m_pipelines.empty() )
+			DF_LOG_WARNING( "Destroying pipeline cache with {} pipelines still referenced", m_pipelines.size() );
+
+		m_pipelines.clear();
+		save();
+	}
+
+	const cPipelineCache_vulkan::sPipeline* cPipelineCache_vulkan::acquire( const std::string& _key )
+	{
+		ZoneScoped;
+
+		const auto it = m_pipelines.find( _key );
+		if( it == m_pipelines.end() )
+			return nullptr;
+
+		++it->second.references;
+		return &it->second;
+	}
+
+	const cPipelineCache_vulkan::sPipeline* cPipelineCache_vulkan::insert( const std::string& _key, vk::UniquePipeline _pipeline, vk::UniquePipelineLayout _layout )
+	{
+		ZoneScoped;
+
+		sPipeline& pipeline = m_pipelines[ _key ];
+		pipeline.pipeline   = std::move( _pipeline );
+		pipeline.layout     = std::move( _layout );
+		pipeline.references = 1;
+
+		return &pipeline;
+	}
+
+	void cPipelineCache_vulkan::release( const std::string& _key )
+	{
+		ZoneScoped;
+
+		const auto it = m_pipelines.find( _key );
+		if( it != m_pipelines.end() && !--it->second.references )
+			m_pipelines.erase( it );
+	}
+
+	void cPipelineCache_vulkan::save() const
+	{
+		ZoneScoped;
+
+		const std::vector< uint8_t > data = m_logical_device.getPipelineCacheData( m_cache.get() ).value;
+		if( data.empty() )
+			return;
+
+		const std::string path = filesystem::getGameDirectory() + m_path;
+		std::FILE*        file = std::fopen( path.data(), "wb" );
+		if( !file )
+		{
+			DF_LOG_WARNING( "Failed to save pipeline cache: {}", m_path );
+			return;
+		}
+
+		sHeader header = m_header;
+		header.size    = data.size();
+
+		std::fwrite( &header, sizeof( header ), 1, file );
+		std::fwrite( data.data(), 1, data.size(), file );
+		std::fclose( file );
+
+		DF_LOG_MESSAGE( "Saved pipeline cache: {}, {} bytes", m_path, data.size() );
+	}
+
+	bool cPipelineCache_vulkan::isCompatible( const sHeader& _header ) const
+	{
+		return std::memcmp( _header.magic, m_header.magic, sizeof( _header.magic ) ) == 0 && _header.version == m_header.version && _header.vendor_id == m_header.vendor_id
+		    && _header.device_id == m_header.device_id && _header.driver_version == m_header.driver_version
+		    && std::memcmp( _header.uuid, m_header.uuid, sizeof( _header.uuid ) ) == 0;
+	}
+}
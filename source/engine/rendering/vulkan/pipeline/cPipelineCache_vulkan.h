@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vulkan/vulkan.hpp>
+
+#include "engine/misc/Misc.h"
+
+namespace df::vulkan
+{
+	class cPipelineCache_vulkan
+	{
+	public:
+		DF_DISABLE_COPY_AND_MOVE( cPipelineCache_vulkan )
+
+		struct sPipeline
+		{
+			vk::UniquePipeline       pipeline;
+			vk::UniquePipelineLayout layout;
+			uint32_t                 references;
+		};
+
+		cPipelineCache_vulkan( const vk::PhysicalDevice& _physical_device, const vk::Device& _logical_device, std::string _path = "binaries/pipeline_cache.bin" );
+		~cPipelineCache_vulkan();
+
+		const sPipeline* acquire( const std::string& _key );
+		const sPipeline* insert( const std::string& _key, vk::UniquePipeline _pipeline, vk::UniquePipelineLayout _layout );
+		void             release( const std::string& _key );
+
+		void save() const;
+
+		const vk::PipelineCache& getCache() const { return m_cache.get(); }
+
+	private:
+		struct sHeader
+		{
+			char     magic[ 4 ];
+			uint32_t version;
+			uint32_t vendor_id;
+			uint32_t device_id;
+			uint32_t driver_version;
+			uint8_t  uuid[ vk::UuidSize ];
+			uint32_t padding;
+			uint64_t size;
+		};
+
+		static constexpr char     s_magic[ 4 ] = { 'D', 'F', 'P', 'C' };
+		static constexpr uint32_t s_version    = 1;
+
+		bool isCompatible( const sHeader& _header ) const;
+
+		vk::Device              m_logical_device;
+		vk::UniquePipelineCache m_cache;
+		sHeader                 m_header;
+		std::string             m_path;
+
+		// Keyed by the full create info rather than a hash of it, so a hit always has matching state.
+		std::unordered_map< std::string, sPipeline > m_pipelines;
+	};
+}
@@ -1,8 +1,10 @@
 ﻿#include "cPipeline_vulkan.h"
 
+#include <fmt/format.h>
 #include <tracy/Tracy.hpp>
 #include <vector>
 
+#include "cPipelineCache_vulkan.h"
 #include "engine/filesystem/cFileSystem.h"
 #include "engine/log/Log.h"
 #include "engine/rendering/cRenderer.h"
@@ -18,6 +20,13 @@ namespace df::vulkan
 		createGraphicsPipeline( _create_info );
 	}
 
+	cPipeline_vulkan::~cPipeline_vulkan()
+	{
+		ZoneScoped;
+
+		reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getPipelineCache()->release( m_key );
+	}
+
 	void cPipeline_vulkan::recreateGraphicsPipeline( const sPipelineCreateInfo_vulkan& _create_info )
 	{
 		ZoneScoped;
@@ -25,19 +34,65 @@ namespace df::vulkan
 		if( reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice().waitIdle() != vk::Result::eSuccess )
 			DF_LOG_ERROR( "Failed to wait for device idle" );
 
-		pipeline.reset();
-		layout.reset();
+		reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getPipelineCache()->release( m_key );
 
 		createGraphicsPipeline( _create_info );
 		DF_LOG_MESSAGE( "Recreated graphics pipeline" );
 	}
 
+	bool cPipeline_vulkan::reloadShader( const std::string& _shader_name )
+	{
+		ZoneScoped;
+
+		if( _shader_name != m_create_info.vertex_shader && _shader_name != m_create_info.fragment_shader )
+			return false;
+
+		sPipelineCreateInfo_vulkan create_info = m_create_info;
+		create_info.render_info.setColorAttachmentFormats( create_info.color_attachment_formats );
+
+		if( !create_info.setShaders( m_create_info.vertex_shader, m_create_info.fragment_shader ) )
+		{
+			DF_LOG_WARNING( "Failed to reload shader: {}, keeping pipeline: {}", _shader_name, name );
+			return false;
+		}
+
+		recreateGraphicsPipeline( create_info );
+		return true;
+	}
+
 	void cPipeline_vulkan::createGraphicsPipeline( const sPipelineCreateInfo_vulkan& _create_info )
 	{
 		ZoneScoped;
 
+		m_create_info = _create_info;
+		m_create_info.render_info.setColorAttachmentFormats( m_create_info.color_attachment_formats );
+
 		const cRenderer_vulkan* renderer       = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() );
 		const vk::Device&       logical_device = renderer->getLogicalDevice();
+		cPipelineCache_vulkan*  pipeline_cache = renderer->getPipelineCache();
+
+		m_key = m_create_info.getKey();
+		const bool valid = m_create_info.validate();
+		if( !valid )
+			DF_LOG_ERROR( "Pipeline {} doesn't match its shaders, creating it unshared", name );
+
+		if( !valid || m_create_info.vertex_code.empty() )
+		{
+			const cPipeline_vulkan* owner = this;
+			m_key.append( reinterpret_cast< const char* >( &owner ), sizeof( owner ) );
+		}
+
+		if( const cPipelineCache_vulkan::sPipeline* shared = pipeline_cache->acquire( m_key ) )
+		{
+			pipeline = shared->pipeline.get();
+			layout   = shared->layout.get();
+
+			for( const vk::PipelineShaderStageCreateInfo& shader_stage: _create_info.shader_stages )
+				logical_device.destroyShaderModule( shader_stage.module );
+
+			DF_LOG_MESSAGE( "Reused graphics pipeline: {}", name );
+			return;
+		}
 
 		const std::vector                        dynamic_states = { vk::DynamicState::eScissor, vk::DynamicState::eViewport };
 		const vk::PipelineDynamicStateCreateInfo dynamic_state_create_info( vk::PipelineDynamicStateCreateFlags(), dynamic_states );
@@ -56,7 +111,7 @@ namespace df::vulkan
 
 		const vk::PipelineLayoutCreateInfo pipeline_layout_create_info( vk::PipelineLayoutCreateFlags(), _create_info.descriptor_layouts, _create_info.push_constant_ranges );
 
-		layout = logical_device.createPipelineLayoutUnique( pipeline_layout_create_info ).value;
+		vk::UniquePipelineLayout unique_layout = logical_device.createPipelineLayoutUnique( pipeline_layout_create_info ).value;
 
 		vk::GraphicsPipelineCreateInfo create_info( vk::PipelineCreateFlags(),
 		                                            _create_info.shader_stages,
@@ -69,10 +124,14 @@ namespace df::vulkan
 		                                            &_create_info.depth_stencil,
 		                                            &color_blend_create_info,
 		                                            &dynamic_state_create_info,
-		                                            layout.get() );
+		                                            unique_layout.get() );
 		create_info.setPNext( &_create_info.render_info );
 
-		pipeline = logical_device.createGraphicsPipelineUnique( vk::PipelineCache(), create_info ).value;
+		vk::UniquePipeline unique_pipeline = logical_device.createGraphicsPipelineUnique( pipeline_cache->getCache(), create_info ).value;
+
+		const cPipelineCache_vulkan::sPipeline* created = pipeline_cache->insert( m_key, std::move( unique_pipeline ), std::move( unique_layout ) );
+		pipeline                                        = created->pipeline.get();
+		layout                                          = created->layout.get();
 
 		for( const vk::PipelineShaderStageCreateInfo& shader_stage: _create_info.shader_stages )
 			logical_device.destroyShaderModule( shader_stage.module );
@@ -13,17 +13,21 @@ namespace df::vulkan
 		DF_DISABLE_COPY_AND_MOVE( cPipeline_vulkan )
 
 		explicit cPipeline_vulkan( const sPipelineCreateInfo_vulkan& _create_info );
+		~cPipeline_vulkan();
 
 		void recreateGraphicsPipeline( const sPipelineCreateInfo_vulkan& _create_info );
+		bool reloadShader( const std::string& _shader_name );
 
-		vk::UniquePipeline       pipeline;
-		vk::UniquePipelineLayout layout;
+		vk::Pipeline       pipeline;
+		vk::PipelineLayout layout;
 
 		std::string_view getName() const { return name; }
 
 	private:
 		void createGraphicsPipeline( const sPipelineCreateInfo_vulkan& _create_info );
 
-		std::string name;
+		std::string                name;
+		sPipelineCreateInfo_vulkan m_create_info;
+		std::string                m_key;
 	};
 }
@@ -1,8 +1,13 @@
 ﻿#include "sPipelineCreateInfo_vulkan.h"
 
+#include <algorithm>
 #include <tracy/Tracy.hpp>
 #include <vulkan/vulkan.hpp>
 
+#include "engine/log/Log.h"
+#include "engine/rendering/cRenderer.h"
+#include "engine/rendering/vulkan/cRenderer_vulkan.h"
+#include "engine/rendering/vulkan/descriptor/sDescriptorLayoutBuilder_vulkan.h"
 #include "engine/rendering/vulkan/misc/Helper_vulkan.h"
 
 namespace df::vulkan
@@ -14,6 +19,80 @@ namespace df::vulkan
 		shader_stages.clear();
 		shader_stages.push_back( helper::init::pipelineShaderStageCreateInfo( vk::ShaderStageFlagBits::eVertex, _vertex ) );
 		shader_stages.push_back( helper::init::pipelineShaderStageCreateInfo( vk::ShaderStageFlagBits::eFragment, _fragment ) );
+
+		vertex_code.clear();
+		fragment_code.clear();
+		reflection = nullptr;
+	}
+
+	bool sPipelineCreateInfo_vulkan::setShaders( const std::string& _vertex, const std::string& _fragment )
+	{
+		ZoneScoped;
+
+		std::vector< uint32_t > vertex_spirv;
+		std::vector< uint32_t > fragment_spirv;
+		const vk::ShaderModule  vertex   = helper::util::createShaderModule( _vertex, &vertex_spirv );
+		const vk::ShaderModule  fragment = helper::util::createShaderModule( _fragment, &fragment_spirv );
+
+		if( !vertex || !fragment )
+		{
+			const vk::Device& logical_device = reinterpret_cast< cRenderer_vulkan* >( cRenderer::getRenderInstance() )->getLogicalDevice();
+			logical_device.destroyShaderModule( vertex );
+			logical_device.destroyShaderModule( fragment );
+			return false;
+		}
+
+		vertex_shader   = _vertex;
+		fragment_shader = _fragment;
+		setShaders( vertex, fragment );
+
+		vertex_code   = std::move( vertex_spirv );
+		fragment_code = std::move( fragment_spirv );
+		reflection    = sShaderReflection_vulkan::get( _vertex, vertex_code, _fragment, fragment_code );
+		return true;
+	}
+
+	void sPipelineCreateInfo_vulkan::setVertexInput( const uint32_t _stride, const std::vector< uint32_t >& _offsets )
+	{
+		ZoneScoped;
+
+		vertex_input_binding.clear();
+		vertex_input_attribute.clear();
+
+		if( !reflection )
+		{
+			DF_LOG_ERROR( "No shader reflection to build vertex input from: {}", name );
+			return;
+		}
+
+		if( reflection->inputs.size() != _offsets.size() )
+			DF_LOG_ERROR( "Shaders of {} take {} vertex inputs, but the vertex has {}", name, reflection->inputs.size(), _offsets.size() );
+
+		for( const sShaderReflection_vulkan::sInput& input: reflection->inputs )
+		{
+			if( input.location < _offsets.size() )
+				vertex_input_attribute.emplace_back( input.location, 0, input.format, _offsets[ input.location ] );
+		}
+
+		vertex_input_binding.emplace_back( 0, _stride, vk::VertexInputRate::eVertex );
+	}
+
+	void sPipelineCreateInfo_vulkan::setPushConstants( const uint32_t _size )
+	{
+		ZoneScoped;
+
+		push_constant_ranges.clear();
+
+		if( !reflection || !reflection->push_constant_size )
+		{
+			DF_LOG_ERROR( "Shaders of {} don't declare push constants", name );
+			return;
+		}
+
+		if( reflection->push_constant_size != _size )
+			DF_LOG_ERROR( "Push constants of {} are {} bytes in the shaders, but {} bytes on the cpu", name, reflection->push_constant_size, _size );
+
+		push_constant_ranges.emplace_back( reflection->push_constant_stages, 0, _size );
 	}
 
 	void sPipelineCreateInfo_vulkan::setInputTopology( const vk::PrimitiveTopology _topology, const bool _primitive_restart_enable )
@@ -139,4 +218,155 @@ namespace df::vulkan
 
 		render_info.setDepthAttachmentFormat( _format );
 	}
+
+	vk::UniqueDescriptorSetLayout sPipelineCreateInfo_vulkan::createDescriptorLayout( const uint32_t _set ) const
+	{
+		ZoneScoped;
+
+		if( !reflection )
+		{
+			DF_LOG_ERROR( "No shader reflection to build descriptor layout {} from: {}", _set, name );
+			return {};
+		}
+
+		sDescriptorLayoutBuilder_vulkan descriptor_layout_builder{};
+		vk::ShaderStageFlags            stages;
+
+		for( const sShaderReflection_vulkan::sBinding& binding: reflection->bindings )
+		{
+			if( binding.set != _set )
+				continue;
+
+			if( !binding.count )
+				DF_LOG_ERROR( "Set {}, binding {} of {} is a runtime array, use the renderer's bindless layout", _set, binding.binding, name );
+
+			descriptor_layout_builder.addBinding( binding.binding, binding.type );
+			descriptor_layout_builder.bindings.back().descriptorCount = binding.count;
+			stages |= binding.stages;
+		}
+
+		return descriptor_layout_builder.build( stages );
+	}
+
+	bool sPipelineCreateInfo_vulkan::validate() const
+	{
+		ZoneScoped;
+
+		if( !reflection )
+			return true;
+
+		bool           valid  = true;
+		const uint32_t stride = vertex_input_binding.empty() ? 0 : vertex_input_binding.front().stride;
+
+		for( const sShaderReflection_vulkan::sInput& input: reflection->inputs )
+		{
+			const auto it = std::ranges::find( vertex_input_attribute, input.location, &vk::VertexInputAttributeDescription::location );
+			if( it == vertex_input_attribute.end() || it->format != input.format )
+			{
+				DF_LOG_ERROR( "Vertex input at location {} doesn't match the shaders of {}", input.location, name );
+				valid = false;
+				continue;
+			}
+
+			uint32_t end = stride;
+			for( const vk::VertexInputAttributeDescription& attribute: vertex_input_attribute )
+			{
+				if( attribute.offset > it->offset )
+					end = std::min( end, attribute.offset );
+			}
+
+			if( it->offset + input.size > end )
+			{
+				DF_LOG_ERROR( "Vertex input at location {} of {} is {} bytes at offset {}, which doesn't fit in the vertex", input.location, name, input.size, it->offset );
+				valid = false;
+			}
+		}
+
+		if( descriptor_layouts.size() < reflection->getSetCount() )
+		{
+			DF_LOG_ERROR( "Shaders of {} use {} descriptor sets, but only {} layouts are set", name, reflection->getSetCount(), descriptor_layouts.size() );
+			valid = false;
+		}
+
+		for( const vk::ShaderStageFlagBits stage: { vk::ShaderStageFlagBits::eVertex, vk::ShaderStageFlagBits::eFragment } )
+		{
+			if( !( reflection->push_constant_stages & stage ) )
+				continue;
+
+			const bool covered = std::ranges::any_of( push_constant_ranges,
+			                                          [ this, stage ]( const vk::PushConstantRange& _range )
+			                                          { return ( _range.stageFlags & stage ) && _range.offset + _range.size >= reflection->push_constant_size; } );
+			if( !covered )
+			{
+				DF_LOG_ERROR( "Push constant ranges of {} don't cover the {} bytes the shaders use", name, reflection->push_constant_size );
+				valid = false;
+			}
+		}
+
+		return valid;
+	}
+
+	std::string sPipelineCreateInfo_vulkan::getKey() const
+	{
+		ZoneScoped;
+
+		std::string key;
+		const auto  add    = [ &key ]( const auto& _value ) { key.append( reinterpret_cast< const char* >( &_value ), sizeof( _value ) ); };
+		const auto  append = [ &key, &add ]( const auto& _values )
+		{
+			add( _values.size() );
+			key.append( reinterpret_cast< const char* >( _values.data() ), _values.size() * sizeof( *_values.data() ) );
+		};
+
+		append( vertex_shader );
+		append( fragment_shader );
+		append( vertex_code );
+		append( fragment_code );
+
+		add( rasterizer.depthClampEnable );
+		add( rasterizer.rasterizerDiscardEnable );
+		add( rasterizer.polygonMode );
+		add( rasterizer.cullMode );
+		add( rasterizer.frontFace );
+		add( rasterizer.depthBiasEnable );
+		add( rasterizer.depthBiasConstantFactor );
+		add( rasterizer.depthBiasClamp );
+		add( rasterizer.depthBiasSlopeFactor );
+		add( rasterizer.lineWidth );
+
+		add( render_info.viewMask );
+		add( render_info.depthAttachmentFormat );
+		add( render_info.stencilAttachmentFormat );
+		append( color_attachment_formats );
+
+		add( depth_stencil.depthTestEnable );
+		add( depth_stencil.depthWriteEnable );
+		add( depth_stencil.depthCompareOp );
+		add( depth_stencil.depthBoundsTestEnable );
+		add( depth_stencil.stencilTestEnable );
+		add( depth_stencil.front );
+		add( depth_stencil.back );
+		add( depth_stencil.minDepthBounds );
+		add( depth_stencil.maxDepthBounds );
+
+		add( multisampling.rasterizationSamples );
+		add( multisampling.sampleShadingEnable );
+		add( multisampling.minSampleShading );
+		add( multisampling.alphaToCoverageEnable );
+		add( multisampling.alphaToOneEnable );
+
+		add( input_assembly.topology );
+		add( input_assembly.primitiveRestartEnable );
+		add( color_blend_attachment );
+
+		append( push_constant_ranges );
+		append( vertex_input_binding );
+		append( vertex_input_attribute );
+
+		add( descriptor_layouts.size() );
+		for( const vk::DescriptorSetLayout& descriptor_layout: descriptor_layouts )
+			append( sDescriptorLayoutBuilder_vulkan::getKey( descriptor_layout ) );
+
+		return key;
+	}
 }
@@ -1,13 +1,20 @@
 ﻿#pragma once
 
+#include <memory>
+#include <string>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
+#include "sShaderReflection_vulkan.h"
+
 namespace df::vulkan
 {
 	struct sPipelineCreateInfo_vulkan
 	{
 		void setShaders( vk::ShaderModule _vertex, vk::ShaderModule _fragment );
+		bool setShaders( const std::string& _vertex, const std::string& _fragment );
+		void setVertexInput( uint32_t _stride, const std::vector< uint32_t >& _offsets );
+		void setPushConstants( uint32_t _size );
 		void setInputTopology( vk::PrimitiveTopology _topology, bool _primitive_restart_enable = false );
 		void setpolygonMode( vk::PolygonMode _mode, float _line_width = 1 );
 		void setCullMode( vk::CullModeFlags _cull_mode, vk::FrontFace _front_face );
@@ -24,6 +31,11 @@ namespace df::vulkan
 		void setColorFormats( const std::vector< vk::Format >& _formats );
 		void setDepthFormat( vk::Format _format );
 
+		vk::UniqueDescriptorSetLayout createDescriptorLayout( uint32_t _set ) const;
+
+		bool        validate() const;
+		std::string getKey() const;
+
 		vk::PipelineRasterizationStateCreateInfo rasterizer{};
 		vk::PipelineRenderingCreateInfo          render_info{};
 		vk::PipelineDepthStencilStateCreateInfo  depth_stencil{};
@@ -39,5 +51,13 @@ namespace df::vulkan
 		std::vector< vk::VertexInputAttributeDescription > vertex_input_attribute;
 
 		std::string name;
+		std::string vertex_shader;
+		std::string fragment_shader;
+
+		// SPIR-V of the named shaders, empty when the modules were set directly.
+		std::vector< uint32_t > vertex_code;
+		std::vector< uint32_t > fragment_code;
+
+		std::shared_ptr< const sShaderReflection_vulkan > reflection;
 	};
 }
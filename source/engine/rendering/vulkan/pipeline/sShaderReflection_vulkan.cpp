@@ -0,0 +1,482 @@
+﻿#include "sShaderReflection_vulkan.h"
+
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+#include "engine/log/Log.h"
+
+namespace df::vulkan
+{
+	std::unordered_map< std::string, std::weak_ptr< const sShaderReflection_vulkan > > sShaderReflection_vulkan::s_cache = {};
+
+	namespace
+	{
+		constexpr uint32_t s_magic = 0x07230203;
+
+		enum eOp : uint32_t
+		{
+			eOpEntryPoint       = 15,
+			eOpTypeInt          = 21,
+			eOpTypeFloat        = 22,
+			eOpTypeVector       = 23,
+			eOpTypeMatrix       = 24,
+			eOpTypeImage        = 25,
+			eOpTypeSampler      = 26,
+			eOpTypeSampledImage = 27,
+			eOpTypeArray        = 28,
+			eOpTypeRuntimeArray = 29,
+			eOpTypeStruct       = 30,
+			eOpTypePointer      = 32,
+			eOpConstant         = 43,
+			eOpVariable         = 59,
+			eOpDecorate         = 71,
+			eOpMemberDecorate   = 72,
+		};
+
+		enum eDecoration : uint32_t
+		{
+			eDecorationBufferBlock   = 3,
+			eDecorationArrayStride   = 6,
+			eDecorationMatrixStride  = 7,
+			eDecorationBuiltIn       = 11,
+			eDecorationLocation      = 30,
+			eDecorationBinding       = 33,
+			eDecorationDescriptorSet = 34,
+			eDecorationOffset        = 35,
+		};
+
+		enum eStorageClass : uint32_t
+		{
+			eStorageClassUniformConstant = 0,
+			eStorageClassInput           = 1,
+			eStorageClassUniform         = 2,
+			eStorageClassPushConstant    = 9,
+			eStorageClassStorageBuffer   = 12,
+		};
+
+		enum eDim : uint32_t
+		{
+			eDimBuffer      = 5,
+			eDimSubpassData = 6,
+		};
+
+		struct sParser
+		{
+			struct sDecorations
+			{
+				uint32_t location     = ~0u;
+				uint32_t binding      = 0;
+				uint32_t set          = 0;
+				uint32_t array_stride = 0;
+				bool     built_in     = false;
+				bool     buffer_block = false;
+			};
+
+			struct sMember
+			{
+				uint32_t offset        = 0;
+				uint32_t matrix_stride = 0;
+			};
+
+			explicit sParser( const uint32_t _bound )
+				: definitions( _bound, nullptr )
+				, decorations( _bound )
+			{}
+
+			const uint32_t* getDefinition( const uint32_t _id ) const { return _id < definitions.size() ? definitions[ _id ] : nullptr; }
+			uint32_t        getOp( const uint32_t _id ) const { return getDefinition( _id ) ? getDefinition( _id )[ 0 ] & 0xffff : 0; }
+
+			uint32_t getSize( const uint32_t _type ) const
+			{
+				const uint32_t* definition = getDefinition( _type );
+				if( !definition )
+					return 0;
+
+				switch( getOp( _type ) )
+				{
+					case eOpTypeInt:
+					case eOpTypeFloat:
+						return definition[ 2 ] / 8;
+					case eOpTypeVector:
+					case eOpTypeMatrix:
+						return definition[ 3 ] * getSize( definition[ 2 ] );
+					case eOpTypeArray:
+					{
+						const uint32_t stride = decorations[ _type ].array_stride;
+						return getConstant( definition[ 3 ] ) * ( stride ? stride : getSize( definition[ 2 ] ) );
+					}
+					case eOpTypeStruct:
+					{
+						const auto it = members.find( _type );
+						if( it == members.end() )
+							return 0;
+
+						const uint32_t member_count = ( definition[ 0 ] >> 16 ) - 2;
+						uint32_t       size         = 0;
+						for( uint32_t i = 0; i < member_count && i < it->second.size(); ++i )
+						{
+							const uint32_t  member            = definition[ 2 + i ];
+							const sMember&  member_decoration = it->second[ i ];
+							const uint32_t* member_definition = getDefinition( member );
+
+							uint32_t member_size = getSize( member );
+							if( member_decoration.matrix_stride && getOp( member ) == eOpTypeMatrix )
+								member_size = member_definition[ 3 ] * member_decoration.matrix_stride;
+
+							size = std::max( size, member_decoration.offset + member_size );
+						}
+						return size;
+					}
+					default:
+						return 0;
+				}
+			}
+
+			uint32_t getConstant( const uint32_t _id ) const
+			{
+				const uint32_t* definition = getDefinition( _id );
+				return definition && getOp( _id ) == eOpConstant ? definition[ 3 ] : 0;
+			}
+
+			vk::Format getFormat( const uint32_t _type ) const
+			{
+				const uint32_t* definition = getDefinition( _type );
+				if( !definition )
+					return vk::Format::eUndefined;
+
+				uint32_t scalar     = _type;
+				uint32_t components = 1;
+				if( getOp( _type ) == eOpTypeVector )
+				{
+					scalar     = definition[ 2 ];
+					components = definition[ 3 ];
+				}
+
+				const uint32_t* scalar_definition = getDefinition( scalar );
+				if( !scalar_definition || scalar_definition[ 2 ] != 32 || components > 4 )
+					return vk::Format::eUndefined;
+
+				static constexpr vk::Format s_float[] = { vk::Format::eR32Sfloat, vk::Format::eR32G32Sfloat, vk::Format::eR32G32B32Sfloat, vk::Format::eR32G32B32A32Sfloat };
+				static constexpr vk::Format s_int[]   = { vk::Format::eR32Sint, vk::Format::eR32G32Sint, vk::Format::eR32G32B32Sint, vk::Format::eR32G32B32A32Sint };
+				static constexpr vk::Format s_uint[]  = { vk::Format::eR32Uint, vk::Format::eR32G32Uint, vk::Format::eR32G32B32Uint, vk::Format::eR32G32B32A32Uint };
+
+				switch( getOp( scalar ) )
+				{
+					case eOpTypeFloat:
+						return s_float[ components - 1 ];
+					case eOpTypeInt:
+						return scalar_definition[ 3 ] ? s_int[ components - 1 ] : s_uint[ components - 1 ];
+					default:
+						return vk::Format::eUndefined;
+				}
+			}
+
+			bool getDescriptorType( const uint32_t _storage_class, const uint32_t _type, vk::DescriptorType& _descriptor_type ) const
+			{
+				const uint32_t* definition = getDefinition( _type );
+				if( !definition )
+					return false;
+
+				switch( _storage_class )
+				{
+					case eStorageClassUniformConstant:
+					{
+						switch( getOp( _type ) )
+						{
+							case eOpTypeSampledImage:
+								_descriptor_type = vk::DescriptorType::eCombinedImageSampler;
+								return true;
+							case eOpTypeSampler:
+								_descriptor_type = vk::DescriptorType::eSampler;
+								return true;
+							case eOpTypeImage:
+							{
+								const uint32_t dim     = definition[ 3 ];
+								const bool     storage = definition[ 7 ] == 2;
+								if( dim == eDimSubpassData )
+									_descriptor_type = vk::DescriptorType::eInputAttachment;
+								else if( dim == eDimBuffer )
+									_descriptor_type = storage ? vk::DescriptorType::eStorageTexelBuffer : vk::DescriptorType::eUniformTexelBuffer;
+								else
+									_descriptor_type = storage ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage;
+								return true;
+							}
+							default:
+								return false;
+						}
+					}
+					case eStorageClassUniform:
+						_descriptor_type = decorations[ _type ].buffer_block ? vk::DescriptorType::eStorageBuffer : vk::DescriptorType::eUniformBuffer;
+						return true;
+					case eStorageClassStorageBuffer:
+						_descriptor_type = vk::DescriptorType::eStorageBuffer;
+						return true;
+					default:
+						return false;
+				}
+			}
+
+			std::vector< const uint32_t* >                          definitions;
+			std::vector< sDecorations >                             decorations;
+			std::unordered_map< uint32_t, std::vector< sMember > > members;
+			std::vector< uint32_t >                                 variables;
+		};
+
+		vk::ShaderStageFlags getStage( const uint32_t _execution_model )
+		{
+			switch( _execution_model )
+			{
+				case 0:
+					return vk::ShaderStageFlagBits::eVertex;
+				case 1:
+					return vk::ShaderStageFlagBits::eTessellationControl;
+				case 2:
+					return vk::ShaderStageFlagBits::eTessellationEvaluation;
+				case 3:
+					return vk::ShaderStageFlagBits::eGeometry;
+				case 4:
+					return vk::ShaderStageFlagBits::eFragment;
+				case 5:
+					return vk::ShaderStageFlagBits::eCompute;
+				default:
+					return {};
+			}
+		}
+	}
+
+	bool sShaderReflection_vulkan::reflect( const std::span< const uint32_t > _code )
+	{
+		ZoneScoped;
+
+		if( _code.size() < 5 || _code[ 0 ] != s_magic )
+			return false;
+
+		sParser parser( _code[ 3 ] );
+
+		for( size_t i = 5; i < _code.size(); )
+		{
+			const uint32_t* instruction = &_code[ i ];
+			const uint32_t  word_count  = instruction[ 0 ] >> 16;
+			const uint32_t  op          = instruction[ 0 ] & 0xffff;
+
+			if( !word_count || i + word_count > _code.size() )
+				return false;
+
+			switch( op )
+			{
+				case eOpEntryPoint:
+				{
+					stages |= getStage( instruction[ 1 ] );
+				}
+				break;
+				case eOpDecorate:
+				{
+					if( instruction[ 1 ] >= parser.decorations.size() )
+						break;
+
+					sParser::sDecorations& decoration = parser.decorations[ instruction[ 1 ] ];
+					const uint32_t         value      = word_count > 3 ? instruction[ 3 ] : 0;
+					switch( instruction[ 2 ] )
+					{
+						case eDecorationLocation:
+							decoration.location = value;
+							break;
+						case eDecorationBinding:
+							decoration.binding = value;
+							break;
+						case eDecorationDescriptorSet:
+							decoration.set = value;
+							break;
+						case eDecorationArrayStride:
+							decoration.array_stride = value;
+							break;
+						case eDecorationBuiltIn:
+							decoration.built_in = true;
+							break;
+						case eDecorationBufferBlock:
+							decoration.buffer_block = true;
+							break;
+						default:
+							break;
+					}
+				}
+				break;
+				case eOpMemberDecorate:
+				{
+					if( word_count < 5 || ( instruction[ 3 ] != eDecorationOffset && instruction[ 3 ] != eDecorationMatrixStride ) )
+						break;
+
+					std::vector< sParser::sMember >& members = parser.members[ instruction[ 1 ] ];
+					if( members.size() <= instruction[ 2 ] )
+						members.resize( instruction[ 2 ] + 1 );
+
+					if( instruction[ 3 ] == eDecorationOffset )
+						members[ instruction[ 2 ] ].offset = instruction[ 4 ];
+					else
+						members[ instruction[ 2 ] ].matrix_stride = instruction[ 4 ];
+				}
+				break;
+				case eOpTypeInt:
+				case eOpTypeFloat:
+				case eOpTypeVector:
+				case eOpTypeMatrix:
+				case eOpTypeImage:
+				case eOpTypeSampler:
+				case eOpTypeSampledImage:
+				case eOpTypeArray:
+				case eOpTypeRuntimeArray:
+				case eOpTypeStruct:
+				case eOpTypePointer:
+				{
+					if( instruction[ 1 ] < parser.definitions.size() )
+						parser.definitions[ instruction[ 1 ] ] = instruction;
+				}
+				break;
+				case eOpConstant:
+				case eOpVariable:
+				{
+					if( instruction[ 2 ] >= parser.definitions.size() )
+						break;
+
+					parser.definitions[ instruction[ 2 ] ] = instruction;
+					if( op == eOpVariable )
+						parser.variables.push_back( instruction[ 2 ] );
+				}
+				break;
+				default:
+					break;
+			}
+
+			i += word_count;
+		}
+
+		for( const uint32_t variable: parser.variables )
+		{
+			const uint32_t* pointer = parser.getDefinition( parser.getDefinition( variable )[ 1 ] );
+			if( !pointer || ( pointer[ 0 ] & 0xffff ) != eOpTypePointer )
+				continue;
+
+			const sParser::sDecorations& decoration    = parser.decorations[ variable ];
+			const uint32_t               storage_class = pointer[ 2 ];
+			uint32_t                     type          = pointer[ 3 ];
+
+			if( storage_class == eStorageClassInput )
+			{
+				if( !( stages & vk::ShaderStageFlagBits::eVertex ) || decoration.built_in || decoration.location == ~0u )
+					continue;
+
+				const vk::Format format = parser.getFormat( type );
+				if( format == vk::Format::eUndefined )
+				{
+					DF_LOG_WARNING( "Unsupported vertex input type at location {}", decoration.location );
+					continue;
+				}
+
+				inputs.push_back( { decoration.location, format, parser.getSize( type ) } );
+				continue;
+			}
+
+			if( storage_class == eStorageClassPushConstant )
+			{
+				push_constant_stages |= stages;
+				push_constant_size = std::max( push_constant_size, parser.getSize( type ) );
+				continue;
+			}
+
+			uint32_t count = 1;
+			if( parser.getOp( type ) == eOpTypeArray )
+			{
+				count = parser.getConstant( parser.getDefinition( type )[ 3 ] );
+				type  = parser.getDefinition( type )[ 2 ];
+			}
+			else if( parser.getOp( type ) == eOpTypeRuntimeArray )
+			{
+				count = 0;
+				type  = parser.getDefinition( type )[ 2 ];
+			}
+
+			vk::DescriptorType descriptor_type{};
+			if( parser.getDescriptorType( storage_class, type, descriptor_type ) )
+				bindings.push_back( { decoration.set, decoration.binding, descriptor_type, count, stages } );
+		}
+
+		std::ranges::sort( inputs, []( const sInput& _a, const sInput& _b ) { return _a.location < _b.location; } );
+		std::ranges::sort( bindings, []( const sBinding& _a, const sBinding& _b ) { return _a.set != _b.set ? _a.set < _b.set : _a.binding < _b.binding; } );
+		return true;
+	}
+
+	void sShaderReflection_vulkan::merge( const sShaderReflection_vulkan& _other )
+	{
+		ZoneScoped;
+
+		stages |= _other.stages;
+		inputs.insert( inputs.end(), _other.inputs.begin(), _other.inputs.end() );
+
+		for( const sBinding& other: _other.bindings )
+		{
+			const auto it = std::ranges::find_if( bindings, [ &other ]( const sBinding& _binding ) { return _binding.set == other.set && _binding.binding == other.binding; } );
+			if( it == bindings.end() )
+			{
+				bindings.push_back( other );
+				continue;
+			}
+
+			if( it->type != other.type || it->count != other.count )
+				DF_LOG_WARNING( "Shader stages disagree on set {}, binding {}", other.set, other.binding );
+
+			it->stages |= other.stages;
+		}
+
+		if( _other.push_constant_size )
+		{
+			push_constant_stages |= _other.push_constant_stages;
+			push_constant_size = std::max( push_constant_size, _other.push_constant_size );
+		}
+
+		std::ranges::sort( inputs, []( const sInput& _a, const sInput& _b ) { return _a.location < _b.location; } );
+		std::ranges::sort( bindings, []( const sBinding& _a, const sBinding& _b ) { return _a.set != _b.set ? _a.set < _b.set : _a.binding < _b.binding; } );
+	}
+
+	uint32_t sShaderReflection_vulkan::getSetCount() const
+	{
+		return bindings.empty() ? 0 : bindings.back().set + 1;
+	}
+
+	std::shared_ptr< const sShaderReflection_vulkan > sShaderReflection_vulkan::get( const std::string&                _vertex,
+	                                                                               const std::span< const uint32_t > _vertex_code,
+	                                                                               const std::string&                _fragment,
+	                                                                               const std::span< const uint32_t > _fragment_code )
+	{
+		ZoneScoped;
+
+		std::erase_if( s_cache, []( const auto& _entry ) { return _entry.second.expired(); } );
+
+		const size_t vertex_size = _vertex_code.size_bytes();
+
+		std::string key( reinterpret_cast< const char* >( &vertex_size ), sizeof( vertex_size ) );
+		key.append( reinterpret_cast< const char* >( _vertex_code.data() ), _vertex_code.size_bytes() );
+		key.append( reinterpret_cast< const char* >( _fragment_code.data() ), _fragment_code.size_bytes() );
+
+		if( const auto it = s_cache.find( key ); it != s_cache.end() )
+			return it->second.lock();
+
+		sShaderReflection_vulkan reflection{};
+		sShaderReflection_vulkan fragment{};
+		if( !reflection.reflect( _vertex_code ) || !fragment.reflect( _fragment_code ) )
+		{
+			DF_LOG_WARNING( "Failed to reflect shaders: {}, {}", _vertex, _fragment );
+			return nullptr;
+		}
+
+		if( reflection.stages != vk::ShaderStageFlagBits::eVertex )
+			DF_LOG_ERROR( "Shader is not a vertex shader: {}", _vertex );
+		if( fragment.stages != vk::ShaderStageFlagBits::eFragment )
+			DF_LOG_ERROR( "Shader is not a fragment shader: {}", _fragment );
+
+		reflection.merge( fragment );
+
+		std::shared_ptr< const sShaderReflection_vulkan > shared = std::make_shared< const sShaderReflection_vulkan >( std::move( reflection ) );
+		s_cache.emplace( std::move( key ), shared );
+		return shared;
+	}
+}
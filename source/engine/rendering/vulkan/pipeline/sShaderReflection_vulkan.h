@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace df::vulkan
+{
+	struct sShaderReflection_vulkan
+	{
+		struct sInput
+		{
+			uint32_t   location;
+			vk::Format format;
+			uint32_t   size;
+		};
+
+		struct sBinding
+		{
+			uint32_t             set;
+			uint32_t             binding;
+			vk::DescriptorType   type;
+			uint32_t             count;
+			vk::ShaderStageFlags stages;
+		};
+
+		bool reflect( std::span< const uint32_t > _code );
+		void merge( const sShaderReflection_vulkan& _other );
+
+		uint32_t getSetCount() const;
+
+		static std::shared_ptr< const sShaderReflection_vulkan > get( const std::string&          _vertex,
+		                                                              std::span< const uint32_t > _vertex_code,
+		                                                              const std::string&          _fragment,
+		                                                              std::span< const uint32_t > _fragment_code );
+
+		vk::ShaderStageFlags    stages;
+		std::vector< sInput >   inputs;
+		std::vector< sBinding > bindings;
+		vk::ShaderStageFlags    push_constant_stages;
+		uint32_t                push_constant_size = 0;
+
+	private:
+		// Keyed by the SPIR-V itself. Entries expire with the last pipeline create info using them, so reloaded shaders don't leave stale reflections.
+		static std::unordered_map< std::string, std::weak_ptr< const sShaderReflection_vulkan > > s_cache;
+	};
+}
@@ -0,0 +1,36 @@
+#version 460 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout( location = 0 ) in vert_frag
+{
+	vec2 tex_coord_ts;
+}
+IN;
+
+layout( location = 1 ) flat in uint in_object;
+
+struct sObject
+{
+	mat4 world_matrix;
+	uint color_texture;
+	uint normal_texture;
+	uint specular_texture;
+	uint padding;
+};
+
+layout( std430, set = 2, binding = 0 ) readonly buffer sObjects
+{
+	sObject objects[];
+}
+IN_OBJECTS;
+
+layout( set = 1, binding = 0 ) uniform sampler2D in_textures[];
+
+layout( location = 0 ) out vec4 out_color;
+
+void main()
+{
+	const sObject object = IN_OBJECTS.objects[ in_object ];
+
+	out_color = texture( in_textures[ nonuniformEXT( object.color_texture ) ], IN.tex_coord_ts );
+}
\ No newline at end of file
@@ -12,11 +12,20 @@ layout( set = 0, binding = 0 ) uniform sVertexSceneUniforms
 }
 IN_SCENE;
 
-layout( push_constant ) uniform sPushConstant
+struct sObject
 {
 	mat4 world_matrix;
+	uint color_texture;
+	uint normal_texture;
+	uint specular_texture;
+	uint padding;
+};
+
+layout( std430, set = 2, binding = 0 ) readonly buffer sObjects
+{
+	sObject objects[];
 }
-PUSH_CONSTANT;
+IN_OBJECTS;
 
 layout( location = 0 ) out vert_frag
 {
@@ -26,12 +35,17 @@ layout( location = 0 ) out vert_frag
 }
 OUT;
 
+layout( location = 5 ) flat out uint out_object;
+
 void main()
 {
-	const vec3 position_ws = vec4( PUSH_CONSTANT.world_matrix * vec4( in_position, 1 ) ).xyz;
+	const mat4 world_matrix = IN_OBJECTS.objects[ gl_InstanceIndex ].world_matrix;
+
+	const vec3 position_ws = vec4( world_matrix * vec4( in_position, 1 ) ).xyz;
 
-	gl_Position      = IN_SCENE.view_projection * PUSH_CONSTANT.world_matrix * vec4( in_position, 1 );
+	gl_Position      = IN_SCENE.view_projection * world_matrix * vec4( in_position, 1 );
 	OUT.position_ws  = position_ws;
 	OUT.tex_coord_ts = in_tex_coord;
 	OUT.tbn_ws       = mat3( in_tangent, in_bitangent, in_normal );
+	out_object       = uint( gl_InstanceIndex );
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#version 460 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout( location = 0 ) in vert_frag
+{
+	vec3 position_ws;
+	vec2 tex_coord_ts;
+	mat3 tbn_ws;
+}
+IN;
+
+layout( location = 5 ) flat in uint in_object;
+
+struct sObject
+{
+	mat4 world_matrix;
+	uint color_texture;
+	uint normal_texture;
+	uint specular_texture;
+	uint padding;
+};
+
+layout( std430, set = 2, binding = 0 ) readonly buffer sObjects
+{
+	sObject objects[];
+}
+IN_OBJECTS;
+
+layout( set = 1, binding = 0 ) uniform sampler2D in_textures[];
+
+layout( location = 0 ) out vec3 out_position;
+layout( location = 1 ) out vec3 out_normal;
+layout( location = 2 ) out vec4 out_color_specular;
+
+void main()
+{
+	const sObject object = IN_OBJECTS.objects[ in_object ];
+
+	const vec3 normal_map_ts = texture( in_textures[ nonuniformEXT( object.normal_texture ) ], IN.tex_coord_ts ).xyz * 2 - 1;
+	const vec3 normal_ws     = ( normalize( IN.tbn_ws * normal_map_ts ) + 1 ) / 2;
+
+	out_position           = IN.position_ws;
+	out_normal             = normal_ws;
+	out_color_specular.rgb = texture( in_textures[ nonuniformEXT( object.color_texture ) ], IN.tex_coord_ts ).rgb;
+	out_color_specular.a   = texture( in_textures[ nonuniformEXT( object.specular_texture ) ], IN.tex_coord_ts ).r;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 460 core
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout( set = 0, binding = 0 ) uniform sampler2D in_textures[];
+
+layout( push_constant ) uniform sPushConstant
+{
+	uvec4 textures;
+}
+PUSH_CONSTANT;
+
+layout( location = 0 ) out vec4 out_color;
+
+void main()
+{
+	const uint texture_index = PUSH_CONSTANT.textures[ uint( gl_FragCoord.x ) ];
+
+	out_color = texture( in_textures[ nonuniformEXT( texture_index ) ], vec2( .5 ) );
+}
\ No newline at end of file
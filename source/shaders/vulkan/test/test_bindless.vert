@@ -0,0 +1,7 @@
+#version 460 core
+
+void main()
+{
+	const vec2 position = vec2( ( gl_VertexIndex << 1 ) & 2, gl_VertexIndex & 2 );
+	gl_Position         = vec4( position * 2 - 1, 0, 1 );
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+﻿#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <array>
+#include <filesystem>
+#include <fmt/format.h>
+#include <GLFW/glfw3.h>
+#include <string>
+#include <string_view>
+
+#include "engine/filesystem/cFileSystem.h"
+#include "engine/log/Log.h"
+#include "engine/managers/assets/cModelManager.h"
+#include "engine/managers/cEventManager.h"
+#include "engine/managers/cJobManager.h"
+#include "engine/managers/cRenderCallbackManager.h"
+#include "engine/misc/cTransformSystem.h"
+#include "engine/rendering/assets/cameras/cCamera.h"
+#include "engine/rendering/cRenderer.h"
+#include "engine/rendering/vulkan/cBindlessTextures_vulkan.h"
+#include "engine/rendering/vulkan/cGpuCulling_vulkan.h"
+#include "engine/rendering/vulkan/cRenderer_vulkan.h"
+#include "engine/rendering/vulkan/cUploadManager_vulkan.h"
+#include "engine/rendering/vulkan/misc/Helper_vulkan.h"
+#include "engine/rendering/vulkan/pipeline/cPipeline_vulkan.h"
+
+namespace
+{
+	// Matches SKIP_RETURN_CODE of the tests.
+	constexpr int s_skipped = 77;
+
+	bool initialize( const char* _executable )
+	{
+		// The null platform needs no display and gives Vulkan a headless surface, so the renderer runs on lavapipe in CI.
+		glfwInitHint( GLFW_PLATFORM, GLFW_PLATFORM_NULL );
+		if( !glfwInit() || !glfwVulkanSupported() )
+		{
+			fmt::print( stderr, "Vulkan isn't available\n" );
+			return false;
+		}
+
+		df::filesystem::setGameDirectory( std::filesystem::absolute( _executable ).parent_path().parent_path().generic_string() + "/" );
+		df::log::initialize();
+
+		df::cJobManager::initialize();
+		df::cEventManager::initialize();
+		df::cTransformSystem::initialize();
+		df::cRenderer::initialize( df::cRenderer::eInstanceType::eVulkan, std::string( "gpu_test" ) );
+		df::cRenderCallbackManager::initialize();
+		df::cModelManager::initialize();
+		return true;
+	}
+
+	void deinitialize()
+	{
+		df::cModelManager::deinitialize();
+		df::cRenderCallbackManager::deinitialize();
+		df::cRenderer::deinitialize();
+		df::cTransformSystem::deinitialize();
+		df::cEventManager::deinitialize();
+		df::cJobManager::deinitialize();
+
+		df::log::deinitialize();
+		glfwTerminate();
+	}
+
+	int bindlessTest()
+	{
+		using namespace df::vulkan;
+
+		cRenderer_vulkan*         renderer          = reinterpret_cast< cRenderer_vulkan* >( df::cRenderer::getRenderInstance() );
+		cBindlessTextures_vulkan* bindless_textures = renderer->getBindlessTextures();
+		if( !bindless_textures )
+		{
+			fmt::print( stderr, "Bindless textures are disabled or unsupported\n" );
+			return s_skipped;
+		}
+
+		constexpr vk::Format                format = vk::Format::eR8G8B8A8Unorm;
+		constexpr std::array< uint32_t, 4 > colors = { 0xff0000ff, 0xff00ff00, 0xffff0000, 0xffffffff };
+
+		std::array< sAllocatedImage_vulkan, colors.size() > textures;
+		std::array< uint32_t, colors.size() >               indices{};
+
+		for( size_t i = 0; i < colors.size(); ++i )
+		{
+			textures[ i ] = helper::util::createImage( &colors[ i ], vk::Extent3D( 1, 1, 1 ), format, vk::ImageUsageFlagBits::eSampled );
+			indices[ i ]  = bindless_textures->add( textures[ i ].image_view.get() );
+		}
+
+		// Pixels sample the textures in reverse order, so a shader that ignores the index can't pass.
+		std::array< uint32_t, colors.size() > pixel_indices{};
+		for( size_t i = 0; i < colors.size(); ++i )
+			pixel_indices[ i ] = indices[ colors.size() - 1 - i ];
+
+		const vk::Extent3D      extent( static_cast< uint32_t >( colors.size() ), 1, 1 );
+		sAllocatedImage_vulkan  target   = helper::util::createImage( extent, format, vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc );
+		sAllocatedBuffer_vulkan readback = helper::util::createBuffer( sizeof( colors ), vk::BufferUsageFlagBits::eTransferDst, vma::MemoryUsage::eGpuToCpu );
+
+		sPipelineCreateInfo_vulkan pipeline_create_info{ .name = "test_bindless" };
+		if( !pipeline_create_info.setShaders( "test_bindless.vert", "test_bindless.frag" ) )
+			return 1;
+
+		pipeline_create_info.descriptor_layouts.push_back( bindless_textures->getLayout() );
+		pipeline_create_info.setPushConstants( static_cast< uint32_t >( sizeof( pixel_indices ) ) );
+		pipeline_create_info.setInputTopology( vk::PrimitiveTopology::eTriangleList );
+		pipeline_create_info.setpolygonMode( vk::PolygonMode::eFill );
+		pipeline_create_info.setCullMode( vk::CullModeFlagBits::eNone, vk::FrontFace::eClockwise );
+		pipeline_create_info.setColorFormat( format );
+		pipeline_create_info.setMultisamplingNone();
+		pipeline_create_info.disableDepthtest();
+		pipeline_create_info.disableBlending();
+
+		const cPipeline_vulkan pipeline( pipeline_create_info );
+
+		cUploadManager_vulkan* upload_manager = renderer->getUploadManager();
+		upload_manager->flush();
+		upload_manager->wait( upload_manager->getSubmittedValue() );
+
+		renderer->immediateSubmit(
+			[ & ]( const vk::CommandBuffer _command_buffer )
+			{
+				upload_manager->acquire( _command_buffer );
+
+				helper::util::transitionImage( _command_buffer, target.image.get(), vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal );
+
+				const vk::RenderingAttachmentInfo color_attachment = helper::init::attachmentInfo( target.image_view.get(), nullptr );
+				const vk::RenderingInfo           render_info      = helper::init::renderingInfo( vk::Extent2D( extent.width, extent.height ), &color_attachment );
+				const vk::Viewport                viewport( 0, 0, static_cast< float >( extent.width ), static_cast< float >( extent.height ), 0, 1 );
+				const vk::Rect2D                  scissor( vk::Offset2D(), vk::Extent2D( extent.width, extent.height ) );
+
+				_command_buffer.beginRendering( &render_info );
+				_command_buffer.bindPipeline( vk::PipelineBindPoint::eGraphics, pipeline.pipeline );
+				_command_buffer.setViewport( 0, 1, &viewport );
+				_command_buffer.setScissor( 0, 1, &scissor );
+				_command_buffer.bindDescriptorSets( vk::PipelineBindPoint::eGraphics, pipeline.layout, 0, 1, &bindless_textures->getSet(), 0, nullptr );
+				_command_buffer.pushConstants( pipeline.layout, vk::ShaderStageFlagBits::eFragment, 0, sizeof( pixel_indices ), pixel_indices.data() );
+				_command_buffer.draw( 3, 1, 0, 0 );
+				_command_buffer.endRendering();
+
+				helper::util::transitionImage( _command_buffer, target.image.get(), vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::eTransferSrcOptimal );
+
+				const vk::BufferImageCopy copy( 0, 0, 0, vk::ImageSubresourceLayers( vk::ImageAspectFlagBits::eColor, 0, 0, 1 ), vk::Offset3D(), extent );
+				_command_buffer.copyImageToBuffer( target.image.get(), vk::ImageLayout::eTransferSrcOptimal, readback.buffer.get(), 1, &copy );
+			} );
+
+		const vma::Allocator& memory_allocator = renderer->getMemoryAllocator();
+		if( memory_allocator.invalidateAllocation( readback.allocation.get(), 0, vk::WholeSize ) != vk::Result::eSuccess )
+			fmt::print( stderr, "Failed to invalidate readback\n" );
+
+		const uint32_t* pixels = static_cast< const uint32_t* >( memory_allocator.getAllocationInfo( readback.allocation.get() ).pMappedData );
+
+		bool success = true;
+		for( size_t i = 0; i < colors.size(); ++i )
+		{
+			const uint32_t expected = colors[ colors.size() - 1 - i ];
+			if( pixels[ i ] == expected )
+				continue;
+
+			fmt::print( stderr, "Pixel {} sampled bindless index {} as {:08x}, expected {:08x}\n", i, pixel_indices[ i ], pixels[ i ], expected );
+			success = false;
+		}
+
+		for( size_t i = 0; i < colors.size(); ++i )
+		{
+			bindless_textures->remove( indices[ i ] );
+			helper::util::destroyImage( textures[ i ] );
+		}
+
+		helper::util::destroyImage( target );
+		helper::util::destroyBuffer( readback );
+
+		fmt::print( "Bindless sampling {}\n", success ? "passed" : "failed" );
+		return success ? 0 : 1;
+	}
+
+	int cullingTest()
+	{
+		using namespace df::vulkan;
+
+		cRenderer_vulkan*   renderer    = reinterpret_cast< cRenderer_vulkan* >( df::cRenderer::getRenderInstance() );
+		cGpuCulling_vulkan* gpu_culling = renderer->getGpuCulling();
+		if( !gpu_culling )
+		{
+			fmt::print( stderr, "GPU culling is unsupported\n" );
+			return s_skipped;
+		}
+
+		// An identity view projection keeps everything inside the [-1, 1] cube.
+		df::cCamera camera( "gpu_test", df::cCamera::ePerspective, df::color::black, 90 );
+		camera.view_projection = glm::mat4( 1 );
+
+		// The first three are inside or straddle the cube, the rest are outside of it.
+		const std::array spheres = {
+			glm::vec4( 0, 0, 0, .5f ), glm::vec4( 1.4f, 0, 0, .5f ), glm::vec4( 0, -.9f, .9f, .2f ),
+			glm::vec4( 3, 0, 0, .5f ), glm::vec4( 0, -2, 0, .5f ),   glm::vec4( 0, 0, 5, 1 ),
+		};
+		constexpr uint32_t expected = 3;
+
+		for( uint32_t i = 0; i < spheres.size(); ++i )
+		{
+			const cGpuCulling_vulkan::sDraw draw{
+				.sphere        = spheres[ i ],
+				.index_count   = 3,
+				.first_index   = 0,
+				.vertex_offset = 0,
+				.padding       = 0,
+			};
+			gpu_culling->set( i, draw, {} );
+		}
+
+		gpu_culling->update( 0 );
+		renderer->immediateSubmit( [ & ]( const vk::CommandBuffer _command_buffer ) { gpu_culling->cull( _command_buffer, &camera ); } );
+		gpu_culling->readVisibility();
+
+		const uint32_t visible = gpu_culling->getStats().delayed_visible;
+
+		for( uint32_t i = 0; i < spheres.size(); ++i )
+			gpu_culling->remove( i );
+
+		if( visible != expected )
+			fmt::print( stderr, "Culled {} spheres down to {}, expected {}\n", spheres.size(), visible, expected );
+
+		fmt::print( "GPU culling {}\n", visible == expected ? "passed" : "failed" );
+		return visible == expected ? 0 : 1;
+	}
+}
+
+int main( const int _argc, char** _argv )
+{
+	if( _argc < 2 )
+	{
+		fmt::print( stderr, "Usage: gpu_test --bindless|--culling\n" );
+		return 1;
+	}
+
+	if( !initialize( _argv[ 0 ] ) )
+		return s_skipped;
+
+	const std::string_view test   = _argv[ 1 ];
+	int                    result = 1;
+
+	if( test == "--bindless" )
+		result = bindlessTest();
+	else if( test == "--culling" )
+		result = cullingTest();
+	else
+		fmt::print( stderr, "Unknown test: {}\n", test );
+
+	deinitialize();
+	return result;
+}
@@ -0,0 +1,232 @@
+﻿#include <cstdio>
+#include <fmt/args.h>
+#include <fmt/format.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "engine/log/BinaryLog.h"
+#include "engine/log/Log.h"
+
+namespace
+{
+	struct sFormat
+	{
+		uint8_t          type;
+		uint8_t          category;
+		uint32_t         line;
+		std::string_view function;
+		std::string_view format;
+	};
+
+	constexpr std::string_view s_types[]      = { "  RAW  ", "MESSAGE", "WARNING", " ERROR " };
+	constexpr std::string_view s_categories[] = { "General", "Assets", "Rendering", "Filesystem" };
+
+	std::string_view getName( const std::string_view* _names, const size_t _count, const uint8_t _index )
+	{
+		return _index < _count ? _names[ _index ] : "Unknown";
+	}
+
+	bool readArguments( std::string_view& _buffer, df::log::tArguments& _arguments )
+	{
+		using namespace df::log;
+
+		uint8_t count = 0;
+		if( !binary::read( _buffer, count ) )
+			return false;
+
+		for( uint8_t i = 0; i < count; ++i )
+		{
+			binary::eArgument tag;
+			if( !binary::read( _buffer, tag ) )
+				return false;
+
+			bool success = false;
+			switch( tag )
+			{
+				case binary::eSigned:
+				{
+					int64_t value = 0;
+					success       = binary::read( _buffer, value );
+					_arguments.push_back( value );
+				}
+				break;
+				case binary::eUnsigned:
+				case binary::ePointer:
+				{
+					uint64_t value = 0;
+					success        = binary::read( _buffer, value );
+
+					if( tag == binary::ePointer )
+						_arguments.push_back( fmt::format( "0x{:x}", value ) );
+					else
+						_arguments.push_back( value );
+				}
+				break;
+				case binary::eFloat:
+				{
+					double value = 0;
+					success      = binary::read( _buffer, value );
+					_arguments.push_back( value );
+				}
+				break;
+				case binary::eBool:
+				{
+					uint8_t value = 0;
+					success       = binary::read( _buffer, value );
+					_arguments.push_back( value != 0 );
+				}
+				break;
+				case binary::eChar:
+				{
+					char value = 0;
+					success    = binary::read( _buffer, value );
+					_arguments.push_back( value );
+				}
+				break;
+				case binary::eString:
+				{
+					std::string_view value;
+					success = binary::readString( _buffer, value );
+					_arguments.push_back( std::string( value ) );
+				}
+				break;
+			}
+
+			if( !success )
+				return false;
+		}
+
+		return true;
+	}
+
+	std::string formatMessage( const sFormat& _format, const df::log::tArguments& _arguments )
+	{
+		const fmt::string_view format( _format.format.data(), _format.format.size() );
+
+		try
+		{
+			return fmt::vformat( format, _arguments );
+		}
+		catch( const fmt::format_error& _error )
+		{
+			std::string            message   = fmt::format( "<{}> {}", _error.what(), _format.format );
+			const fmt::format_args arguments = _arguments;
+
+			for( int i = 0; const fmt::basic_format_arg< fmt::format_context > argument = arguments.get( i ); ++i )
+				message += fmt::format( " | {}", fmt::vformat( "{}", fmt::format_args( &argument, 1 ) ) );
+
+			return message;
+		}
+	}
+}
+
+int main( const int _argc, char** _argv )
+{
+	using namespace df::log;
+
+	std::string input_path;
+	std::string output_path;
+	bool        csv = false;
+
+	for( int i = 1; i < _argc; ++i )
+	{
+		const std::string_view argument = _argv[ i ];
+
+		if( argument == "--csv" )
+			csv = true;
+		else if( input_path.empty() )
+			input_path = argument;
+		else
+			output_path = argument;
+	}
+
+	if( input_path.empty() )
+	{
+		fmt::print( stderr, "Usage: log_decoder <log.bin> [output] [--csv]\n" );
+		return 1;
+	}
+
+	std::ifstream file( input_path, std::ios::binary );
+	if( !file.is_open() )
+	{
+		fmt::print( stderr, "Failed to open: {}\n", input_path );
+		return 1;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+
+	const std::string data   = stream.str();
+	std::string_view  buffer = data;
+
+	binary::sHeader header{};
+	if( !binary::read( buffer, header ) || std::string_view( header.magic, 4 ) != std::string_view( binary::s_magic, 4 ) || header.version != binary::s_version )
+	{
+		fmt::print( stderr, "Invalid log header: {}\n", input_path );
+		return 1;
+	}
+
+	std::FILE* output = output_path.empty() ? stdout : std::fopen( output_path.data(), "wb" );
+	if( !output )
+	{
+		fmt::print( stderr, "Failed to open: {}\n", output_path );
+		return 1;
+	}
+
+	if( csv )
+		fmt::print( output, "Type;;Time;;Thread;;Category;;Function;;Line;;Message\n" );
+
+	std::unordered_map< uint32_t, sFormat > formats;
+	size_t                                  entries = 0;
+
+	while( !buffer.empty() )
+	{
+		binary::eRecord record;
+		uint32_t        id = 0;
+		if( !binary::read( buffer, record ) || !binary::read( buffer, id ) )
+			break;
+
+		if( record == binary::eFormat )
+		{
+			sFormat format{};
+			if( !binary::read( buffer, format.type ) || !binary::read( buffer, format.category ) || !binary::read( buffer, format.line )
+			    || !binary::readString( buffer, format.function ) || !binary::readString( buffer, format.format ) )
+				break;
+
+			formats[ id ] = format;
+			continue;
+		}
+
+		uint64_t   timestamp = 0;
+		uint32_t   thread    = 0;
+		tArguments arguments;
+		const auto it = formats.find( id );
+		if( !binary::read( buffer, timestamp ) || !binary::read( buffer, thread ) || !readArguments( buffer, arguments ) || it == formats.end() )
+			break;
+
+		const sFormat&    format  = it->second;
+		const double      time    = static_cast< double >( timestamp - header.start_time ) / 1'000'000'000.0;
+		const std::string message = formatMessage( format, arguments );
+
+		const std::string_view type     = getName( s_types, std::size( s_types ), format.type );
+		const std::string_view category = getName( s_categories, std::size( s_categories ), format.category );
+
+		if( csv )
+			fmt::print( output, "[{}];;{:.6f};;{};;{};;{};;{};;{}\n", type, time, thread, category, format.function, format.line, message );
+		else
+			fmt::print( output, "[{}] {:12.6f} T{:<3} {} Line {} - {}\n", type, time, thread, format.function, format.line, message );
+
+		++entries;
+	}
+
+	if( !buffer.empty() )
+		fmt::print( stderr, "Log is truncated or corrupt after {} entries\n", entries );
+
+	if( output != stdout )
+		std::fclose( output );
+
+	return 0;
+}
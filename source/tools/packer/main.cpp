@@ -0,0 +1,173 @@
+﻿#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "engine/filesystem/cMappedFile.h"
+#include "engine/filesystem/cPackFile.h"
+
+namespace
+{
+	bool verify( const std::string& _pack_path, const std::string& _directory )
+	{
+		df::cPackFile pack( _pack_path );
+		if( !pack.load() )
+		{
+			fmt::print( stderr, "Failed to load pack: {}\n", _pack_path );
+			return false;
+		}
+
+		std::unordered_map< std::string, const df::cPackFile::sEntry* > entries;
+		for( const df::cPackFile::sEntry& entry: pack.getEntries() )
+			entries.emplace( entry.path, &entry );
+
+		std::error_code error;
+		size_t          files = 0;
+		bool            valid = true;
+		for( const std::filesystem::directory_entry& file: std::filesystem::recursive_directory_iterator( _directory, error ) )
+		{
+			if( !file.is_regular_file() )
+				continue;
+
+			const std::string path = file.path().lexically_relative( _directory ).generic_string();
+			const auto        it   = entries.find( path );
+			if( it == entries.end() )
+			{
+				fmt::print( stderr, "Missing from pack: {}\n", path );
+				valid = false;
+				continue;
+			}
+
+			const df::cMappedFile original = df::cMappedFile::map( file.path().string() );
+			const df::cMappedFile packed   = pack.read( *it->second );
+			if( !original.isValid() || !packed.isValid() || !std::ranges::equal( original.getData(), packed.getData() ) )
+			{
+				fmt::print( stderr, "Content mismatch: {}\n", path );
+				valid = false;
+			}
+
+			++files;
+		}
+
+		if( error )
+		{
+			fmt::print( stderr, "Failed to iterate directory: {}\n", _directory );
+			return false;
+		}
+
+		if( files != entries.size() )
+		{
+			fmt::print( stderr, "Pack has {} entries, directory has {} files\n", entries.size(), files );
+			valid = false;
+		}
+
+		return valid;
+	}
+
+	void writeFile( const std::filesystem::path& _path, const std::string& _data )
+	{
+		std::filesystem::create_directories( _path.parent_path() );
+
+		std::ofstream stream( _path, std::ios::out | std::ios::binary | std::ios::trunc );
+		stream.write( _data.data(), static_cast< std::streamsize >( _data.size() ) );
+	}
+
+	bool selfTest()
+	{
+		const std::filesystem::path root      = std::filesystem::temp_directory_path() / "df_packer_test";
+		const std::filesystem::path directory = root / "data";
+
+		std::error_code error;
+		std::filesystem::remove_all( root, error );
+
+		std::string text;
+		for( int i = 0; i < 2000; ++i )
+			text += fmt::format( "v {} {} {}\n", i % 7, i % 13, i % 5 );
+
+		std::string noise( 100000, '\0' );
+		uint32_t    state = 0x9e3779b9;
+		for( char& byte: noise )
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			byte   = static_cast< char >( state );
+		}
+
+		writeFile( directory / "models/cube.obj", text );
+		writeFile( directory / "textures/noise.bin", noise );
+		writeFile( directory / "textures/nested/small.txt", "abc" );
+		writeFile( directory / "empty.txt", "" );
+
+		bool success = true;
+		for( const bool compress: { true, false } )
+		{
+			const std::string pack_path = ( root / ( compress ? "compressed.pack" : "stored.pack" ) ).string();
+			if( !df::cPackFile::create( pack_path, directory.string(), compress ) || !verify( pack_path, directory.string() ) )
+			{
+				fmt::print( stderr, "Round trip failed: {}\n", pack_path );
+				success = false;
+			}
+		}
+
+		std::filesystem::remove_all( root, error );
+
+		fmt::print( "Round trip {}\n", success ? "passed" : "failed" );
+		return success;
+	}
+}
+
+int main( const int _argc, char** _argv )
+{
+	std::string directory;
+	std::string pack_path;
+	bool        compress    = true;
+	bool        verify_only = false;
+	uint32_t    alignment   = 4096;
+
+	for( int i = 1; i < _argc; ++i )
+	{
+		const std::string_view argument = _argv[ i ];
+
+		if( argument == "--self-test" )
+			return selfTest() ? 0 : 1;
+
+		if( argument == "--no-compress" )
+			compress = false;
+		else if( argument == "--verify" )
+			verify_only = true;
+		else if( argument == "--alignment" && i + 1 < _argc )
+		{
+			const std::string_view value = _argv[ ++i ];
+			std::from_chars( value.data(), value.data() + value.size(), alignment );
+		}
+		else if( directory.empty() )
+			directory = argument;
+		else
+			pack_path = argument;
+	}
+
+	if( directory.empty() || pack_path.empty() )
+	{
+		fmt::print( stderr, "Usage: packer <directory> <output.pack> [--no-compress] [--alignment <bytes>] [--verify]\n" );
+		fmt::print( stderr, "       packer --self-test\n" );
+		return 1;
+	}
+
+	if( !verify_only && !df::cPackFile::create( pack_path, directory, compress, alignment ) )
+	{
+		fmt::print( stderr, "Failed to create pack: {}\n", pack_path );
+		return 1;
+	}
+
+	if( !verify( pack_path, directory ) )
+		return 1;
+
+	fmt::print( "{} {}\n", verify_only ? "Verified" : "Packed", pack_path );
+	return 0;
+}